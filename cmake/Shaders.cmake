@@ -1,3 +1,6 @@
+# Compiles GLSL shaders to SPIR-V at build time: <binary dir>/shaders/<name>.spv for every source.
+# Each shader is its own build step, so editing one recompiles only that one. The engine prefers
+# these over its runtime compiler (see src/renderer/ShaderCache.h).
 function(add_shaders TARGET_NAME)
     set(SHADER_SOURCE_FILES ${ARGN})
     list(LENGTH SHADER_SOURCE_FILES FILE_COUNT)
@@ -7,27 +10,26 @@ function(add_shaders TARGET_NAME)
 
     file(MAKE_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}/shaders")
 
-    set(SHADER_COMMANDS)
     set(SHADER_PRODUCTS)
 
     foreach (SHADER_SOURCE IN LISTS SHADER_SOURCE_FILES)
         cmake_path(ABSOLUTE_PATH SHADER_SOURCE NORMALIZE)
         cmake_path(GET SHADER_SOURCE FILENAME SHADER_NAME)
+        set(SHADER_PRODUCT "${CMAKE_CURRENT_BINARY_DIR}/shaders/${SHADER_NAME}.spv")
 
-        # COMMANDS
-        list(APPEND SHADER_COMMANDS COMMAND)
-        list(APPEND SHADER_COMMANDS Vulkan::glslc)
-        list(APPEND SHADER_COMMANDS "${SHADER_SOURCE}")
-        list(APPEND SHADER_COMMANDS "-o")
-        list(APPEND SHADER_COMMANDS "${CMAKE_CURRENT_BINARY_DIR}/shaders/${SHADER_NAME}.spv")
-        # PRODUCTS
-        list(APPEND SHADER_PRODUCTS "${CMAKE_CURRENT_BINARY_DIR}/shaders/${SHADER_NAME}.spv")
+        # Same target environment lvk compiles runtime GLSL for
+        add_custom_command(
+                OUTPUT "${SHADER_PRODUCT}"
+                COMMAND Vulkan::glslc --target-env=vulkan1.3 "${SHADER_SOURCE}" -o "${SHADER_PRODUCT}"
+                DEPENDS "${SHADER_SOURCE}"
+                COMMENT "Compiling shader ${SHADER_NAME}"
+                VERBATIM
+        )
+        list(APPEND SHADER_PRODUCTS "${SHADER_PRODUCT}")
     endforeach ()
 
     add_custom_target(${TARGET_NAME} ALL
-            ${SHADER_COMMANDS}
-            COMMENT "Compiling Shaders..."
+            DEPENDS ${SHADER_PRODUCTS}
             SOURCES ${SHADER_SOURCE_FILES}
-            BYPRODUCTS ${SHADER_PRODUCTS}
     )
 endfunction()
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Vulkan Engine 1.3 Benchmark Script
+# Usage: ./scripts/bench.sh [engine options], e.g. --instances 5000 --frames 1200 --output bench.json
+
+echo "📊 Running Vulkan Engine 1.3 benchmark..."
+
+# Check if executable exists
+if [ ! -f "build/bin/VulkanEngine" ]; then
+    echo "❌ Executable not found. Please build the project first."
+    echo "Run: ./scripts/build.sh"
+    exit 1
+fi
+
+# Run headless; set VK_ICD_FILENAMES to a lavapipe ICD to benchmark on the CPU, e.g.
+# VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json ./scripts/bench.sh
+cd build
+./bin/VulkanEngine --bench "$@"
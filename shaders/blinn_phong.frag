@@ -5,16 +5,11 @@
 layout (location=0) in vec3 fragPos;
 layout (location=1) in vec3 fragNormal;
 layout (location=2) in vec2 fragTexCoord;
+// Texture index, sampler index, texture flags; from push constants or the instance buffer
+layout (location=3) flat in uvec3 fragMaterial;
 
 layout (location=0) out vec4 out_FragColor;
 
-layout(push_constant) uniform PushConstants {
-	mat4 mvp;
-	mat4 model;
-	uint textureIndex;
-	float _padding[3];
-} pc;
-
 // Manually define the bindless texture arrays
 layout (set = 0, binding = 0) uniform texture2D kTextures2D[];
 layout (set = 0, binding = 1) uniform sampler kSamplers[];
@@ -24,9 +19,19 @@ vec4 textureBindless2D(uint textureid, uint samplerid, vec2 uv) {
 	return texture(nonuniformEXT(sampler2D(kTextures2D[textureid], kSamplers[samplerid])), uv);
 }
 
+// Block-compressed color textures are uploaded as UNORM and decoded here
+const uint kTextureFlag_DecodeSrgb = 1u;
+
+vec3 srgbToLinear(vec3 c) {
+	return mix(c / 12.92, pow((c + 0.055) / 1.055, vec3(2.4)), greaterThan(c, vec3(0.04045)));
+}
+
 void main() {
 	// Sample the texture
-	vec4 texColor = textureBindless2D(pc.textureIndex, 0, fragTexCoord);
+	vec4 texColor = textureBindless2D(fragMaterial.x, fragMaterial.y, fragTexCoord);
+	if ((fragMaterial.z & kTextureFlag_DecodeSrgb) != 0u) {
+		texColor.rgb = srgbToLinear(texColor.rgb);
+	}
 	
 	// Lighting setup - these are in world space
 	vec3 lightPos = vec3(2.0, 2.0, 2.0);  // Fixed light position in world space
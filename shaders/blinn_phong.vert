@@ -3,10 +3,18 @@
 layout(push_constant) uniform PushConstants {
 	mat4 mvp;
 	mat4 model;
+	vec4 positionScale;
+	vec4 positionOffset;
 	uint textureIndex;
-	float _padding[3];
+	uint samplerIndex;
+	uint textureFlags;
+	float _padding[1];
 } pc;
 
+// Set by the pipeline to match the registry's VertexLayout (see assets/Vertex.h).
+// Packed: position is unorm16 within the submesh bounds, normal is octahedral snorm16 (z reads as 0).
+layout (constant_id = 0) const bool kPackedVertices = false;
+
 layout (location=0) in vec3 position;
 layout (location=1) in vec3 normal;
 layout (location=2) in vec2 texCoord;
@@ -14,19 +22,32 @@ layout (location=2) in vec2 texCoord;
 layout (location=0) out vec3 fragPos;
 layout (location=1) out vec3 fragNormal;
 layout (location=2) out vec2 fragTexCoord;
+layout (location=3) flat out uvec3 fragMaterial; // texture index, sampler index, texture flags
+
+vec3 decodeOctahedral(vec2 e) {
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+	return normalize(n);
+}
 
 void main() {
+	// Dequantize (identity scale/offset for full-precision vertices)
+	vec3 localPos = position * pc.positionScale.xyz + pc.positionOffset.xyz;
+	vec3 localNormal = kPackedVertices ? decodeOctahedral(normal.xy) : normal;
+
 	// Transform to world space for proper lighting calculations
-	vec4 worldPos = pc.model * vec4(position, 1.0);
+	vec4 worldPos = pc.model * vec4(localPos, 1.0);
 	fragPos = worldPos.xyz;
 	
 	// Transform normal to world space (inverse transpose of model matrix)
 	mat3 normalMatrix = mat3(transpose(inverse(mat3(pc.model))));
-	fragNormal = normalize(normalMatrix * normal);
+	fragNormal = normalize(normalMatrix * localNormal);
 	
 	fragTexCoord = texCoord;
+	fragMaterial = uvec3(pc.textureIndex, pc.samplerIndex, pc.textureFlags);
 	
 	// Final position for rasterization
-	gl_Position = pc.mvp * vec4(position, 1.0);
+	gl_Position = pc.mvp * vec4(localPos, 1.0);
 }
 
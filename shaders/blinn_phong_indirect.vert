@@ -0,0 +1,67 @@
+#version 460
+#extension GL_EXT_buffer_reference : require
+
+// Must match InstanceData and GpuTransform in renderer/IndirectRenderer.h
+struct InstanceData {
+	uint transformIndex;
+	uint textureIndex;
+	uint samplerIndex;
+	uint textureFlags;
+	vec4 positionScale;
+	vec4 positionOffset;
+};
+
+struct Transform {
+	mat4 model;
+	mat3 normalMatrix;
+};
+
+layout(std430, buffer_reference) readonly buffer Instances {
+	InstanceData instances[];
+};
+
+layout(std430, buffer_reference) readonly buffer Transforms {
+	Transform transforms[];
+};
+
+layout(push_constant) uniform PushConstants {
+	mat4 viewProj;
+	Instances instances;
+	Transforms transforms;
+} pc;
+
+// Set by the pipeline to match the registry's VertexLayout (see assets/Vertex.h)
+layout (constant_id = 0) const bool kPackedVertices = false;
+
+layout (location=0) in vec3 position;
+layout (location=1) in vec3 normal;
+layout (location=2) in vec2 texCoord;
+
+layout (location=0) out vec3 fragPos;
+layout (location=1) out vec3 fragNormal;
+layout (location=2) out vec2 fragTexCoord;
+layout (location=3) flat out uvec3 fragMaterial; // texture index, sampler index, texture flags
+
+vec3 decodeOctahedral(vec2 e) {
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+	return normalize(n);
+}
+
+void main() {
+	// firstInstance of each indirect command selects its instance
+	InstanceData instance = pc.instances.instances[gl_InstanceIndex];
+	Transform transform = pc.transforms.transforms[instance.transformIndex];
+
+	vec3 localPos = position * instance.positionScale.xyz + instance.positionOffset.xyz;
+	vec3 localNormal = kPackedVertices ? decodeOctahedral(normal.xy) : normal;
+
+	vec4 worldPos = transform.model * vec4(localPos, 1.0);
+	fragPos = worldPos.xyz;
+	fragNormal = normalize(transform.normalMatrix * localNormal);
+	fragTexCoord = texCoord;
+	fragMaterial = uvec3(instance.textureIndex, instance.samplerIndex, instance.textureFlags);
+
+	gl_Position = pc.viewProj * worldPos;
+}
@@ -0,0 +1,51 @@
+#version 460
+#extension GL_EXT_nonuniform_qualifier : require
+
+// One step down the bloom chain: a 13-tap filter halving the source (Jimenez, "Next Generation
+// Post Processing in Call of Duty: Advanced Warfare"). The first step also thresholds the scene.
+
+layout(location = 0) in vec2 uv;
+layout(location = 0) out vec4 out_FragColor;
+
+// Must match DownsamplePushConstants in renderer/Bloom.cpp
+layout(push_constant) uniform PushConstants {
+    uint source;
+    uint destination; // compute variant only
+    uint smpl;
+    uint prefilter;
+    uvec2 sourceSize;
+    uvec2 destinationSize;
+    float threshold;
+    float knee;
+} pc;
+
+layout (set = 0, binding = 0) uniform texture2D kTextures2D[];
+layout (set = 0, binding = 1) uniform sampler kSamplers[];
+
+// Each tap is a bilinear sample between four source texels
+vec3 tap(vec2 offset) {
+    vec2 texelSize = 1.0 / vec2(pc.sourceSize);
+    vec3 color = texture(nonuniformEXT(sampler2D(kTextures2D[pc.source], kSamplers[pc.smpl])), uv + offset * texelSize).rgb;
+    if (pc.prefilter == 0) return color;
+
+    // Soft threshold: a quadratic ramp of width 2 * knee around the threshold
+    float brightness = max(color.r, max(color.g, color.b));
+    float soft = clamp(brightness - pc.threshold + pc.knee, 0.0, 2.0 * pc.knee);
+    soft = soft * soft / (4.0 * pc.knee + 1e-5);
+    return color * max(soft, brightness - pc.threshold) / max(brightness, 1e-5);
+}
+
+void main() {
+    vec3 a = tap(vec2(-2.0,  2.0)), b = tap(vec2(0.0,  2.0)), c = tap(vec2(2.0,  2.0));
+    vec3 d = tap(vec2(-1.0,  1.0)), e = tap(vec2(1.0,  1.0));
+    vec3 f = tap(vec2(-2.0,  0.0)), g = tap(vec2(0.0,  0.0)), h = tap(vec2(2.0,  0.0));
+    vec3 i = tap(vec2(-1.0, -1.0)), j = tap(vec2(1.0, -1.0));
+    vec3 k = tap(vec2(-2.0, -2.0)), l = tap(vec2(0.0, -2.0)), m = tap(vec2(2.0, -2.0));
+
+    // Inner box 0.5, four overlapping outer boxes 0.125 each
+    vec3 color = (d + e + i + j) * 0.125;
+    color += (a + c + k + m) * 0.03125;
+    color += (b + f + h + l) * 0.0625;
+    color += g * 0.125;
+    out_FragColor = vec4(color, 1.0);
+}
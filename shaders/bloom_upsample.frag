@@ -0,0 +1,36 @@
+#version 460
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_EXT_samplerless_texture_functions : require
+
+// One step up the bloom chain: this level's downsampled image plus the level below it, blurred
+// by a 3x3 tent while it is upsampled. The radius widens the tent.
+
+layout(location = 0) in vec2 uv;
+layout(location = 0) out vec4 out_FragColor;
+
+// Must match UpsamplePushConstants in renderer/Bloom.cpp
+layout(push_constant) uniform PushConstants {
+    uint source;      // the smaller, already upsampled level
+    uint current;     // this level of the downsample chain
+    uint destination; // compute variant only
+    uint smpl;
+    uvec2 sourceSize;
+    uvec2 destinationSize;
+    float radius;
+} pc;
+
+layout (set = 0, binding = 0) uniform texture2D kTextures2D[];
+layout (set = 0, binding = 1) uniform sampler kSamplers[];
+
+vec3 tap(vec2 offset) {
+    vec2 texelSize = pc.radius / vec2(pc.sourceSize);
+    return texture(nonuniformEXT(sampler2D(kTextures2D[pc.source], kSamplers[pc.smpl])), uv + offset * texelSize).rgb;
+}
+
+void main() {
+    vec3 color = tap(vec2(0.0)) * 4.0;
+    color += (tap(vec2(-1.0, 0.0)) + tap(vec2(1.0, 0.0)) + tap(vec2(0.0, -1.0)) + tap(vec2(0.0, 1.0))) * 2.0;
+    color += tap(vec2(-1.0, -1.0)) + tap(vec2(1.0, -1.0)) + tap(vec2(-1.0, 1.0)) + tap(vec2(1.0, 1.0));
+    color = color / 16.0 + texelFetch(kTextures2D[pc.current], ivec2(gl_FragCoord.xy), 0).rgb;
+    out_FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,371 @@
+#version 460
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_EXT_samplerless_texture_functions : require
+
+// Every post-processing effect, composed into one fullscreen pass by specialization constants
+// (see renderer/PostStack.h). kStageCount and kStage0..7 pick the stages at pipeline creation,
+// so each permutation compiles to straight-line code for just its effects.
+//
+// A stack of effects samples its input once: the UV warps of all stages are composed back to
+// front into one sample position, then the colour parts run front to back, each at the position
+// its own pass would have shaded. Effects that read their input at several positions (see
+// readsNeighborhood) can only be the first stage, where they read the real input.
+
+layout(location = 0) in vec2 uv;
+layout(location = 0) out vec4 out_FragColor;
+
+// Must match PostPushConstants in main.cpp
+layout(push_constant) uniform PushConstants {
+    uint texColor;
+    uint smpl;
+    float time;
+    uint noise;
+    uint noise2;
+    uint noiseFlags;      // TextureFlagBits of noise, then of noise2 shifted by 8
+    uint bloom;           // half-resolution result of the bloom chain (see renderer/Bloom.h)
+    float bloomIntensity; // already divided by the number of levels summed into it
+} pc;
+
+layout (set = 0, binding = 0) uniform texture2D kTextures2D[];
+layout (set = 0, binding = 1) uniform sampler kSamplers[];
+
+// Must match PostEffectType in renderer/PostStack.h
+const uint EFFECT_TONE_MAP = 0;
+const uint EFFECT_CRT = 1;
+const uint EFFECT_BLOOM = 2;
+const uint EFFECT_DREAM = 3;
+const uint EFFECT_GLITCH = 4;
+const uint EFFECT_PIXELATION = 5;
+const uint EFFECT_FOG = 6;
+const uint EFFECT_UNDERWATER = 7;
+const uint EFFECT_DITHERING = 8;
+const uint EFFECT_POSTERIZATION = 9;
+
+const int kMaxStages = 8;
+layout (constant_id = 0) const uint kStageCount = 0;
+layout (constant_id = 1) const uint kStage0 = EFFECT_TONE_MAP;
+layout (constant_id = 2) const uint kStage1 = EFFECT_TONE_MAP;
+layout (constant_id = 3) const uint kStage2 = EFFECT_TONE_MAP;
+layout (constant_id = 4) const uint kStage3 = EFFECT_TONE_MAP;
+layout (constant_id = 5) const uint kStage4 = EFFECT_TONE_MAP;
+layout (constant_id = 6) const uint kStage5 = EFFECT_TONE_MAP;
+layout (constant_id = 7) const uint kStage6 = EFFECT_TONE_MAP;
+layout (constant_id = 8) const uint kStage7 = EFFECT_TONE_MAP;
+
+uint stageEffect(int stage) {
+    switch (stage) {
+    case 0: return kStage0;
+    case 1: return kStage1;
+    case 2: return kStage2;
+    case 3: return kStage3;
+    case 4: return kStage4;
+    case 5: return kStage5;
+    case 6: return kStage6;
+    default: return kStage7;
+    }
+}
+
+// Must match ReadsNeighborhood() in renderer/PostStack.cpp
+bool readsNeighborhood(uint effect) {
+    return effect == EFFECT_BLOOM || effect == EFFECT_DREAM || effect == EFFECT_GLITCH || effect == EFFECT_UNDERWATER;
+}
+
+vec4 sampleInput(vec2 p) {
+    return texture(nonuniformEXT(sampler2D(kTextures2D[pc.texColor], kSamplers[pc.smpl])), p);
+}
+
+vec4 sampleTexture(uint textureId, vec2 p) {
+    return texture(nonuniformEXT(sampler2D(kTextures2D[textureId], kSamplers[pc.smpl])), p);
+}
+
+// Same size as the output, so positions convert to what gl_FragCoord was in a pass of its own
+vec2 fragCoordAt(vec2 p) {
+    return p * vec2(textureSize(kTextures2D[pc.texColor], 0));
+}
+
+float rand(vec2 co) {
+    return fract(sin(dot(co.xy, vec2(12.9898, 78.233))) * 43758.5453);
+}
+
+float srgbToLinear(float c) {
+    return c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+}
+
+// ---- CRT ----
+
+const vec4 kCrtColors[4] = { vec4(1, 0, 0, 0.75), vec4(0, 1, 0, 0.75), vec4(0, 0, 1, 0.75), vec4(0, 0, 0, 0.5) };
+const float kCrtFactors[4] = { 0.97, 0.97, 0.97, 0.85 };
+
+vec2 crtWarp(vec2 p) {
+    return vec2(p.x + sin(fragCoordAt(p).y + pc.time) * 0.0006, p.y);
+}
+
+vec4 crtShade(vec4 color, vec2 p) {
+    vec2 fragCoord = fragCoordAt(p);
+    float x = floor(fragCoord.x / 3);
+    float y = floor(fragCoord.y / 4);
+    color = mix(color * 1.5, color, 1 - (1 / (mod(fragCoord.y * x - (pc.time * 2), 256))));
+    int i = int(mod(x, 4));
+    color = mix(kCrtColors[i], color, kCrtFactors[i]);
+    return mix(color * 0.1, color, abs(sin(y + pc.time)));
+}
+
+// ---- Bloom (composites the chain built from this pass's input) ----
+
+vec3 aces(vec3 x) {
+    const float a = 2.51;
+    const float b = 0.03;
+    const float c = 2.43;
+    const float d = 0.59;
+    const float e = 0.14;
+    return clamp((x * (a * x + b)) / (x * (c * x + d) + e), 0.0, 1.0);
+}
+
+vec4 bloomStage(vec2 p) {
+    const float exposure = 1.2;
+    vec3 color = sampleInput(p).rgb + sampleTexture(pc.bloom, p).rgb * pc.bloomIntensity;
+    return vec4(aces(color * exposure), 1.0);
+}
+
+// ---- Dream ----
+
+vec2 dreamWarp(vec2 p) {
+    vec2 toCenter = vec2(0.5) - p;
+    float dist = length(toCenter);
+    float pulse = sin(pc.time * 2.0) * 0.02;
+    float spiral = dist * 0.1;
+    vec2 warped = p + normalize(toCenter) * (pulse + spiral);
+    warped.x += sin(warped.y * 10.0 + pc.time * 3.0) * 0.02;
+    warped.y += cos(warped.x * 8.0 + pc.time * 2.0) * 0.02;
+    return warped;
+}
+
+vec4 dreamStage(vec2 p) {
+    vec2 warped = dreamWarp(p);
+    vec3 color = sampleInput(warped).rgb;
+
+    // Blue tint, brightness pulse and a slowly cycling rainbow
+    color = mix(color, vec3(0.7, 0.9, 1.0), 0.2);
+    color *= sin(pc.time * 3.0) * 0.1 + 0.9;
+    float rainbow = sin(pc.time * 2.0);
+    color *= vec3(sin(rainbow + 0.0), sin(rainbow + 2.0), sin(rainbow + 4.0)) * 0.1 + 0.9;
+
+    // Soft glow
+    vec3 glow = vec3(0.0);
+    float totalWeight = 0.0;
+    for (float i = -2.0; i <= 2.0; i += 1.0) {
+        for (float j = -2.0; j <= 2.0; j += 1.0) {
+            vec2 offset = vec2(i, j) * 0.005;
+            float weight = 1.0 - length(offset) * 0.5;
+            glow += sampleInput(warped + offset).rgb * weight;
+            totalWeight += weight;
+        }
+    }
+    color = mix(color, glow / totalWeight, 0.3);
+
+    // Glowing edges
+    vec2 texelSize = 1.0 / vec2(textureSize(kTextures2D[pc.texColor], 0));
+    vec3 centerColor = sampleInput(warped).rgb;
+    float edge = 0.0;
+    for (int i = -1; i <= 1; i++) {
+        for (int j = -1; j <= 1; j++) {
+            if (i == 0 && j == 0) continue;
+            edge += length(sampleInput(warped + vec2(i, j) * texelSize).rgb - centerColor);
+        }
+    }
+    color = mix(color, vec3(1.0), smoothstep(0.2, 0.8, edge) * 0.3);
+
+    vec2 vignetteUV = p * 2.0 - 1.0;
+    color *= 1.0 - dot(vignetteUV, vignetteUV) * 0.3;
+    return vec4(pow(color, vec3(0.8)), 1.0);
+}
+
+// ---- Glitch ----
+
+vec4 glitchStage(vec2 p) {
+    vec2 fragCoord = fragCoordAt(p);
+    float time = float(uint(fragCoord.x + fragCoord.y) % 6311) / 6311.0;
+
+    // Horizontal block offsets
+    vec2 glitchUV = p;
+    float blockNoise = rand(vec2(floor(p.y * 10.0), time));
+    if (blockNoise > 0.95) {
+        glitchUV.x += (blockNoise - 0.95) * 2.0;
+    }
+
+    // RGB split
+    float offset = (rand(vec2(time, glitchUV.y)) - 0.5) * 0.05;
+    vec3 color;
+    color.r = sampleInput(vec2(glitchUV.x + offset, glitchUV.y)).r;
+    color.g = sampleInput(glitchUV).g;
+    color.b = sampleInput(vec2(glitchUV.x - offset, glitchUV.y)).b;
+
+    float wave = sin(glitchUV.y * 400.0 + time * 10.0) * 0.5 + 0.5;
+    color *= 1.0 - step(0.5, wave) * 0.15;
+    if (rand(vec2(time, glitchUV.x)) > 0.99) {
+        color = vec3(1.0) - color;
+    }
+    if (rand(vec2(floor(glitchUV.x * 20.0), time)) > 0.98) {
+        color *= 0.5;
+    }
+    if (rand(glitchUV + time) > 0.995) {
+        color = vec3(1.0);
+    }
+    color *= 1.0 + sin(glitchUV.y * 10.0 + time * 5.0) * 0.1;
+    return vec4(color, 1.0);
+}
+
+// ---- Pixelation ----
+
+vec2 pixelationWarp(vec2 p) {
+    const vec2 pixels = vec2(140.0);
+    return floor(p * pixels) / pixels;
+}
+
+// ---- Fog ----
+
+vec4 fogShade(vec4 color, vec2 p) {
+    const vec4 fogColor = vec4(1.0);
+    const float noiseScale = 0.5;
+    const float noiseScale2 = 1.0;
+    const float noiseSpeed = 0.24;
+    const float noiseSpeed2 = 0.06;
+
+    vec2 noiseUV = mod(p * noiseScale + vec2(pc.time * noiseSpeed, pc.time * noiseSpeed * 0.7), 1);
+    vec2 noiseUV2 = mod(p * noiseScale2 + vec2(pc.time * noiseSpeed2, pc.time * noiseSpeed2 * 0.7), 1);
+    float noise = sampleTexture(pc.noise, noiseUV).r;
+    float noise2 = sampleTexture(pc.noise2, noiseUV2).r;
+    if ((pc.noiseFlags & 0x1u) != 0u) noise = srgbToLinear(noise);
+    if ((pc.noiseFlags & 0x100u) != 0u) noise2 = srgbToLinear(noise2);
+
+    vec4 color1 = mix(color, fogColor, noise > noise2 ? 1 - (1.5 * noise) : (1 - (1.5 * noise)) / 2);
+    vec4 color2 = mix(color, fogColor, noise2 > noise ? 1 - noise2 : noise2);
+    return (color1 + color2) / 2;
+}
+
+// ---- Underwater ----
+
+vec4 underwaterStage(vec2 p) {
+    const vec4 waterColor = vec4(0.0, 0.56, 0.88, 1.0);
+    const float waterIntensity = 0.2;
+
+    vec2 waveUV = p;
+    waveUV.y += sin((2 * pc.time) + (fragCoordAt(p).x / 8)) * 0.002;
+    vec4 color = mix(sampleInput(waveUV), waterColor, waterIntensity);
+
+    // Sparkles drifting across a grid
+    vec2 movingUV = p + vec2(pc.time * 0.01, pc.time * 0.005);
+    vec2 sparkleGrid = floor(movingUV * vec2(40.0, 16.0));
+    float sparkleTime = fract(pc.time * 0.05 + dot(sparkleGrid, vec2(12.9898, 78.233)) * 0.1);
+    if (sparkleTime > 0.85 && sparkleTime < 0.9) {
+        vec2 normalizedPos = fract(movingUV * vec2(40.0, 16.0)) * vec2(1.0, 40.0 / 16.0);
+        float sparkleDist = distance(normalizedPos, vec2(0.5, 0.5 * 40.0 / 16.0));
+        color.rgb += vec3(max(0.0, (1.0 - sparkleDist * 2.0) * (sparkleTime - 0.85) * 5.0) * 0.5);
+    }
+
+    // Rising bubbles that refract what is behind them
+    vec2 bubbleUV = waveUV;
+    for (int i = 0; i < 8; i++) {
+        float bubbleY = 1.0 - fract(pc.time * (0.1 + float(i) * 0.05) + float(i) * 0.33);
+        vec2 bubblePos = vec2(fract(float(i) * 0.618033988749895), bubbleY);
+        float bubbleRadius = max(0.02, fract(sin(float(i) * 7.891) * 12345.6789) * 0.08);
+
+        float bubbleDist = distance(p * vec2(1.0, 0.6), bubblePos * vec2(1.0, 0.6));
+        if (bubbleDist < bubbleRadius) {
+            bubbleUV += (p - bubblePos) * (1.0 - bubbleDist / bubbleRadius) * 0.2;
+            float bubbleAlpha = 1.0 - smoothstep(bubbleRadius * 0.6, bubbleRadius, bubbleDist);
+            vec3 bubbleColor = vec3(0.8, 0.9, 1.0) + vec3((1.0 - smoothstep(0.0, 0.03, bubbleDist)) * 0.3);
+            color.rgb = mix(color.rgb, bubbleColor, bubbleAlpha * 0.2);
+        }
+    }
+    return mix(color, sampleInput(bubbleUV), 0.7);
+}
+
+// ---- Dithering ----
+
+const float kDitherPattern[8][8] = {
+    {0.0, 1.0, 0.0, 1.0, 1.0, 0.0, 1.0, 0.0},
+    {1.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 1.0},
+    {0.0, 1.0, 0.0, 1.0, 1.0, 0.0, 1.0, 0.0},
+    {1.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 1.0},
+    {1.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 1.0},
+    {0.0, 1.0, 0.0, 1.0, 1.0, 0.0, 1.0, 0.0},
+    {1.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 1.0},
+    {0.0, 1.0, 0.0, 1.0, 1.0, 0.0, 1.0, 0.0}
+};
+
+vec4 ditheringShade(vec4 color, vec2 p) {
+    const int kernelSize = 8;
+    const int pixelSize = 2;
+    vec2 fragCoord = fragCoordAt(p);
+    int x = int(mod(fragCoord.x / pixelSize, kernelSize));
+    int y = int(mod(fragCoord.y / pixelSize, kernelSize));
+    return mix(vec4(0.0), color, kDitherPattern[x][y]);
+}
+
+// ---- Posterization ----
+
+const vec4 kPosterColors[5] = { vec4(0.035, 0.043, 0.043, 1), vec4(0.271, 0.373, 0.337, 1), vec4(0.4, 0.639, 0.451, 1),
+                                vec4(0.773, 0.929, 0.675, 1), vec4(0.859, 0.996, 0.722, 1) };
+
+vec4 posterizationShade(vec4 color) {
+    int index = int(floor((((color.x + color.y + color.z) / 3) + 0.5) * 5));
+    return kPosterColors[clamp(index, 0, 4)];
+}
+
+// ---- Composition ----
+
+// Where a stage's pass samples its input, given the position it shades
+vec2 warp(uint effect, vec2 p) {
+    switch (effect) {
+    case EFFECT_CRT: return crtWarp(p);
+    case EFFECT_PIXELATION: return pixelationWarp(p);
+    default: return p;
+    }
+}
+
+// The colour part of an effect that reads its input at one position
+vec4 shade(uint effect, vec4 color, vec2 p) {
+    switch (effect) {
+    case EFFECT_CRT: return crtShade(color, p);
+    case EFFECT_FOG: return fogShade(color, p);
+    case EFFECT_DITHERING: return ditheringShade(color, p);
+    case EFFECT_POSTERIZATION: return posterizationShade(color);
+    default: return color;
+    }
+}
+
+// A whole effect that reads its input at several positions; only ever the first stage
+vec4 neighborhoodStage(uint effect, vec2 p) {
+    switch (effect) {
+    case EFFECT_BLOOM: return bloomStage(p);
+    case EFFECT_DREAM: return dreamStage(p);
+    case EFFECT_GLITCH: return glitchStage(p);
+    default: return underwaterStage(p);
+    }
+}
+
+void main() {
+    bool firstReadsNeighborhood = kStageCount > 0 && readsNeighborhood(stageEffect(0));
+
+    // Back to front: the position each stage shades, and finally where the input is sampled
+    vec2 positions[kMaxStages];
+    vec2 p = uv;
+    for (int i = int(kStageCount) - 1; i >= 0; --i) {
+        positions[i] = p;
+        p = warp(stageEffect(i), p);
+    }
+
+    int first = 0;
+    vec4 color;
+    if (firstReadsNeighborhood) {
+        color = neighborhoodStage(stageEffect(0), positions[0]);
+        first = 1;
+    } else {
+        color = sampleInput(p);
+    }
+    for (int i = first; i < int(kStageCount); ++i) {
+        color = shade(stageEffect(i), color, positions[i]);
+    }
+    out_FragColor = color;
+}
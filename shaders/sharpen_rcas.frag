@@ -0,0 +1,53 @@
+#version 460
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_EXT_samplerless_texture_functions : require
+
+// Contrast-adaptive sharpening after AMD FidelityFX Super Resolution 1.0 (RCAS), run on the
+// output of upscale_easu.frag. A negative lobe on the 4 direct neighbours sharpens the pixel, as
+// far as it can go without leaving the range of its neighbourhood, so it never clips or rings.
+//
+//     b
+//   d e f
+//     h
+
+layout(location = 0) in vec2 uv;
+layout(location = 0) out vec4 out_FragColor;
+
+// Must match UpscalePushConstants in renderer/DynamicResolution.cpp
+layout(push_constant) uniform PushConstants {
+    uint source;
+    uint smpl;
+    uvec2 sourceSize;
+    uvec2 destinationSize;
+    float sharpness; // 0 is off, 1 is the strongest lobe RCAS allows
+} pc;
+
+layout (set = 0, binding = 0) uniform texture2D kTextures2D[];
+layout (set = 0, binding = 1) uniform sampler kSamplers[];
+
+// Limits the lobe so the 4 neighbours can never outweigh the centre
+const float kLobeLimit = 0.25 - 1.0 / 16.0;
+
+vec3 fetch(ivec2 position) {
+    return texelFetch(kTextures2D[pc.source], clamp(position, ivec2(0), ivec2(pc.sourceSize) - 1), 0).rgb;
+}
+
+void main() {
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    vec3 b = fetch(p + ivec2(0, -1));
+    vec3 d = fetch(p + ivec2(-1, 0));
+    vec3 e = fetch(p);
+    vec3 f = fetch(p + ivec2(1, 0));
+    vec3 h = fetch(p + ivec2(0, 1));
+
+    // The largest negative lobe that keeps the result inside [min, max] of the neighbourhood
+    vec3 minRing = min(min(b, d), min(f, h));
+    vec3 maxRing = max(max(b, d), max(f, h));
+    vec3 hitMin = min(minRing, e) / max(4.0 * maxRing, 1e-5);
+    vec3 hitMax = (1.0 - max(maxRing, e)) / min(4.0 * minRing - 4.0, -1e-5);
+    vec3 lobeRGB = max(-hitMin, hitMax);
+    float lobe = max(-kLobeLimit, min(max(lobeRGB.r, max(lobeRGB.g, lobeRGB.b)), 0.0)) * pc.sharpness;
+
+    vec3 color = (lobe * (b + d + f + h) + e) / (4.0 * lobe + 1.0);
+    out_FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,24 @@
+#version 460
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Stretches the scene, rendered at the dynamic resolution scale, to the output size with the
+// hardware bilinear filter.
+
+layout(location = 0) in vec2 uv;
+layout(location = 0) out vec4 out_FragColor;
+
+// Must match UpscalePushConstants in renderer/DynamicResolution.cpp
+layout(push_constant) uniform PushConstants {
+    uint source;
+    uint smpl;
+    uvec2 sourceSize;
+    uvec2 destinationSize;
+    float sharpness;
+} pc;
+
+layout (set = 0, binding = 0) uniform texture2D kTextures2D[];
+layout (set = 0, binding = 1) uniform sampler kSamplers[];
+
+void main() {
+    out_FragColor = vec4(texture(nonuniformEXT(sampler2D(kTextures2D[pc.source], kSamplers[pc.smpl])), uv).rgb, 1.0);
+}
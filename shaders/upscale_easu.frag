@@ -0,0 +1,129 @@
+#version 460
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_EXT_samplerless_texture_functions : require
+
+// Edge-adaptive upscale after AMD FidelityFX Super Resolution 1.0 (EASU). Each output pixel
+// filters the 12 source texels around it with a Lanczos-like kernel that is stretched along the
+// local edge direction, so edges stay sharp instead of turning into bilinear staircases. The
+// result is clamped to the 2x2 texels nearest to it, which removes the kernel's ringing.
+//
+//     b c
+//   e f g h
+//   i j k l
+//     n o
+
+layout(location = 0) in vec2 uv;
+layout(location = 0) out vec4 out_FragColor;
+
+// Must match UpscalePushConstants in renderer/DynamicResolution.cpp
+layout(push_constant) uniform PushConstants {
+    uint source;
+    uint smpl;
+    uvec2 sourceSize;
+    uvec2 destinationSize;
+    float sharpness;
+} pc;
+
+layout (set = 0, binding = 0) uniform texture2D kTextures2D[];
+layout (set = 0, binding = 1) uniform sampler kSamplers[];
+
+vec3 fetch(ivec2 position) {
+    return texelFetch(kTextures2D[pc.source], clamp(position, ivec2(0), ivec2(pc.sourceSize) - 1), 0).rgb;
+}
+
+// Cheap luma, only used to find edges
+float luma(vec3 c) {
+    return c.b * 0.5 + (c.r * 0.5 + c.g);
+}
+
+// Accumulates the edge direction and length around one of the 4 inner texels, weighted by its
+// bilinear weight w. a is above the texel, b to its left, c the texel, d to its right, e below.
+void accumulateEdge(inout vec2 dir, inout float len, float w, float a, float b, float c, float d, float e) {
+    float dirX = d - b;
+    float lenX = clamp(abs(dirX) / max(max(abs(d - c), abs(c - b)), 1e-5), 0.0, 1.0);
+    dir.x += dirX * w;
+    len += lenX * lenX * w;
+
+    float dirY = e - a;
+    float lenY = clamp(abs(dirY) / max(max(abs(e - c), abs(c - a)), 1e-5), 0.0, 1.0);
+    dir.y += dirY * w;
+    len += lenY * lenY * w;
+}
+
+// Adds one texel at offset from the sample position, rotated into the edge frame and scaled by
+// the anisotropic kernel length
+void accumulateTap(inout vec3 color, inout float weight, vec2 offset, vec2 dir, vec2 len, float lobe, float clip, vec3 c) {
+    vec2 v = vec2(dot(offset, dir), dot(offset, vec2(-dir.y, dir.x))) * len;
+    float d2 = min(dot(v, v), clip);
+    // Polynomial approximation of Lanczos2: a base window times an adjustable lobe
+    float wB = 2.0 / 5.0 * d2 - 1.0;
+    float wA = lobe * d2 - 1.0;
+    wB *= wB;
+    wA *= wA;
+    wB = 25.0 / 16.0 * wB - (25.0 / 16.0 - 1.0);
+    float w = wB * wA;
+    color += c * w;
+    weight += w;
+}
+
+void main() {
+    vec2 position = gl_FragCoord.xy * vec2(pc.sourceSize) / vec2(pc.destinationSize) - 0.5;
+    vec2 base = floor(position);
+    vec2 pp = position - base;
+    ivec2 f0 = ivec2(base);
+
+    vec3 b = fetch(f0 + ivec2(0, -1));
+    vec3 c = fetch(f0 + ivec2(1, -1));
+    vec3 e = fetch(f0 + ivec2(-1, 0));
+    vec3 f = fetch(f0);
+    vec3 g = fetch(f0 + ivec2(1, 0));
+    vec3 h = fetch(f0 + ivec2(2, 0));
+    vec3 i = fetch(f0 + ivec2(-1, 1));
+    vec3 j = fetch(f0 + ivec2(0, 1));
+    vec3 k = fetch(f0 + ivec2(1, 1));
+    vec3 l = fetch(f0 + ivec2(2, 1));
+    vec3 n = fetch(f0 + ivec2(0, 2));
+    vec3 o = fetch(f0 + ivec2(1, 2));
+
+    float bL = luma(b), cL = luma(c), eL = luma(e), fL = luma(f), gL = luma(g), hL = luma(h);
+    float iL = luma(i), jL = luma(j), kL = luma(k), lL = luma(l), nL = luma(n), oL = luma(o);
+
+    vec2 dir = vec2(0.0);
+    float len = 0.0;
+    accumulateEdge(dir, len, (1.0 - pp.x) * (1.0 - pp.y), bL, eL, fL, gL, jL);
+    accumulateEdge(dir, len, pp.x * (1.0 - pp.y), cL, fL, gL, hL, kL);
+    accumulateEdge(dir, len, (1.0 - pp.x) * pp.y, fL, iL, jL, kL, nL);
+    accumulateEdge(dir, len, pp.x * pp.y, gL, jL, kL, lL, oL);
+
+    // Normalized edge direction; flat areas fall back to an axis-aligned kernel
+    float dirLength2 = dot(dir, dir);
+    bool isFlat = dirLength2 < 1.0 / 32768.0;
+    dir = isFlat ? vec2(1.0, 0.0) : dir * inversesqrt(dirLength2);
+
+    // Stronger edges stretch the kernel along the edge and sharpen its lobe
+    len *= 0.5;
+    len *= len;
+    float stretch = dot(dir, dir) / max(abs(dir.x), abs(dir.y));
+    vec2 kernelLength = vec2(1.0 + (stretch - 1.0) * len, 1.0 - 0.5 * len);
+    float lobe = 0.5 + ((1.0 / 4.0 - 0.04) - 0.5) * len;
+    float clip = 1.0 / lobe;
+
+    vec3 color = vec3(0.0);
+    float weight = 0.0;
+    accumulateTap(color, weight, vec2(0.0, -1.0) - pp, dir, kernelLength, lobe, clip, b);
+    accumulateTap(color, weight, vec2(1.0, -1.0) - pp, dir, kernelLength, lobe, clip, c);
+    accumulateTap(color, weight, vec2(-1.0, 1.0) - pp, dir, kernelLength, lobe, clip, i);
+    accumulateTap(color, weight, vec2(0.0, 1.0) - pp, dir, kernelLength, lobe, clip, j);
+    accumulateTap(color, weight, vec2(0.0, 0.0) - pp, dir, kernelLength, lobe, clip, f);
+    accumulateTap(color, weight, vec2(-1.0, 0.0) - pp, dir, kernelLength, lobe, clip, e);
+    accumulateTap(color, weight, vec2(1.0, 1.0) - pp, dir, kernelLength, lobe, clip, k);
+    accumulateTap(color, weight, vec2(2.0, 1.0) - pp, dir, kernelLength, lobe, clip, l);
+    accumulateTap(color, weight, vec2(2.0, 0.0) - pp, dir, kernelLength, lobe, clip, h);
+    accumulateTap(color, weight, vec2(1.0, 0.0) - pp, dir, kernelLength, lobe, clip, g);
+    accumulateTap(color, weight, vec2(1.0, 2.0) - pp, dir, kernelLength, lobe, clip, o);
+    accumulateTap(color, weight, vec2(0.0, 2.0) - pp, dir, kernelLength, lobe, clip, n);
+
+    vec3 minColor = min(min(f, g), min(j, k));
+    vec3 maxColor = max(max(f, g), max(j, k));
+    out_FragColor = vec4(clamp(color / weight, minColor, maxColor), 1.0);
+}
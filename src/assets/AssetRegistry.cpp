@@ -0,0 +1,348 @@
+#include <assets/AssetRegistry.h>
+#include <assets/TextureImporter.h>
+#include <core/Profiler.h>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+AssetRegistry::AssetRegistry(lvk::IContext* ctx_, size_t gpuMemoryBudget_, VertexLayout vertexLayout_)
+    : ctx(ctx_), gpuMemoryBudget(gpuMemoryBudget_), vertexLayout(vertexLayout_), geometry(ctx_, GetVertexStride(vertexLayout_)) {
+    // Placeholders are tiny and built in code, so they are available before the first frame
+    MeshData placeholderData;
+    BuildPlaceholderMesh(vertexLayout, placeholderData.cooked);
+    placeholderMesh = std::make_unique<MeshAsset>();
+    placeholderMesh->path = "<placeholder>";
+    UploadMesh(*placeholderMesh, placeholderData);
+    placeholderMesh->state = AssetState::Ready;
+
+    const uint32_t checker[4] = {0xff808080, 0xffa0a0a0, 0xffa0a0a0, 0xff808080};
+    placeholderTexture = ctx->createTexture({
+        .type = lvk::TextureType_2D,
+        .format = lvk::Format_RGBA_UN8,
+        .dimensions = {2, 2, 1},
+        .usage = lvk::TextureUsageBits_Sampled,
+        .data = checker,
+        .debugName = "Placeholder Texture"
+    });
+
+    std::cout << "Asset registry started with " << workers.GetNumThreads() << " loader threads" << std::endl;
+}
+
+AssetRegistry::~AssetRegistry() {
+    WaitIdle();
+    LogStats();
+}
+
+std::string AssetRegistry::NormalizePath(const std::string& path_) {
+    std::error_code ec;
+    std::filesystem::path normalized = std::filesystem::weakly_canonical(path_, ec);
+    if (ec) {
+        normalized = std::filesystem::path(path_).lexically_normal();
+    }
+    return normalized.generic_string();
+}
+
+std::string AssetRegistry::MakeMeshKey(const std::string& path_, uint32_t importFlags_) {
+    return "mesh:" + NormalizePath(path_) + "#" + std::to_string(importFlags_);
+}
+
+std::string AssetRegistry::MakeTextureKey(const std::string& path_, lvk::Format format_) {
+    return "texture:" + NormalizePath(path_) + "#" + std::to_string(format_);
+}
+
+AssetRegistry::Entry* AssetRegistry::FindEntry(const std::string& key_) {
+    auto it = entries.find(key_);
+    if (it == entries.end()) {
+        stats.misses++;
+        return nullptr;
+    }
+    stats.hits++;
+    lru.splice(lru.begin(), lru, it->second.lruPosition);
+    return &it->second;
+}
+
+AssetRegistry::Entry& AssetRegistry::AddEntry(const std::string& key_, Entry&& entry_) {
+    lru.push_front(key_);
+    entry_.lruPosition = lru.begin();
+    if (entry_.mesh) stats.residentMeshes++;
+    if (entry_.texture) stats.residentTextures++;
+    stats.pendingLoads++;
+    return entries.emplace(key_, std::move(entry_)).first->second;
+}
+
+bool AssetRegistry::EntryAwaiter::await_ready() const {
+    auto it = registry->entries.find(key);
+    return it == registry->entries.end() || it->second.GetState() != AssetState::Loading;
+}
+
+void AssetRegistry::EntryAwaiter::await_suspend(std::coroutine_handle<> handle_) const {
+    registry->entries.at(key).waiters.push_back(handle_);
+}
+
+void AssetRegistry::FinishLoad(const std::string& key_, size_t gpuMemorySize_, bool succeeded_) {
+    auto it = entries.find(key_);
+    if (it == entries.end()) return;
+
+    Entry& entry = it->second;
+    stats.pendingLoads--;
+    std::vector<std::coroutine_handle<>> waiters = std::move(entry.waiters);
+
+    if (succeeded_) {
+        entry.gpuMemorySize = gpuMemorySize_;
+        stats.gpuMemoryUsage += gpuMemorySize_;
+        if (entry.mesh) entry.mesh->state.store(AssetState::Ready, std::memory_order_release);
+        if (entry.texture) entry.texture->state.store(AssetState::Ready, std::memory_order_release);
+    } else {
+        stats.failedLoads++;
+        if (entry.mesh) entry.mesh->state.store(AssetState::Failed, std::memory_order_release);
+        if (entry.texture) entry.texture->state.store(AssetState::Failed, std::memory_order_release);
+        // Forget failed entries so a later request retries; current holders keep the Failed asset
+        if (entry.mesh) stats.residentMeshes--;
+        if (entry.texture) stats.residentTextures--;
+        lru.erase(entry.lruPosition);
+        entries.erase(it);
+    }
+
+    for (std::coroutine_handle<> waiter : waiters) {
+        waiter.resume();
+    }
+    CollectGarbage();
+}
+
+MeshRef AssetRegistry::RequestMesh(const std::string& path_, uint32_t importFlags_) {
+    const std::string key = MakeMeshKey(path_, importFlags_);
+    if (Entry* entry = FindEntry(key)) {
+        return entry->mesh;
+    }
+
+    Entry entry;
+    entry.mesh = std::make_shared<MeshAsset>();
+    entry.mesh->path = path_;
+    std::shared_ptr<MeshAsset> asset = AddEntry(key, std::move(entry)).mesh;
+    SpawnDetached(LoadMeshInBackground(key, path_, importFlags_, asset));
+    return asset;
+}
+
+TextureRef AssetRegistry::RequestTexture(const std::string& path_, lvk::Format format_) {
+    const std::string key = MakeTextureKey(path_, format_);
+    if (Entry* entry = FindEntry(key)) {
+        return entry->texture;
+    }
+
+    Entry entry;
+    entry.texture = std::make_shared<TextureAsset>();
+    entry.texture->path = path_;
+    std::shared_ptr<TextureAsset> asset = AddEntry(key, std::move(entry)).texture;
+    SpawnDetached(LoadTextureInBackground(key, path_, format_, asset));
+    return asset;
+}
+
+Task<MeshRef> AssetRegistry::LoadMeshAsync(std::string path_, uint32_t importFlags_) {
+    MeshRef mesh = RequestMesh(path_, importFlags_);
+    if (mesh->state.load() == AssetState::Loading) {
+        co_await EntryAwaiter{this, MakeMeshKey(path_, importFlags_)};
+    }
+    co_return mesh->IsReady() ? mesh : nullptr;
+}
+
+Task<TextureRef> AssetRegistry::LoadTextureAsync(std::string path_, lvk::Format format_) {
+    TextureRef texture = RequestTexture(path_, format_);
+    if (texture->state.load() == AssetState::Loading) {
+        co_await EntryAwaiter{this, MakeTextureKey(path_, format_)};
+    }
+    co_return texture->IsReady() ? texture : nullptr;
+}
+
+MeshRef AssetRegistry::LoadMesh(const std::string& path_, uint32_t importFlags_) {
+    MeshRef mesh = RequestMesh(path_, importFlags_);
+    while (mesh->state.load() == AssetState::Loading) {
+        if (ProcessUploads(UINT32_MAX) == 0) std::this_thread::yield();
+    }
+    return mesh->IsReady() ? mesh : nullptr;
+}
+
+TextureRef AssetRegistry::LoadTexture(const std::string& path_, lvk::Format format_) {
+    TextureRef texture = RequestTexture(path_, format_);
+    while (texture->state.load() == AssetState::Loading) {
+        if (ProcessUploads(UINT32_MAX) == 0) std::this_thread::yield();
+    }
+    return texture->IsReady() ? texture : nullptr;
+}
+
+Task<void> AssetRegistry::LoadMeshInBackground(std::string key_, std::string path_, uint32_t importFlags_, std::shared_ptr<MeshAsset> asset_) {
+    // Import (or map the cooked cache) on a worker thread
+    co_await workers.Schedule();
+    auto data = std::make_unique<MeshData>();
+    const bool loaded = LoadMeshData(path_, importFlags_, vertexLayout, *data);
+
+    // GPU work happens back on the render thread, a few uploads per frame
+    co_await uploads.Schedule();
+    if (loaded) {
+        UploadMesh(*asset_, *data);
+    }
+    data.reset();
+    const bool succeeded = loaded && !asset_->meshes.empty();
+    if (!succeeded) {
+        std::cerr << "Failed to load model: " << path_ << std::endl;
+    }
+    FinishLoad(key_, asset_->gpuMemorySize, succeeded);
+}
+
+Task<void> AssetRegistry::LoadTextureInBackground(std::string key_, std::string path_, lvk::Format format_, std::shared_ptr<TextureAsset> asset_) {
+    co_await workers.Schedule();
+    ImageData image;
+    const bool decoded = LoadImageData(path_, image);
+
+    co_await uploads.Schedule();
+    const bool succeeded = decoded && UploadTexture(*asset_, image, format_);
+    FinishLoad(key_, asset_->gpuMemorySize, succeeded);
+}
+
+uint32_t AssetRegistry::ProcessUploads(uint32_t maxUploads_) {
+    return uploads.Pump(maxUploads_);
+}
+
+void AssetRegistry::WaitIdle() {
+    while (stats.pendingLoads > 0) {
+        if (ProcessUploads(UINT32_MAX) == 0) std::this_thread::yield();
+    }
+}
+
+const std::vector<MeshBuffers>& AssetRegistry::Resolve(const MeshRef& mesh_) const {
+    return mesh_ && mesh_->IsReady() ? mesh_->meshes : placeholderMesh->meshes;
+}
+
+lvk::TextureHandle AssetRegistry::Resolve(const TextureRef& texture_) const {
+    return texture_ && texture_->IsReady() ? lvk::TextureHandle(texture_->texture) : lvk::TextureHandle(placeholderTexture);
+}
+
+uint32_t AssetRegistry::ResolveFlags(const TextureRef& texture_) const {
+    return texture_ && texture_->IsReady() ? texture_->flags : 0;
+}
+
+void AssetRegistry::CollectGarbage() {
+    // Walk from the least recently used end; referenced or loading assets are never evicted
+    const uint64_t evictionsBefore = stats.evictions;
+    auto it = lru.end();
+    while (stats.gpuMemoryUsage > gpuMemoryBudget && it != lru.begin()) {
+        --it;
+        auto entryIt = entries.find(*it);
+        if (entryIt == entries.end() || entryIt->second.IsReferenced() || entryIt->second.GetState() != AssetState::Ready) {
+            continue;
+        }
+        const Entry& entry = entryIt->second;
+        std::cout << "Evicting asset: " << *it << " (" << entry.gpuMemorySize / 1024 << " KB)" << std::endl;
+        stats.gpuMemoryUsage -= entry.gpuMemorySize;
+        if (entry.mesh) stats.residentMeshes--;
+        if (entry.texture) stats.residentTextures--;
+        stats.evictions++;
+        entries.erase(entryIt);
+        it = lru.erase(it);
+    }
+
+    if (stats.evictions != evictionsBefore && geometry.GetStats().fragmentation > kDefragmentThreshold) {
+        geometry.Defragment();
+    }
+}
+
+void AssetRegistry::SetGpuMemoryBudget(size_t budget_) {
+    gpuMemoryBudget = budget_;
+    CollectGarbage();
+}
+
+void AssetRegistry::LogStats() const {
+    std::cout << "Asset registry: " << stats.residentMeshes << " meshes, " << stats.residentTextures << " textures, "
+              << stats.gpuMemoryUsage / (1024 * 1024) << " / " << gpuMemoryBudget / (1024 * 1024) << " MB, "
+              << stats.hits << " hits, " << stats.misses << " misses, " << stats.evictions << " evictions" << std::endl;
+}
+
+void AssetRegistry::UploadMesh(MeshAsset& asset_, const MeshData& data_) {
+    VKENGINE_PROFILE_ZONE("Upload mesh");
+    asset_.meshes.reserve(data_.GetSubmeshCount());
+
+    MeshOptimizationStats& totals = asset_.optimizationStats;
+    uint64_t totalIndices = 0;
+
+    const uint32_t stride = data_.GetVertexStride();
+    for (uint32_t mi = 0; mi < data_.GetSubmeshCount(); ++mi) {
+        const MeshCacheSubmesh& submesh = data_.GetSubmesh(mi);
+        if (submesh.vertexCount == 0 || submesh.indexCount == 0) {
+            std::cerr << "Failed to upload mesh " << mi << ": mesh has no geometry" << std::endl;
+            continue;
+        }
+
+        // Copy straight from the source blobs (mapped cache file or freshly imported data) into the arena
+        const size_t vertexDataSize = size_t(submesh.vertexCount) * stride;
+        const uint32_t totalIndexCount = submesh.GetTotalIndexCount();
+        const size_t indexDataSize = size_t(submesh.indexSize) * totalIndexCount;
+        MeshBuffers out{};
+        out.geometry = geometry.Allocate(data_.GetVertexData() + size_t(submesh.firstVertex) * stride, submesh.vertexCount,
+                                         data_.GetIndexData() + submesh.indexOffset, totalIndexCount,
+                                         submesh.indexSize == sizeof(uint16_t) ? lvk::IndexFormat_UI16 : lvk::IndexFormat_UI32);
+        out.lods[0] = { 0, submesh.indexCount, 0.0f };
+        std::copy(submesh.lods, submesh.lods + submesh.lodCount, out.lods.begin() + 1);
+        out.lodCount = submesh.lodCount + 1;
+        out.boundsMin = glm::vec3(submesh.boundsMin[0], submesh.boundsMin[1], submesh.boundsMin[2]);
+        out.boundsMax = glm::vec3(submesh.boundsMax[0], submesh.boundsMax[1], submesh.boundsMax[2]);
+        out.sphereCenter = glm::vec3(submesh.sphereCenter[0], submesh.sphereCenter[1], submesh.sphereCenter[2]);
+        out.sphereRadius = submesh.sphereRadius;
+        if (vertexLayout == VertexLayout::Packed) {
+            out.positionScale = glm::vec4(out.boundsMax - out.boundsMin, 0.0f);
+            out.positionOffset = glm::vec4(out.boundsMin, 0.0f);
+        }
+
+        const MeshOptimizationStats& stats = submesh.stats;
+        totals.vertexCountBefore += stats.vertexCountBefore;
+        totals.acmrBefore += stats.acmrBefore * submesh.indexCount;
+        totals.acmrAfter += stats.acmrAfter * submesh.indexCount;
+        totals.overdrawBefore += stats.overdrawBefore * submesh.indexCount;
+        totals.overdrawAfter += stats.overdrawAfter * submesh.indexCount;
+        totalIndices += submesh.indexCount;
+
+        asset_.gpuMemorySize += vertexDataSize + indexDataSize;
+        asset_.meshes.emplace_back(std::move(out));
+    }
+
+    if (totalIndices > 0) {
+        const float scale = 1.0f / float(totalIndices);
+        totals.acmrBefore *= scale;
+        totals.acmrAfter *= scale;
+        totals.overdrawBefore *= scale;
+        totals.overdrawAfter *= scale;
+    }
+}
+
+bool AssetRegistry::UploadTexture(TextureAsset& asset_, const ImageData& image_, lvk::Format format_) {
+    VKENGINE_PROFILE_ZONE("Upload texture");
+    const bool srgb = format_ == lvk::Format_RGBA_SRGB8 || format_ == lvk::Format_BGRA_SRGB8;
+    size_t level0Size = size_t(image_.width) * image_.height * 4;
+
+    lvk::TextureDesc desc = {
+        .type = lvk::TextureType_2D,
+        .format = format_,
+        .dimensions = {image_.width, image_.height, 1},
+        .usage = lvk::TextureUsageBits_Sampled,
+        .numMipLevels = lvk::calcNumMipLevels(image_.width, image_.height),
+        .data = image_.GetData(),
+        .generateMipmaps = true,
+        .debugName = asset_.path.c_str()
+    };
+    if (image_.encoding == ImageEncoding::BC7) {
+        // Cooked mip chain goes up as is; sRGB color data is decoded in the shader
+        desc.format = lvk::Format_BC7_RGBA;
+        desc.numMipLevels = image_.numMipLevels;
+        desc.dataNumMipLevels = image_.numMipLevels;
+        desc.generateMipmaps = false;
+        asset_.flags = srgb ? TextureFlagBits_DecodeSrgb : 0;
+        level0Size = size_t((image_.width + 3) / 4) * ((image_.height + 3) / 4) * 16;
+    }
+
+    asset_.texture = ctx->createTexture(desc);
+    if (!asset_.texture.valid()) {
+        std::cerr << "Failed to create texture: " << asset_.path << std::endl;
+        return false;
+    }
+    // A full mip chain adds a third on top of level 0
+    asset_.gpuMemorySize = desc.numMipLevels > 1 ? level0Size * 4 / 3 : level0Size;
+    return true;
+}
@@ -0,0 +1,224 @@
+#pragma once
+#include <assets/MeshImporter.h>
+#include <core/Task.h>
+#include <core/ThreadPool.h>
+#include <lvk/LVK.h>
+#include <renderer/GeometryArena.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// One submesh resident in the registry's GeometryArena. Draw offsets and index width (16-bit
+/// below 65536 vertices) come from GeometryArena::GetRange(geometry); the allocation holds the
+/// indices of every level of detail, so draws take their index range from GetLodRange().
+struct MeshBuffers {
+    GeometryAllocation geometry;
+    /// LOD 0 first, coarsest last; firstIndex is relative to the allocation's first index
+    std::array<MeshCacheLod, kMaxMeshLods> lods{};
+    uint32_t lodCount = 1;
+    /// Object-space AABB of the submesh
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    /// Object-space bounding sphere, used for per-submesh frustum tests
+    glm::vec3 sphereCenter = glm::vec3(0.0f);
+    float sphereRadius = 0.0f;
+    /// Vertex position decode: position * positionScale + positionOffset (identity for VertexLayout::Float)
+    glm::vec4 positionScale = glm::vec4(1.0f);
+    glm::vec4 positionOffset = glm::vec4(0.0f);
+    
+    // Make it movable but not copyable
+    MeshBuffers() = default;
+    MeshBuffers(const MeshBuffers&) = delete;
+    MeshBuffers& operator=(const MeshBuffers&) = delete;
+    MeshBuffers(MeshBuffers&&) = default;
+    MeshBuffers& operator=(MeshBuffers&&) = default;
+
+    /// range_ (from GeometryArena::GetRange(geometry)) narrowed to the indices of one level
+    [[nodiscard]] GeometryRange GetLodRange(const GeometryRange& range_, uint32_t lod_) const {
+        const MeshCacheLod& level = lods[std::min(lod_, lodCount - 1)];
+        GeometryRange lodRange = range_;
+        lodRange.firstIndex += level.firstIndex;
+        lodRange.indexCount = level.indexCount;
+        return lodRange;
+    }
+};
+
+enum class AssetState : uint8_t {
+    Loading,
+    Ready,
+    Failed,
+};
+
+/// GPU-resident model shared by every MeshComponent that references the same file.
+/// meshes is only filled in once state is Ready.
+struct MeshAsset {
+    std::string path;
+    std::vector<MeshBuffers> meshes;
+    /// Import-time optimization results over all submeshes, weighted by triangle count
+    MeshOptimizationStats optimizationStats{};
+    size_t gpuMemorySize = 0;
+    std::atomic<AssetState> state{AssetState::Loading};
+
+    [[nodiscard]] bool IsReady() const { return state.load(std::memory_order_acquire) == AssetState::Ready; }
+};
+
+/// Bits passed to shaders next to a texture index
+enum TextureFlagBits : uint32_t {
+    /// Texels hold sRGB-encoded values sampled through a UNORM view; the shader must decode them.
+    /// Set for block-compressed color textures, as there is no sRGB BC7 format to upload them with.
+    TextureFlagBits_DecodeSrgb = 1u << 0,
+};
+
+struct TextureAsset {
+    std::string path;
+    lvk::Holder<lvk::TextureHandle> texture;
+    uint32_t flags = 0;
+    size_t gpuMemorySize = 0;
+    std::atomic<AssetState> state{AssetState::Loading};
+
+    [[nodiscard]] bool IsReady() const { return state.load(std::memory_order_acquire) == AssetState::Ready; }
+};
+
+/// Ref-counted handles handed out by the registry. An asset stays resident while any
+/// handle is alive; once only the registry holds it, it becomes eligible for LRU eviction.
+using MeshRef = std::shared_ptr<const MeshAsset>;
+using TextureRef = std::shared_ptr<const TextureAsset>;
+
+struct AssetRegistryStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t failedLoads = 0;
+    size_t gpuMemoryUsage = 0;
+    uint32_t residentMeshes = 0;
+    uint32_t residentTextures = 0;
+    uint32_t pendingLoads = 0;
+};
+
+/// Deduplicates meshes and textures by normalized path plus import options, so the number of
+/// GPU copies grows with the number of unique assets rather than with the number of actors.
+///
+/// Loads are asynchronous: decoding/importing runs on a worker pool, and the GPU uploads are
+/// resumed on the render thread in batches by ProcessUploads(). Until an asset is ready the
+/// placeholder mesh/texture can be drawn instead.
+///
+/// Resolve() and ResolveFlags() may be called from any thread, as long as the caller holds the
+/// reference it passes (the game thread does, through MeshComponent): an asset's data is written
+/// before its state is published as Ready with release ordering, never changes afterwards, and
+/// a referenced asset is never evicted. Every other public method must be called from the render
+/// thread.
+class AssetRegistry {
+public:
+    static constexpr size_t kDefaultGpuMemoryBudget = size_t(512) * 1024 * 1024;
+    static constexpr uint32_t kDefaultUploadsPerFrame = 8;
+    /// Compact the geometry arena after evictions once free space is this splintered
+    static constexpr float kDefragmentThreshold = 0.5f;
+
+    /// Every mesh is uploaded in vertexLayout_; pipelines drawing them use GetVertexInput(GetVertexLayout())
+    explicit AssetRegistry(lvk::IContext* ctx_, size_t gpuMemoryBudget_ = kDefaultGpuMemoryBudget,
+                           VertexLayout vertexLayout_ = VertexLayout::Packed);
+    ~AssetRegistry();
+
+    AssetRegistry(const AssetRegistry&) = delete;
+    AssetRegistry& operator=(const AssetRegistry&) = delete;
+
+    /// Non-blocking: returns the shared asset right away (possibly still loading) and
+    /// starts a background load on a miss
+    MeshRef RequestMesh(const std::string& path_, uint32_t importFlags_ = kDefaultMeshImportFlags);
+    TextureRef RequestTexture(const std::string& path_, lvk::Format format_ = lvk::Format_RGBA_SRGB8);
+
+    /// co_await registry.LoadMeshAsync(path) resumes on the render thread once the mesh is
+    /// uploaded. Yields nullptr if the load failed.
+    Task<MeshRef> LoadMeshAsync(std::string path_, uint32_t importFlags_ = kDefaultMeshImportFlags);
+    Task<TextureRef> LoadTextureAsync(std::string path_, lvk::Format format_ = lvk::Format_RGBA_SRGB8);
+
+    /// Blocking variants, pumping uploads until the asset is ready. Yield nullptr on failure.
+    MeshRef LoadMesh(const std::string& path_, uint32_t importFlags_ = kDefaultMeshImportFlags);
+    TextureRef LoadTexture(const std::string& path_, lvk::Format format_ = lvk::Format_RGBA_SRGB8);
+
+    /// Runs at most maxUploads_ pending GPU uploads; call once per frame from the render thread
+    uint32_t ProcessUploads(uint32_t maxUploads_ = kDefaultUploadsPerFrame);
+    /// Blocks until every in-flight load has finished
+    void WaitIdle();
+
+    [[nodiscard]] VertexLayout GetVertexLayout() const { return vertexLayout; }
+    /// Holds the geometry of every mesh; bind it once per frame and draw with GetRange() offsets
+    [[nodiscard]] GeometryArena& GetGeometry() { return geometry; }
+    [[nodiscard]] const GeometryArena& GetGeometry() const { return geometry; }
+    [[nodiscard]] const MeshAsset& GetPlaceholderMesh() const { return *placeholderMesh; }
+    [[nodiscard]] lvk::TextureHandle GetPlaceholderTexture() const { return placeholderTexture; }
+    /// The asset's meshes/texture if ready, otherwise the placeholder
+    /// Safe from any thread (see the class comment)
+    [[nodiscard]] const std::vector<MeshBuffers>& Resolve(const MeshRef& mesh_) const;
+    [[nodiscard]] lvk::TextureHandle Resolve(const TextureRef& texture_) const;
+    /// TextureFlagBits matching the handle returned by Resolve(texture_)
+    [[nodiscard]] uint32_t ResolveFlags(const TextureRef& texture_) const;
+
+    /// Evicts least-recently-used assets nobody references until usage fits the budget
+    void CollectGarbage();
+    void SetGpuMemoryBudget(size_t budget_);
+    [[nodiscard]] size_t GetGpuMemoryBudget() const { return gpuMemoryBudget; }
+    [[nodiscard]] const AssetRegistryStats& GetStats() const { return stats; }
+    void LogStats() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<MeshAsset> mesh;
+        std::shared_ptr<TextureAsset> texture;
+        size_t gpuMemorySize = 0;
+        std::list<std::string>::iterator lruPosition;
+        /// Coroutines suspended in LoadMeshAsync/LoadTextureAsync until this entry is ready
+        std::vector<std::coroutine_handle<>> waiters;
+
+        [[nodiscard]] AssetState GetState() const {
+            return mesh ? mesh->state.load() : texture->state.load();
+        }
+        [[nodiscard]] bool IsReferenced() const {
+            return (mesh && mesh.use_count() > 1) || (texture && texture.use_count() > 1);
+        }
+    };
+
+    lvk::IContext* ctx;
+    size_t gpuMemoryBudget;
+    VertexLayout vertexLayout;
+    /// Declared before anything owning MeshBuffers so it outlives their allocations
+    GeometryArena geometry;
+    std::unordered_map<std::string, Entry> entries;
+    /// Most recently used key at the front
+    std::list<std::string> lru;
+    AssetRegistryStats stats;
+
+    ThreadPool workers;
+    TaskQueue uploads;
+
+    std::unique_ptr<MeshAsset> placeholderMesh;
+    lvk::Holder<lvk::TextureHandle> placeholderTexture;
+
+    static std::string NormalizePath(const std::string& path_);
+    static std::string MakeMeshKey(const std::string& path_, uint32_t importFlags_);
+    static std::string MakeTextureKey(const std::string& path_, lvk::Format format_);
+    Entry* FindEntry(const std::string& key_);
+    Entry& AddEntry(const std::string& key_, Entry&& entry_);
+    /// Suspends the caller until the entry for key_ leaves the Loading state
+    struct EntryAwaiter {
+        AssetRegistry* registry;
+        std::string key;
+        bool await_ready() const;
+        void await_suspend(std::coroutine_handle<> handle_) const;
+        void await_resume() const noexcept {}
+    };
+    void FinishLoad(const std::string& key_, size_t gpuMemorySize_, bool succeeded_);
+
+    Task<void> LoadMeshInBackground(std::string key_, std::string path_, uint32_t importFlags_, std::shared_ptr<MeshAsset> asset_);
+    Task<void> LoadTextureInBackground(std::string key_, std::string path_, lvk::Format format_, std::shared_ptr<TextureAsset> asset_);
+
+    void UploadMesh(MeshAsset& asset_, const MeshData& data_);
+    bool UploadTexture(TextureAsset& asset_, const struct ImageData& image_, lvk::Format format_);
+};
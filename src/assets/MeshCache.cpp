@@ -0,0 +1,183 @@
+#include <assets/MeshCache.h>
+#include <core/Hash.h>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+constexpr const char* kMeshCacheDirectory = "cache/meshes";
+constexpr uint64_t kBlobAlignment = 16;
+
+struct MeshCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash;
+    uint32_t importFlags;
+    uint32_t vertexStride;
+    uint32_t submeshCount;
+    uint32_t reserved;
+    uint64_t vertexDataOffset;
+    uint64_t vertexDataSize;
+    uint64_t indexDataOffset;
+    uint64_t indexDataSize;
+};
+
+static_assert(sizeof(MeshCacheHeader) == 64, "MeshCacheHeader layout is part of the file format");
+static_assert(sizeof(MeshCacheSubmesh) == 144, "MeshCacheSubmesh layout is part of the file format");
+
+uint64_t AlignUp(uint64_t value_, uint64_t alignment_) {
+    return (value_ + alignment_ - 1) & ~(alignment_ - 1);
+}
+
+/// Every level must lie inside the submesh's index run, which ends with the last level
+bool AreLodsInRange(const MeshCacheSubmesh& submesh_) {
+    if (submesh_.lodCount >= kMaxMeshLods) return false;
+    const uint64_t totalIndexCount = submesh_.GetTotalIndexCount();
+    for (uint32_t lod = 0; lod < submesh_.lodCount; lod++) {
+        if (submesh_.lods[lod].firstIndex < submesh_.indexCount ||
+            uint64_t(submesh_.lods[lod].firstIndex) + submesh_.lods[lod].indexCount > totalIndexCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool MeshCache::HashSourceFile(const std::string& sourcePath_, uint64_t& outHash_) {
+    MappedFile source;
+    if (!source.Open(sourcePath_)) {
+        return false;
+    }
+    outHash_ = HashBytes(source.GetData(), source.GetSize());
+    return true;
+}
+
+std::filesystem::path MeshCache::GetCachePath(const std::string& sourcePath_, uint64_t sourceHash_, uint32_t importFlags_, uint32_t vertexStride_) {
+    char key[64];
+    std::snprintf(key, sizeof(key), "-%016llx-%08x-%u.vkmesh", static_cast<unsigned long long>(sourceHash_), importFlags_, vertexStride_);
+    return std::filesystem::path(kMeshCacheDirectory) / (std::filesystem::path(sourcePath_).stem().string() + key);
+}
+
+bool MeshCache::Write(const std::filesystem::path& cachePath_, uint64_t sourceHash_, uint32_t importFlags_, const CookedMesh& mesh_) {
+    std::error_code ec;
+    std::filesystem::create_directories(cachePath_.parent_path(), ec);
+    if (ec) {
+        std::cerr << "Failed to create mesh cache directory: " << cachePath_.parent_path().string() << std::endl;
+        return false;
+    }
+
+    MeshCacheHeader header{};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.sourceHash = sourceHash_;
+    header.importFlags = importFlags_;
+    header.vertexStride = mesh_.vertexStride;
+    header.submeshCount = static_cast<uint32_t>(mesh_.submeshes.size());
+    header.vertexDataOffset = AlignUp(sizeof(MeshCacheHeader) + sizeof(MeshCacheSubmesh) * mesh_.submeshes.size(), kBlobAlignment);
+    header.vertexDataSize = mesh_.vertexData.size();
+    header.indexDataOffset = AlignUp(header.vertexDataOffset + header.vertexDataSize, kBlobAlignment);
+    header.indexDataSize = mesh_.indexData.size();
+
+    // Write to a temporary file first so a crash never leaves a truncated cache behind
+    std::filesystem::path tempPath = cachePath_;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Failed to open mesh cache for writing: " << tempPath.string() << std::endl;
+            return false;
+        }
+
+        const char padding[kBlobAlignment] = {};
+        auto padTo = [&](uint64_t offset) {
+            const auto current = static_cast<uint64_t>(out.tellp());
+            out.write(padding, static_cast<std::streamsize>(offset - current));
+        };
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(mesh_.submeshes.data()),
+                  static_cast<std::streamsize>(sizeof(MeshCacheSubmesh) * mesh_.submeshes.size()));
+        padTo(header.vertexDataOffset);
+        out.write(reinterpret_cast<const char*>(mesh_.vertexData.data()), static_cast<std::streamsize>(header.vertexDataSize));
+        padTo(header.indexDataOffset);
+        out.write(reinterpret_cast<const char*>(mesh_.indexData.data()), static_cast<std::streamsize>(header.indexDataSize));
+
+        if (!out.good()) {
+            std::cerr << "Failed to write mesh cache: " << tempPath.string() << std::endl;
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, cachePath_, ec);
+    if (ec) {
+        std::cerr << "Failed to finalize mesh cache: " << cachePath_.string() << std::endl;
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool MeshCache::Open(const std::filesystem::path& cachePath_, uint64_t sourceHash_, uint32_t importFlags_, uint32_t vertexStride_) {
+    Close();
+
+    if (!file.Open(cachePath_)) {
+        return false;
+    }
+
+    const uint8_t* base = file.GetData();
+    const size_t size = file.GetSize();
+    if (size < sizeof(MeshCacheHeader)) {
+        Close();
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const MeshCacheHeader*>(base);
+    if (header->magic != kMagic || header->version != kVersion ||
+        header->sourceHash != sourceHash_ || header->importFlags != importFlags_ ||
+        header->vertexStride != vertexStride_) {
+        Close();
+        return false;
+    }
+
+    const uint64_t submeshTableEnd = sizeof(MeshCacheHeader) + uint64_t(sizeof(MeshCacheSubmesh)) * header->submeshCount;
+    if (submeshTableEnd > size ||
+        header->vertexDataOffset + header->vertexDataSize > size ||
+        header->indexDataOffset + header->indexDataSize > size) {
+        std::cerr << "Mesh cache is truncated: " << cachePath_.string() << std::endl;
+        Close();
+        return false;
+    }
+
+    submeshes = reinterpret_cast<const MeshCacheSubmesh*>(base + sizeof(MeshCacheHeader));
+    vertexData = base + header->vertexDataOffset;
+    indexData = base + header->indexDataOffset;
+    submeshCount = header->submeshCount;
+    vertexStride = header->vertexStride;
+
+    const uint64_t numVertices = header->vertexDataSize / vertexStride;
+    for (uint32_t i = 0; i < submeshCount; i++) {
+        const MeshCacheSubmesh& submesh = submeshes[i];
+        if ((submesh.indexSize != 2 && submesh.indexSize != 4) || submesh.indexOffset % submesh.indexSize != 0 ||
+            !AreLodsInRange(submesh) ||
+            uint64_t(submesh.firstVertex) + submesh.vertexCount > numVertices ||
+            uint64_t(submesh.indexOffset) + uint64_t(submesh.GetTotalIndexCount()) * submesh.indexSize > header->indexDataSize) {
+            std::cerr << "Mesh cache has an out-of-range submesh: " << cachePath_.string() << std::endl;
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void MeshCache::Close() {
+    file.Close();
+    submeshes = nullptr;
+    vertexData = nullptr;
+    indexData = nullptr;
+    submeshCount = 0;
+    vertexStride = 0;
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <core/MappedFile.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/// Effect of the import-time optimization pass on one submesh (see MeshOptimizer.h).
+/// ACMR is post-transform cache misses per triangle, overdraw is shaded/covered pixels.
+struct MeshOptimizationStats {
+    uint32_t vertexCountBefore;
+    float acmrBefore;
+    float acmrAfter;
+    float overdrawBefore;
+    float overdrawAfter;
+};
+
+/// Levels of detail per submesh: the full-resolution LOD 0 plus up to kMaxMeshLods - 1 simplified ones
+constexpr uint32_t kMaxMeshLods = 6;
+
+/// One simplified level of a submesh. It indexes the same vertices as LOD 0, and its indices
+/// follow LOD 0's (and the previous levels') in the index blob at the same width.
+struct MeshCacheLod {
+    uint32_t firstIndex; // relative to the submesh's first index
+    uint32_t indexCount;
+    /// Object-space deviation from LOD 0's surface; never smaller than the previous level's
+    float error;
+};
+
+/// Range of one submesh inside the shared vertex/index blobs of a cooked mesh.
+/// Indices are local to the submesh and indexSize bytes wide (2 or 4).
+struct MeshCacheSubmesh {
+    uint32_t firstVertex;
+    uint32_t vertexCount;
+    uint32_t indexOffset; // bytes into the index blob
+    uint32_t indexCount;
+    uint32_t indexSize;
+    MeshOptimizationStats stats;
+    /// Object-space AABB; packed vertex positions are quantized relative to it
+    float boundsMin[3];
+    float boundsMax[3];
+    /// Object-space bounding sphere centred on the AABB, radius to the farthest vertex
+    float sphereCenter[3];
+    float sphereRadius;
+    /// Simplified levels in lods, coarsest last; indexCount above is LOD 0
+    uint32_t lodCount;
+    MeshCacheLod lods[kMaxMeshLods - 1];
+
+    /// Indices of LOD 0 and every simplified level, stored back to back from indexOffset
+    [[nodiscard]] uint32_t GetTotalIndexCount() const {
+        return lodCount > 0 ? lods[lodCount - 1].firstIndex + lods[lodCount - 1].indexCount : indexCount;
+    }
+};
+
+/// CPU-side result of a mesh import, laid out exactly as it is stored in the cache file.
+struct CookedMesh {
+    uint32_t vertexStride = 0;
+    std::vector<uint8_t> vertexData;
+    std::vector<uint8_t> indexData;
+    std::vector<MeshCacheSubmesh> submeshes;
+};
+
+/// Cooked binary mesh file written after the first Assimp import of a model.
+///
+/// Layout: MeshCacheHeader, MeshCacheSubmesh[submeshCount], vertex blob, index blob.
+/// Blobs are 16-byte aligned so the mapped pointers can be passed directly to createBuffer().
+/// The file name and the header both carry the source hash, the import flags and the vertex stride,
+/// so editing the source asset or changing the import options or vertex layout invalidates the cache.
+class MeshCache {
+public:
+    static constexpr uint32_t kMagic = 0x434d4b56; // "VKMC"
+    static constexpr uint32_t kVersion = 5;
+
+    /// Hashes the contents of the source asset (memory-mapped, no copy)
+    static bool HashSourceFile(const std::string& sourcePath_, uint64_t& outHash_);
+    static std::filesystem::path GetCachePath(const std::string& sourcePath_, uint64_t sourceHash_, uint32_t importFlags_, uint32_t vertexStride_);
+    static bool Write(const std::filesystem::path& cachePath_, uint64_t sourceHash_, uint32_t importFlags_, const CookedMesh& mesh_);
+
+    /// Maps a cache file and validates it against the expected key. Returns false on any mismatch.
+    bool Open(const std::filesystem::path& cachePath_, uint64_t sourceHash_, uint32_t importFlags_, uint32_t vertexStride_);
+    void Close();
+
+    [[nodiscard]] uint32_t GetSubmeshCount() const { return submeshCount; }
+    [[nodiscard]] const MeshCacheSubmesh& GetSubmesh(uint32_t index_) const { return submeshes[index_]; }
+    [[nodiscard]] uint32_t GetVertexStride() const { return vertexStride; }
+    [[nodiscard]] const uint8_t* GetVertexData() const { return vertexData; }
+    [[nodiscard]] const uint8_t* GetIndexData() const { return indexData; }
+
+private:
+    MappedFile file;
+    const MeshCacheSubmesh* submeshes = nullptr;
+    const uint8_t* vertexData = nullptr;
+    const uint8_t* indexData = nullptr;
+    uint32_t submeshCount = 0;
+    uint32_t vertexStride = 0;
+};
@@ -0,0 +1,199 @@
+#include <assets/MeshImporter.h>
+#include <assets/MeshOptimizer.h>
+#include <core/Profiler.h>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <assimp/cimport.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+const uint32_t kDefaultMeshImportFlags =
+    aiProcess_Triangulate |
+    aiProcess_FlipUVs |
+    aiProcess_GenNormals |
+    aiProcess_CalcTangentSpace;
+
+namespace {
+
+bool ImportModel(const std::string& modelPath_, uint32_t importFlags_, CookedMesh& outMesh_) {
+    const aiScene* scene = aiImportFile(modelPath_.c_str(), importFlags_);
+    
+    if (!scene) {
+        std::cerr << "Failed to load model: " << modelPath_ << std::endl;
+        std::cerr << "Assimp error: " << aiGetErrorString() << std::endl;
+        return false;
+    }
+    
+    std::cout << "Model loaded successfully. Meshes: " << scene->mNumMeshes << std::endl;
+    
+    if (!scene->HasMeshes()) {
+        std::cerr << "No meshes found in model: " << modelPath_ << std::endl;
+        aiReleaseImport(scene);
+        return false;
+    }
+
+    // Size the blobs up front so the extraction below never reallocates
+    size_t totalVertices = 0;
+    size_t totalIndices = 0;
+    for (size_t mi = 0; mi < scene->mNumMeshes; ++mi) {
+        if (scene->mMeshes[mi]->HasPositions()) {
+            totalVertices += scene->mMeshes[mi]->mNumVertices;
+            totalIndices += size_t(scene->mMeshes[mi]->mNumFaces) * 3;
+        }
+    }
+
+    outMesh_.vertexStride = sizeof(Vertex);
+    outMesh_.vertexData.resize(totalVertices * sizeof(Vertex));
+    outMesh_.indexData.resize(totalIndices * sizeof(uint32_t));
+    outMesh_.submeshes.reserve(scene->mNumMeshes);
+
+    auto* vertices = reinterpret_cast<Vertex*>(outMesh_.vertexData.data());
+    uint32_t firstVertex = 0;
+    uint32_t firstIndex = 0;
+
+    for (size_t mi = 0; mi < scene->mNumMeshes; ++mi) {
+        const aiMesh* mesh = scene->mMeshes[mi];
+        if (!mesh->HasPositions()) {
+            std::cerr << "Skipping mesh " << mi << ": mesh has no positions" << std::endl;
+            continue;
+        }
+
+        const bool hasNormals = mesh->HasNormals();
+        const bool hasTexCoords = mesh->HasTextureCoords(0);
+
+        // Extract vertex data
+        for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
+            Vertex& vertex = vertices[firstVertex + i];
+
+            // Position
+            const aiVector3D pos = mesh->mVertices[i];
+            vertex.position = glm::vec3(pos.x, pos.y, pos.z);
+
+            // Normal
+            if (hasNormals) {
+                const aiVector3D norm = mesh->mNormals[i];
+                vertex.normal = glm::vec3(norm.x, norm.y, norm.z);
+            } else {
+                vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f); // Default up normal
+            }
+
+            // Texture coordinates
+            if (hasTexCoords) {
+                const aiVector3D tex = mesh->mTextureCoords[0][i];
+                vertex.texCoord = glm::vec2(tex.x, tex.y);
+            } else {
+                vertex.texCoord = glm::vec2(0.0f, 0.0f); // Default UV
+            }
+        }
+
+        // Extract indices (local to the submesh); OptimizeMesh narrows them later
+        auto* indices = reinterpret_cast<uint32_t*>(outMesh_.indexData.data()) + firstIndex;
+        for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+            for (int j = 0; j < 3; j++) {
+                indices[i * 3 + j] = mesh->mFaces[i].mIndices[j];
+            }
+        }
+
+        const uint32_t indexCount = mesh->mNumFaces * 3;
+        outMesh_.submeshes.push_back({firstVertex, mesh->mNumVertices, firstIndex * uint32_t(sizeof(uint32_t)), indexCount, sizeof(uint32_t), {}, {}, {}});
+        firstVertex += mesh->mNumVertices;
+        firstIndex += indexCount;
+    }
+    
+    aiReleaseImport(scene);
+    return true;
+}
+
+} // namespace
+
+void BuildPlaceholderMesh(VertexLayout layout_, CookedMesh& outMesh_) {
+    const glm::vec3 faceNormals[6] = {
+        { 1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f},
+        { 0.0f, 1.0f, 0.0f}, { 0.0f,-1.0f, 0.0f},
+        { 0.0f, 0.0f, 1.0f}, { 0.0f, 0.0f,-1.0f},
+    };
+
+    outMesh_.vertexStride = sizeof(Vertex);
+    outMesh_.vertexData.resize(24 * sizeof(Vertex));
+    outMesh_.indexData.resize(36 * sizeof(uint16_t));
+    auto* indices = reinterpret_cast<uint16_t*>(outMesh_.indexData.data());
+    auto* vertices = reinterpret_cast<Vertex*>(outMesh_.vertexData.data());
+
+    for (uint32_t face = 0; face < 6; face++) {
+        const glm::vec3 n = faceNormals[face];
+        // Two axes spanning the face, chosen so the winding is counter-clockwise seen from outside
+        const glm::vec3 u = glm::vec3(n.y, n.z, n.x);
+        const glm::vec3 v = glm::cross(n, u);
+        const glm::vec2 corners[4] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+        for (uint32_t c = 0; c < 4; c++) {
+            Vertex& vertex = vertices[face * 4 + c];
+            vertex.position = (n + u * corners[c].x + v * corners[c].y) * 0.5f;
+            vertex.normal = n;
+            vertex.texCoord = glm::vec2(corners[c].x, corners[c].y) * 0.5f + 0.5f;
+        }
+        const uint16_t base = static_cast<uint16_t>(face * 4);
+        const uint16_t faceIndices[6] = {base, uint16_t(base + 1), uint16_t(base + 2), uint16_t(base + 2), uint16_t(base + 3), base};
+        std::copy(faceIndices, faceIndices + 6, indices + face * 6);
+    }
+
+    // Unit cube: the sphere reaches the corners
+    outMesh_.submeshes = {{0, 24, 0, 36, sizeof(uint16_t), {}, {-0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}, {0.0f, 0.0f, 0.0f}, 0.8660254f}};
+    if (layout_ == VertexLayout::Packed) {
+        QuantizeMesh(outMesh_);
+    }
+}
+
+uint32_t MeshData::GetSubmeshCount() const {
+    return fromCache ? cache.GetSubmeshCount() : static_cast<uint32_t>(cooked.submeshes.size());
+}
+
+const MeshCacheSubmesh& MeshData::GetSubmesh(uint32_t index_) const {
+    return fromCache ? cache.GetSubmesh(index_) : cooked.submeshes[index_];
+}
+
+uint32_t MeshData::GetVertexStride() const {
+    return fromCache ? cache.GetVertexStride() : cooked.vertexStride;
+}
+
+const uint8_t* MeshData::GetVertexData() const {
+    return fromCache ? cache.GetVertexData() : cooked.vertexData.data();
+}
+
+const uint8_t* MeshData::GetIndexData() const {
+    return fromCache ? cache.GetIndexData() : cooked.indexData.data();
+}
+
+bool LoadMeshData(const std::string& modelPath_, uint32_t importFlags_, VertexLayout layout_, MeshData& outData_) {
+    VKENGINE_PROFILE_ZONE("Import mesh");
+    // Try the cooked mesh cache first: a valid cache skips Assimp entirely and the
+    // mapped vertex/index blobs are uploaded without any intermediate copy
+    uint64_t sourceHash = 0;
+    if (!MeshCache::HashSourceFile(modelPath_, sourceHash)) {
+        std::cerr << "Failed to read model: " << modelPath_ << std::endl;
+        return false;
+    }
+    const uint32_t vertexStride = GetVertexStride(layout_);
+    const std::filesystem::path cachePath = MeshCache::GetCachePath(modelPath_, sourceHash, importFlags_, vertexStride);
+
+    if (outData_.cache.Open(cachePath, sourceHash, importFlags_, vertexStride)) {
+        std::cout << "Model loaded from mesh cache: " << cachePath.string() << ". Meshes: " << outData_.cache.GetSubmeshCount() << std::endl;
+        outData_.fromCache = true;
+        return true;
+    }
+
+    if (!ImportModel(modelPath_, importFlags_, outData_.cooked)) {
+        return false;
+    }
+    OptimizeMesh(outData_.cooked);
+    if (layout_ == VertexLayout::Packed) {
+        QuantizeMesh(outData_.cooked);
+    }
+    outData_.fromCache = false;
+
+    if (!MeshCache::Write(cachePath, sourceHash, importFlags_, outData_.cooked)) {
+        std::cerr << "Failed to write mesh cache for: " << modelPath_ << std::endl;
+    }
+    return true;
+}
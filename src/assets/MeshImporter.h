@@ -0,0 +1,30 @@
+#pragma once
+#include <assets/MeshCache.h>
+#include <assets/Vertex.h>
+#include <cstdint>
+#include <string>
+
+/// Assimp post-processing flags used for every model unless the caller asks otherwise
+extern const uint32_t kDefaultMeshImportFlags;
+
+/// CPU-side mesh data ready for upload. Backed either by a memory-mapped cache file
+/// or by a fresh Assimp import; callers only see the blob accessors.
+struct MeshData {
+    MeshCache cache;
+    CookedMesh cooked;
+    bool fromCache = false;
+
+    [[nodiscard]] uint32_t GetSubmeshCount() const;
+    [[nodiscard]] const MeshCacheSubmesh& GetSubmesh(uint32_t index_) const;
+    [[nodiscard]] uint32_t GetVertexStride() const;
+    [[nodiscard]] const uint8_t* GetVertexData() const;
+    [[nodiscard]] const uint8_t* GetIndexData() const;
+};
+
+/// Builds a unit cube in the given vertex layout, shown while the real mesh is still loading
+void BuildPlaceholderMesh(VertexLayout layout_, CookedMesh& outMesh_);
+
+/// Loads a model through the mesh cache. On a miss the model is imported with Assimp,
+/// optimized (OptimizeMesh), converted to the requested vertex layout and written back to the cache.
+/// Touches no GPU state.
+bool LoadMeshData(const std::string& modelPath_, uint32_t importFlags_, VertexLayout layout_, MeshData& outData_);
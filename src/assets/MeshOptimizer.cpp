@@ -0,0 +1,198 @@
+#include <assets/MeshOptimizer.h>
+#include <assets/Vertex.h>
+#include <meshoptimizer.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+/// Post-transform cache size assumed for ACMR; 16 is a fair stand-in for modern GPUs
+constexpr unsigned int kVertexCacheSize = 16;
+/// Allow up to 5% more cache misses in exchange for less overdraw
+constexpr float kOverdrawThreshold = 1.05f;
+
+/// Each LOD aims for this fraction of the previous level's triangles
+constexpr float kLodReduction = 0.5f;
+/// No level goes below this many triangles; smaller meshes get fewer levels
+constexpr size_t kMinLodTriangles = 64;
+/// A level must drop at least this fraction of the previous level's triangles to be kept
+constexpr float kMinLodSavings = 0.1f;
+/// Largest deviation any level may have, relative to the mesh extent
+constexpr float kMaxLodError = 0.1f;
+/// Weights of normal xyz and uv against position in the simplification error
+constexpr float kLodAttributeWeights[5] = {0.5f, 0.5f, 0.5f, 1.0f, 1.0f};
+
+/// Simplifies LOD 0 into up to kMaxMeshLods - 1 coarser levels by quadric edge collapse. On full
+/// vertices the normals and UVs are part of the error, so shading and seams survive. Every level
+/// is simplified from LOD 0, not from its predecessor, so errors do not accumulate. The levels'
+/// indices are appended to outIndices_, and their counts and object-space errors go to outLods_.
+uint32_t BuildLods(const std::vector<unsigned int>& indices_, const uint8_t* vertices_, size_t vertexCount_, size_t stride_,
+                   std::vector<unsigned int>& outIndices_, MeshCacheLod* outLods_) {
+    const auto* positions = reinterpret_cast<const float*>(vertices_);
+    // Normal and texCoord follow each other, so they form one attribute stream
+    const bool hasAttributes = stride_ == sizeof(Vertex);
+    const float* attributes = positions + offsetof(Vertex, normal) / sizeof(float);
+    const float errorScale = meshopt_simplifyScale(positions, vertexCount_, stride_);
+
+    std::vector<unsigned int> lod(indices_.size());
+    size_t previousCount = indices_.size();
+    float previousError = 0.0f;
+    uint32_t lodCount = 0;
+    while (lodCount < kMaxMeshLods - 1) {
+        const size_t targetCount = size_t(float(previousCount) * kLodReduction) / 3 * 3;
+        if (targetCount < kMinLodTriangles * 3) break;
+
+        float error = 0.0f;
+        const size_t count = hasAttributes
+            ? meshopt_simplifyWithAttributes(lod.data(), indices_.data(), indices_.size(), positions, vertexCount_, stride_,
+                                             attributes, stride_, kLodAttributeWeights, std::size(kLodAttributeWeights),
+                                             nullptr, targetCount, kMaxLodError, 0, &error)
+            : meshopt_simplify(lod.data(), indices_.data(), indices_.size(), positions, vertexCount_, stride_,
+                               targetCount, kMaxLodError, 0, &error);
+        // Stuck on the error bound or the topology: coarser targets would give the same result
+        if (count == 0 || float(count) > float(previousCount) * (1.0f - kMinLodSavings)) break;
+        meshopt_optimizeVertexCache(lod.data(), lod.data(), count, vertexCount_);
+
+        previousError = std::max(previousError, error * errorScale);
+        outLods_[lodCount++] = {
+            static_cast<uint32_t>(indices_.size() + outIndices_.size()),
+            static_cast<uint32_t>(count),
+            previousError,
+        };
+        outIndices_.insert(outIndices_.end(), lod.begin(), lod.begin() + count);
+        previousCount = count;
+    }
+    return lodCount;
+}
+
+} // namespace
+
+void OptimizeMesh(CookedMesh& mesh_) {
+    const size_t stride = mesh_.vertexStride;
+    std::vector<uint8_t> vertexData;
+    std::vector<uint8_t> indexData;
+    vertexData.reserve(mesh_.vertexData.size());
+    indexData.reserve(mesh_.indexData.size());
+
+    std::vector<unsigned int> remap;
+    std::vector<unsigned int> indices;
+    std::vector<unsigned int> lodIndices;
+    std::vector<uint8_t> vertices;
+
+    for (size_t mi = 0; mi < mesh_.submeshes.size(); ++mi) {
+        MeshCacheSubmesh& submesh = mesh_.submeshes[mi];
+        const uint8_t* srcVertices = mesh_.vertexData.data() + size_t(submesh.firstVertex) * stride;
+        const auto* srcIndices = reinterpret_cast<const unsigned int*>(mesh_.indexData.data() + submesh.indexOffset);
+        const size_t indexCount = submesh.indexCount;
+        const size_t vertexCount = submesh.vertexCount;
+
+        MeshOptimizationStats& stats = submesh.stats;
+        stats.vertexCountBefore = submesh.vertexCount;
+        stats.acmrBefore = meshopt_analyzeVertexCache(srcIndices, indexCount, vertexCount, kVertexCacheSize, 0, 0).acmr;
+        stats.overdrawBefore = meshopt_analyzeOverdraw(srcIndices, indexCount, reinterpret_cast<const float*>(srcVertices), vertexCount, stride).overdraw;
+
+        // Weld vertices that are bitwise identical (Assimp splits them per face corner)
+        remap.resize(vertexCount);
+        const size_t uniqueCount = meshopt_generateVertexRemap(remap.data(), srcIndices, indexCount, srcVertices, vertexCount, stride);
+        indices.resize(indexCount);
+        vertices.resize(uniqueCount * stride);
+        meshopt_remapIndexBuffer(indices.data(), srcIndices, indexCount, remap.data());
+        meshopt_remapVertexBuffer(vertices.data(), srcVertices, vertexCount, stride, remap.data());
+
+        // Order matters: cache first, overdraw works on top of it, fetch last as it only renames vertices
+        meshopt_optimizeVertexCache(indices.data(), indices.data(), indexCount, uniqueCount);
+        meshopt_optimizeOverdraw(indices.data(), indices.data(), indexCount, reinterpret_cast<const float*>(vertices.data()), uniqueCount, stride, kOverdrawThreshold);
+
+        const size_t firstVertex = vertexData.size() / stride;
+        vertexData.resize((firstVertex + uniqueCount) * stride);
+        uint8_t* dstVertices = vertexData.data() + firstVertex * stride;
+        const size_t finalCount = meshopt_optimizeVertexFetch(dstVertices, indices.data(), indexCount, vertices.data(), uniqueCount, stride);
+        vertexData.resize((firstVertex + finalCount) * stride);
+
+        stats.acmrAfter = meshopt_analyzeVertexCache(indices.data(), indexCount, finalCount, kVertexCacheSize, 0, 0).acmr;
+        stats.overdrawAfter = meshopt_analyzeOverdraw(indices.data(), indexCount, reinterpret_cast<const float*>(dstVertices), finalCount, stride).overdraw;
+
+        glm::vec3 boundsMin(finalCount > 0 ? FLT_MAX : 0.0f);
+        glm::vec3 boundsMax(finalCount > 0 ? -FLT_MAX : 0.0f);
+        for (size_t v = 0; v < finalCount; ++v) {
+            glm::vec3 position;
+            std::memcpy(&position, dstVertices + v * stride, sizeof(position));
+            boundsMin = glm::min(boundsMin, position);
+            boundsMax = glm::max(boundsMax, position);
+        }
+        std::memcpy(submesh.boundsMin, &boundsMin, sizeof(submesh.boundsMin));
+        std::memcpy(submesh.boundsMax, &boundsMax, sizeof(submesh.boundsMax));
+
+        // Centred on the box but sized by the farthest vertex, which is tighter than the half diagonal
+        const glm::vec3 sphereCenter = (boundsMin + boundsMax) * 0.5f;
+        float sphereRadiusSquared = 0.0f;
+        for (size_t v = 0; v < finalCount; ++v) {
+            glm::vec3 position;
+            std::memcpy(&position, dstVertices + v * stride, sizeof(position));
+            const glm::vec3 offset = position - sphereCenter;
+            sphereRadiusSquared = std::max(sphereRadiusSquared, glm::dot(offset, offset));
+        }
+        std::memcpy(submesh.sphereCenter, &sphereCenter, sizeof(submesh.sphereCenter));
+        submesh.sphereRadius = std::sqrt(sphereRadiusSquared);
+
+        // Simplified levels are stored right after LOD 0 and share its vertices
+        lodIndices.clear();
+        submesh.lodCount = BuildLods(indices, dstVertices, finalCount, stride, lodIndices, submesh.lods);
+        indices.insert(indices.end(), lodIndices.begin(), lodIndices.end());
+        const size_t totalIndexCount = indices.size();
+
+        // Keep every submesh's indices 4-byte aligned so either width can be uploaded straight from the blob
+        submesh.firstVertex = static_cast<uint32_t>(firstVertex);
+        submesh.vertexCount = static_cast<uint32_t>(finalCount);
+        submesh.indexSize = finalCount < 65536 ? sizeof(uint16_t) : sizeof(uint32_t);
+        submesh.indexOffset = static_cast<uint32_t>((indexData.size() + 3) & ~size_t(3));
+        indexData.resize(submesh.indexOffset + totalIndexCount * submesh.indexSize);
+        if (submesh.indexSize == sizeof(uint16_t)) {
+            auto* dst = reinterpret_cast<uint16_t*>(indexData.data() + submesh.indexOffset);
+            for (size_t i = 0; i < totalIndexCount; ++i) {
+                dst[i] = static_cast<uint16_t>(indices[i]);
+            }
+        } else {
+            std::memcpy(indexData.data() + submesh.indexOffset, indices.data(), totalIndexCount * sizeof(uint32_t));
+        }
+
+        std::cout << "Optimized mesh " << mi << ": " << stats.vertexCountBefore << " -> " << submesh.vertexCount << " vertices, ACMR "
+                  << stats.acmrBefore << " -> " << stats.acmrAfter << ", overdraw " << stats.overdrawBefore << " -> " << stats.overdrawAfter
+                  << ", " << submesh.indexSize * 8 << "-bit indices, " << submesh.lodCount << " LODs";
+        for (uint32_t lod = 0; lod < submesh.lodCount; ++lod) {
+            std::cout << (lod == 0 ? " (" : ", ") << submesh.lods[lod].indexCount / 3;
+        }
+        std::cout << (submesh.lodCount > 0 ? " triangles)" : "") << std::endl;
+    }
+
+    mesh_.vertexData = std::move(vertexData);
+    mesh_.indexData = std::move(indexData);
+}
+
+void QuantizeMesh(CookedMesh& mesh_) {
+    if (mesh_.vertexStride != sizeof(Vertex)) {
+        std::cerr << "QuantizeMesh expects full-precision vertices, got stride " << mesh_.vertexStride << std::endl;
+        return;
+    }
+
+    const size_t vertexCount = mesh_.vertexData.size() / sizeof(Vertex);
+    const auto* vertices = reinterpret_cast<const Vertex*>(mesh_.vertexData.data());
+    std::vector<uint8_t> packedData(vertexCount * sizeof(PackedVertex));
+    auto* packed = reinterpret_cast<PackedVertex*>(packedData.data());
+
+    for (const MeshCacheSubmesh& submesh : mesh_.submeshes) {
+        const glm::vec3 boundsMin(submesh.boundsMin[0], submesh.boundsMin[1], submesh.boundsMin[2]);
+        const glm::vec3 boundsMax(submesh.boundsMax[0], submesh.boundsMax[1], submesh.boundsMax[2]);
+        for (uint32_t v = submesh.firstVertex; v < submesh.firstVertex + submesh.vertexCount; ++v) {
+            packed[v] = PackVertex(vertices[v], boundsMin, boundsMax);
+        }
+    }
+
+    mesh_.vertexStride = sizeof(PackedVertex);
+    mesh_.vertexData = std::move(packedData);
+}
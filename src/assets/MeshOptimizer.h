@@ -0,0 +1,16 @@
+#pragma once
+#include <assets/MeshCache.h>
+
+/// Import-time optimization of every submesh of a freshly imported mesh (meshoptimizer):
+/// welds duplicate vertices, reorders triangles for the post-transform cache and then for
+/// overdraw, reorders vertices for fetch locality, and narrows indices to 16 bits whenever
+/// a submesh has fewer than 65536 vertices. It then generates simplified levels of detail that
+/// share the submesh's vertices (see MeshCacheLod). Before/after statistics, the submesh bounds
+/// and the LOD table land in each submesh.
+///
+/// Expects 32-bit indices and a float3 position at the start of every vertex.
+void OptimizeMesh(CookedMesh& mesh_);
+
+/// Rewrites a mesh of Vertex into PackedVertex, quantizing positions against each submesh's bounds.
+/// Runs after OptimizeMesh, which computes those bounds.
+void QuantizeMesh(CookedMesh& mesh_);
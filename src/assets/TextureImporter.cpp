@@ -0,0 +1,112 @@
+#include <assets/TextureImporter.h>
+#include <core/MappedFile.h>
+#include <core/Profiler.h>
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#include <filesystem>
+#include <iostream>
+
+#if defined(VKENGINE_WITH_KTX)
+#include <ktx.h>
+#include <vulkan/vulkan_core.h>
+#endif
+
+std::string GetCookedTexturePath(const std::string& fileName_) {
+    return std::filesystem::path(fileName_).replace_extension(".ktx2").string();
+}
+
+namespace {
+
+#if defined(VKENGINE_WITH_KTX)
+/// A cooked file only wins while it is at least as new as its source image
+bool IsCookedTextureCurrent(const std::string& fileName_, const std::string& cookedPath_) {
+    std::error_code ec;
+    const auto cookedTime = std::filesystem::last_write_time(cookedPath_, ec);
+    if (ec) return false;
+    const auto sourceTime = std::filesystem::last_write_time(fileName_, ec);
+    if (ec) return true; // source not shipped, the cooked file is all we have
+    if (cookedTime < sourceTime) {
+        std::cout << "Cooked texture is stale, run TextureCooker: " << cookedPath_ << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool LoadCookedImageData(const std::string& cookedPath_, ImageData& outImage_) {
+    MappedFile file;
+    if (!file.Open(cookedPath_)) {
+        return false;
+    }
+
+    ktxTexture2* texture = nullptr;
+    KTX_error_code result = ktxTexture2_CreateFromMemory(file.GetData(), file.GetSize(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &texture);
+    if (result != KTX_SUCCESS) {
+        std::cerr << "Failed to read KTX2 texture: " << cookedPath_ << " (" << ktxErrorString(result) << ")" << std::endl;
+        return false;
+    }
+
+    // Supercompressed (UASTC/ETC1S) files are transcoded here; TextureCooker already writes BC7
+    if (ktxTexture2_NeedsTranscoding(texture)) {
+        result = ktxTexture2_TranscodeBasis(texture, KTX_TTF_BC7_RGBA, 0);
+        if (result != KTX_SUCCESS) {
+            std::cerr << "Failed to transcode KTX2 texture: " << cookedPath_ << " (" << ktxErrorString(result) << ")" << std::endl;
+            ktxTexture_Destroy(ktxTexture(texture));
+            return false;
+        }
+    }
+
+    if (texture->vkFormat != VK_FORMAT_BC7_UNORM_BLOCK && texture->vkFormat != VK_FORMAT_BC7_SRGB_BLOCK) {
+        std::cerr << "Unsupported KTX2 format " << texture->vkFormat << ": " << cookedPath_ << std::endl;
+        ktxTexture_Destroy(ktxTexture(texture));
+        return false;
+    }
+
+    // KTX2 stores the smallest level first; the upload wants level 0 first, tightly packed
+    ktxTexture* base = ktxTexture(texture);
+    const ktx_uint8_t* data = ktxTexture_GetData(base);
+    outImage_.blocks.clear();
+    outImage_.blocks.reserve(ktxTexture_GetDataSize(base));
+    for (uint32_t level = 0; level < texture->numLevels; ++level) {
+        ktx_size_t offset = 0;
+        ktxTexture_GetImageOffset(base, level, 0, 0, &offset);
+        const ktx_size_t size = ktxTexture_GetImageSize(base, level);
+        outImage_.blocks.insert(outImage_.blocks.end(), data + offset, data + offset + size);
+    }
+
+    outImage_.width = texture->baseWidth;
+    outImage_.height = texture->baseHeight;
+    outImage_.numMipLevels = texture->numLevels;
+    outImage_.encoding = ImageEncoding::BC7;
+    ktxTexture_Destroy(base);
+    return true;
+}
+#endif
+
+} // namespace
+
+bool LoadImageData(const std::string& fileName_, ImageData& outImage_) {
+    VKENGINE_PROFILE_ZONE("Decode image");
+#if defined(VKENGINE_WITH_KTX)
+    const std::string cookedPath = GetCookedTexturePath(fileName_);
+    if (cookedPath == fileName_) {
+        return LoadCookedImageData(cookedPath, outImage_);
+    }
+    if (IsCookedTextureCurrent(fileName_, cookedPath) && LoadCookedImageData(cookedPath, outImage_)) {
+        return true;
+    }
+#endif
+
+    int width, height, channels;
+    unsigned char* data = stbi_load(fileName_.c_str(), &width, &height, &channels, 4); // Force RGBA
+    if (!data) {
+        std::cerr << "Failed to load texture: " << fileName_ << std::endl;
+        return false;
+    }
+
+    outImage_.width = static_cast<uint32_t>(width);
+    outImage_.height = static_cast<uint32_t>(height);
+    outImage_.numMipLevels = 1;
+    outImage_.encoding = ImageEncoding::RGBA8;
+    outImage_.pixels = {data, stbi_image_free};
+    return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class ImageEncoding : uint8_t {
+    RGBA8, // uncompressed, level 0 only; mips are generated on upload
+    BC7,   // block compressed mip chain cooked offline by TextureCooker
+};
+
+/// Decoded image, ready for upload
+struct ImageData {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t numMipLevels = 1;
+    ImageEncoding encoding = ImageEncoding::RGBA8;
+    /// RGBA8 texels of level 0 (ImageEncoding::RGBA8)
+    std::unique_ptr<uint8_t, void (*)(void*)> pixels{nullptr, nullptr};
+    /// Tightly packed BC7 blocks, level 0 first (ImageEncoding::BC7)
+    std::vector<uint8_t> blocks;
+
+    [[nodiscard]] const void* GetData() const { return encoding == ImageEncoding::BC7 ? static_cast<const void*>(blocks.data()) : pixels.get(); }
+};
+
+/// Path of the cooked KTX2 file that replaces an authored image: same directory and stem, .ktx2 extension
+std::string GetCookedTexturePath(const std::string& fileName_);
+
+/// Decodes an image file. A cooked KTX2 sibling that is at least as new as the source
+/// is preferred; otherwise the source is decoded into RGBA8. Touches no GPU state.
+bool LoadImageData(const std::string& fileName_, ImageData& outImage_);
@@ -0,0 +1,45 @@
+#include <assets/Vertex.h>
+#include <glm/gtc/packing.hpp>
+#include <cmath>
+
+namespace {
+
+uint16_t QuantizeUnorm16(float value_) {
+    return static_cast<uint16_t>(std::lround(glm::clamp(value_, 0.0f, 1.0f) * 65535.0f));
+}
+
+int16_t QuantizeSnorm16(float value_) {
+    return static_cast<int16_t>(std::lround(glm::clamp(value_, -1.0f, 1.0f) * 32767.0f));
+}
+
+/// Octahedral mapping of a unit vector onto [-1, 1]^2 (decoded in blinn_phong.vert)
+glm::vec2 EncodeOctahedral(glm::vec3 n_) {
+    n_ /= std::abs(n_.x) + std::abs(n_.y) + std::abs(n_.z);
+    glm::vec2 p(n_.x, n_.y);
+    if (n_.z < 0.0f) {
+        p = glm::vec2((1.0f - std::abs(n_.y)) * (n_.x >= 0.0f ? 1.0f : -1.0f),
+                      (1.0f - std::abs(n_.x)) * (n_.y >= 0.0f ? 1.0f : -1.0f));
+    }
+    return p;
+}
+
+} // namespace
+
+PackedVertex PackVertex(const Vertex& vertex_, const glm::vec3& boundsMin_, const glm::vec3& boundsMax_) {
+    const glm::vec3 extent = boundsMax_ - boundsMin_;
+    const glm::vec3 relative = vertex_.position - boundsMin_;
+
+    PackedVertex out{};
+    for (int i = 0; i < 3; i++) {
+        out.position[i] = extent[i] > 0.0f ? QuantizeUnorm16(relative[i] / extent[i]) : 0;
+    }
+
+    const float length = glm::length(vertex_.normal);
+    const glm::vec2 octahedral = length > 0.0f ? EncodeOctahedral(vertex_.normal / length) : glm::vec2(0.0f);
+    out.normal[0] = QuantizeSnorm16(octahedral.x);
+    out.normal[1] = QuantizeSnorm16(octahedral.y);
+
+    out.texCoord[0] = glm::packHalf1x16(vertex_.texCoord.x);
+    out.texCoord[1] = glm::packHalf1x16(vertex_.texCoord.y);
+    return out;
+}
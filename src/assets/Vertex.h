@@ -0,0 +1,60 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <lvk/LVK.h>
+#include <cstdint>
+
+/// Full-precision vertex (32 bytes). Produced by the importer and used for optimization;
+/// also the GPU layout when VertexLayout::Float is selected.
+struct Vertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+};
+
+/// Quantized vertex (16 bytes):
+/// - position: unorm16 relative to the submesh bounds, dequantized with MeshBuffers::positionScale/positionOffset
+/// - normal: octahedral encoding in snorm16
+/// - texCoord: half floats
+struct PackedVertex {
+    uint16_t position[4]; // w is padding, keeps the attribute 8-byte aligned
+    int16_t normal[2];
+    uint16_t texCoord[2];
+};
+
+static_assert(sizeof(Vertex) == 32, "Vertex layout is part of the mesh cache format");
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex layout is part of the mesh cache format");
+
+enum class VertexLayout : uint8_t {
+    Float,
+    Packed,
+};
+
+inline uint32_t GetVertexStride(VertexLayout layout_) {
+    return layout_ == VertexLayout::Packed ? sizeof(PackedVertex) : sizeof(Vertex);
+}
+
+/// Vertex input for blinn_phong.vert. Both layouts feed the same shader inputs; the shader
+/// decodes normals according to its kPackedVertices specialization constant.
+inline lvk::VertexInput GetVertexInput(VertexLayout layout_) {
+    if (layout_ == VertexLayout::Packed) {
+        return {
+            .attributes = {
+                { .location = 0, .format = lvk::VertexFormat::UShort4Norm, .offset = offsetof(PackedVertex, position) },
+                { .location = 1, .format = lvk::VertexFormat::Short2Norm, .offset = offsetof(PackedVertex, normal) },
+                { .location = 2, .format = lvk::VertexFormat::HalfFloat2, .offset = offsetof(PackedVertex, texCoord) }
+            },
+            .inputBindings = { { .stride = sizeof(PackedVertex) } },
+        };
+    }
+    return {
+        .attributes = {
+            { .location = 0, .format = lvk::VertexFormat::Float3, .offset = offsetof(Vertex, position) },
+            { .location = 1, .format = lvk::VertexFormat::Float3, .offset = offsetof(Vertex, normal) },
+            { .location = 2, .format = lvk::VertexFormat::Float2, .offset = offsetof(Vertex, texCoord) }
+        },
+        .inputBindings = { { .stride = sizeof(Vertex) } },
+    };
+}
+
+/// Converts a Vertex into its packed form; bounds are the submesh AABB the position is quantized against
+PackedVertex PackVertex(const Vertex& vertex_, const glm::vec3& boundsMin_, const glm::vec3& boundsMax_);
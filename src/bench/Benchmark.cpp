@@ -0,0 +1,303 @@
+#include <bench/Benchmark.h>
+#include <assets/AssetRegistry.h>
+#include <components/MeshComponent.h>
+#include <components/TransformComponent.h>
+#include <glm/gtc/constants.hpp>
+#include <lvk/vulkan/VulkanClasses.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <span>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+constexpr float kInstanceSpacing = 0.75f;
+
+void PrintUsage() {
+    std::cerr << "Usage: VulkanEngine [--bench [--instances N] [--frames N] [--warmup N] [--size WxH]\n"
+                 "                    [--mesh PATH] [--texture PATH] [--output PATH] [--seed N]]" << std::endl;
+}
+
+bool ParseUint(const char* text_, uint32_t& outValue_) {
+    const char* end = text_ + std::strlen(text_);
+    const auto [ptr, error] = std::from_chars(text_, end, outValue_);
+    return error == std::errc() && ptr == end;
+}
+
+/// Small deterministic generator; the standard distributions differ between library implementations
+class Random {
+public:
+    explicit Random(uint32_t seed_) : state(seed_ * 747796405u + 2891336453u) {}
+
+    /// Uniform in [0, 1)
+    float Next() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+    }
+
+private:
+    uint32_t state;
+};
+
+struct Percentiles {
+    float mean = 0.0f;
+    float p50 = 0.0f;
+    float p90 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+};
+
+Percentiles GetPercentiles(std::vector<float> values_) {
+    Percentiles result;
+    if (values_.empty()) return result;
+    std::sort(values_.begin(), values_.end());
+    // Nearest rank
+    auto at = [&](float percentile_) {
+        const size_t rank = static_cast<size_t>(std::ceil(percentile_ / 100.0f * static_cast<float>(values_.size())));
+        return values_[std::clamp<size_t>(rank, 1, values_.size()) - 1];
+    };
+    double sum = 0.0;
+    for (const float value : values_) sum += value;
+    result.mean = static_cast<float>(sum / static_cast<double>(values_.size()));
+    result.p50 = at(50.0f);
+    result.p90 = at(90.0f);
+    result.p95 = at(95.0f);
+    result.p99 = at(99.0f);
+    result.max = values_.back();
+    return result;
+}
+
+void WriteJsonString(std::ostream& out_, const std::string& text_) {
+    out_ << '"';
+    for (const char c : text_) {
+        if (c == '"' || c == '\\') out_ << '\\';
+        out_ << c;
+    }
+    out_ << '"';
+}
+
+void WritePercentiles(std::ostream& out_, const char* name_, const std::vector<float>& values_, bool last_ = false) {
+    const Percentiles p = GetPercentiles(values_);
+    out_ << "  \"" << name_ << "\": { \"samples\": " << values_.size() << ", \"mean\": " << p.mean << ", \"p50\": " << p.p50
+         << ", \"p90\": " << p.p90 << ", \"p95\": " << p.p95 << ", \"p99\": " << p.p99 << ", \"max\": " << p.max << " }"
+         << (last_ ? "\n" : ",\n");
+}
+}
+
+bool ParseBenchmarkOptions(int argc_, char* argv_[], BenchmarkOptions& outOptions_) {
+    for (int i = 1; i < argc_; ++i) {
+        const std::string_view arg = argv_[i];
+        const char* value = i + 1 < argc_ ? argv_[i + 1] : nullptr;
+        bool valid = true;
+        if (arg == "--bench") {
+            outOptions_.enabled = true;
+            continue;
+        } else if (!value) {
+            valid = false;
+        } else if (arg == "--instances") {
+            valid = ParseUint(value, outOptions_.instances);
+        } else if (arg == "--frames") {
+            valid = ParseUint(value, outOptions_.frames) && outOptions_.frames > 0;
+        } else if (arg == "--warmup") {
+            valid = ParseUint(value, outOptions_.warmupFrames);
+        } else if (arg == "--size") {
+            const std::string_view size = value;
+            const size_t separator = size.find('x');
+            valid = separator != std::string_view::npos &&
+                    ParseUint(std::string(size.substr(0, separator)).c_str(), outOptions_.width) &&
+                    ParseUint(std::string(size.substr(separator + 1)).c_str(), outOptions_.height) &&
+                    outOptions_.width > 0 && outOptions_.height > 0;
+        } else if (arg == "--mesh") {
+            outOptions_.mesh = value;
+        } else if (arg == "--texture") {
+            outOptions_.texture = value;
+        } else if (arg == "--output") {
+            outOptions_.output = value;
+        } else if (arg == "--seed") {
+            valid = ParseUint(value, outOptions_.seed);
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            std::cerr << "Invalid option: " << arg << std::endl;
+            PrintUsage();
+            return false;
+        }
+        ++i;
+    }
+    return true;
+}
+
+std::unique_ptr<lvk::IContext> CreateHeadlessContext(const lvk::ContextConfig& config_, std::string& outDeviceName_) {
+    // No window and no display: the context has no surface and therefore no swapchain
+    auto ctx = std::make_unique<lvk::VulkanContext>(config_, nullptr);
+    for (const lvk::HWDeviceType type : { lvk::HWDeviceType_Discrete, lvk::HWDeviceType_Integrated, lvk::HWDeviceType_Software }) {
+        std::vector<lvk::HWDeviceDesc> devices;
+        if (!ctx->queryDevices(type, devices).isOk() || devices.empty()) continue;
+        if (!ctx->initContext(devices.front()).isOk()) {
+            std::cerr << "Failed to initialize Vulkan device: " << devices.front().name << std::endl;
+            return nullptr;
+        }
+        outDeviceName_ = devices.front().name;
+        return ctx;
+    }
+    std::cerr << "No Vulkan device found" << std::endl;
+    return nullptr;
+}
+
+StressScene CreateStressScene(Pool<Actor>& actors_, AssetRegistry* assets_, const BenchmarkOptions& options_) {
+    StressScene scene;
+    const uint32_t side = std::max(1u, static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(options_.instances)))));
+    scene.extent = static_cast<float>(side) * kInstanceSpacing * 0.5f;
+    scene.actors.resize(options_.instances);
+    actors_.CreateMany(std::span(scene.actors));
+
+    Random random(options_.seed);
+    // Upright like the demo skulls, each turned to its own heading
+    const glm::quat upright = glm::angleAxis(glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    for (uint32_t i = 0; i < options_.instances; ++i) {
+        const float jitterX = (random.Next() - 0.5f) * kInstanceSpacing * 0.5f;
+        const float jitterZ = (random.Next() - 0.5f) * kInstanceSpacing * 0.5f;
+        const float heading = random.Next() * glm::two_pi<float>();
+        const glm::vec3 position = {
+            (static_cast<float>(i % side) + 0.5f) * kInstanceSpacing - scene.extent + jitterX,
+            0.0f,
+            (static_cast<float>(i / side) + 0.5f) * kInstanceSpacing - scene.extent + jitterZ,
+        };
+
+        Actor* actor = actors_.Get(scene.actors[i]);
+        actor->AddComponent<TransformComponent>(actor, position,
+                                                glm::angleAxis(heading, glm::vec3(0.0f, 1.0f, 0.0f)) * upright,
+                                                glm::vec3(1.0f));
+        actor->AddComponent<MeshComponent>(actor, assets_, options_.mesh, options_.texture);
+        if (!actor->OnCreate()) {
+            std::cerr << "Failed to create stress scene instance " << i << std::endl;
+        }
+    }
+    return scene;
+}
+
+CameraSpline::CameraSpline(std::vector<glm::vec3> points_) : points(std::move(points_)) {
+}
+
+CameraSpline CameraSpline::MakeFlyover(const StressScene& scene_, uint32_t seed_) {
+    constexpr uint32_t kPointCount = 8;
+    const float extent = std::max(scene_.extent, 1.0f);
+    Random random(seed_ ^ 0x9e3779b9u);
+    std::vector<glm::vec3> points;
+    for (uint32_t i = 0; i < kPointCount; ++i) {
+        const float angle = (static_cast<float>(i) + random.Next() * 0.5f) / kPointCount * glm::two_pi<float>();
+        const bool wide = i % 2 == 0;
+        const float radius = wide ? extent * (1.4f + random.Next() * 0.4f) : extent * (0.2f + random.Next() * 0.3f);
+        const float height = wide ? extent * (0.6f + random.Next() * 0.4f) : 0.75f + random.Next() * 0.5f;
+        points.push_back(scene_.center + glm::vec3(std::cos(angle) * radius, height, std::sin(angle) * radius));
+    }
+    return CameraSpline(std::move(points));
+}
+
+glm::vec3 CameraSpline::Evaluate(float t_) const {
+    const size_t count = points.size();
+    const float position = std::clamp(t_, 0.0f, 1.0f) * static_cast<float>(count);
+    const size_t segment = std::min(static_cast<size_t>(position), count - 1);
+    const float u = position - static_cast<float>(segment);
+    const glm::vec3& p0 = points[(segment + count - 1) % count];
+    const glm::vec3& p1 = points[segment];
+    const glm::vec3& p2 = points[(segment + 1) % count];
+    const glm::vec3& p3 = points[(segment + 2) % count];
+    const float u2 = u * u;
+    const float u3 = u2 * u;
+    return 0.5f * (2.0f * p1 + (p2 - p0) * u + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * u2 +
+                   (3.0f * p1 - p0 - 3.0f * p2 + p3) * u3);
+}
+
+uint64_t GetPeakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters = {};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+void BenchmarkRecorder::AddFrame(const BenchmarkFrame& frame_) {
+    frames.push_back(frame_);
+}
+
+void BenchmarkRecorder::AddGpuFrame(float ms_) {
+    gpuMs.push_back(ms_);
+}
+
+bool BenchmarkRecorder::WriteJson(const std::string& path_, const BenchmarkOptions& options_, const std::string& deviceName_,
+                                  const BenchmarkMemory& memory_) const {
+    const std::filesystem::path path(path_);
+    if (path.has_parent_path()) {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to write benchmark results: " << path_ << std::endl;
+        return false;
+    }
+
+    auto collect = [&](auto member_) {
+        std::vector<float> values;
+        values.reserve(frames.size());
+        for (const BenchmarkFrame& frame : frames) values.push_back(static_cast<float>(frame.*member_));
+        return values;
+    };
+
+    out << "{\n  \"device\": ";
+    WriteJsonString(out, deviceName_);
+    out << ",\n  \"mesh\": ";
+    WriteJsonString(out, options_.mesh);
+    out << ",\n  \"instances\": " << options_.instances << ",\n  \"width\": " << options_.width << ",\n  \"height\": "
+        << options_.height << ",\n  \"frames\": " << frames.size() << ",\n  \"warmupFrames\": " << options_.warmupFrames
+        << ",\n  \"seed\": " << options_.seed << ",\n";
+    WritePercentiles(out, "cpuFrameMs", collect(&BenchmarkFrame::cpuMs));
+    WritePercentiles(out, "renderMs", collect(&BenchmarkFrame::renderMs));
+    WritePercentiles(out, "simulationMs", collect(&BenchmarkFrame::simulationMs));
+    WritePercentiles(out, "gpuFrameMs", gpuMs);
+    WritePercentiles(out, "visibleMeshes", collect(&BenchmarkFrame::visibleMeshes));
+    WritePercentiles(out, "instances", collect(&BenchmarkFrame::instances));
+    WritePercentiles(out, "drawCommands", collect(&BenchmarkFrame::drawCommands));
+    WritePercentiles(out, "drawCalls", collect(&BenchmarkFrame::drawCalls));
+    out << "  \"memory\": { \"assetGpuBytes\": " << memory_.assetGpuBytes << ", \"geometryArenaBytes\": "
+        << memory_.geometryArenaBytes << ", \"peakResidentBytes\": " << memory_.peakResidentBytes << " }\n}\n";
+    return static_cast<bool>(out);
+}
+
+void BenchmarkRecorder::PrintSummary(std::ostream& out_) const {
+    std::vector<float> cpuMs;
+    for (const BenchmarkFrame& frame : frames) cpuMs.push_back(frame.cpuMs);
+    const Percentiles cpu = GetPercentiles(cpuMs);
+    const Percentiles gpu = GetPercentiles(gpuMs);
+    out_ << "Benchmark: " << frames.size() << " frames, CPU p50 " << cpu.p50 << " ms, p99 " << cpu.p99 << " ms; GPU p50 "
+         << gpu.p50 << " ms, p99 " << gpu.p99 << " ms" << std::endl;
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <components/Actor.h>
+#include <core/Pool.h>
+#include <glm/glm.hpp>
+#include <lvk/LVK.h>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class AssetRegistry;
+
+/// Command line of the headless benchmark, `VulkanEngine --bench [options]`
+struct BenchmarkOptions {
+    bool enabled = false;
+    /// Instances of the mesh in the stress scene, on top of the two demo skulls
+    uint32_t instances = 1000;
+    /// Frames measured, after warmupFrames that are rendered but not recorded
+    uint32_t frames = 600;
+    uint32_t warmupFrames = 60;
+    uint32_t width = 1920;
+    uint32_t height = 1080;
+    std::string mesh = "assets/skull/source/skull.fbx";
+    std::string texture = "assets/skull/textures/skullColor.png";
+    std::string output = "bench.json";
+    /// Seeds the scene layout and the camera path
+    uint32_t seed = 1;
+};
+
+/// Fills outOptions_ from argv; false (after printing the usage) on an unknown or malformed option
+bool ParseBenchmarkOptions(int argc_, char* argv_[], BenchmarkOptions& outOptions_);
+
+/// Context without a window or swapchain on the first discrete, integrated or software device,
+/// so the benchmark also runs on CPU implementations such as lavapipe; nullptr if there is none
+std::unique_ptr<lvk::IContext> CreateHeadlessContext(const lvk::ContextConfig& config_, std::string& outDeviceName_);
+
+/// Stress scene placed by CreateStressScene()
+struct StressScene {
+    std::vector<Handle<Actor>> actors;
+    glm::vec3 center = glm::vec3(0.0f);
+    /// Half the width of the square the instances cover
+    float extent = 0.0f;
+};
+
+/// Spreads options_.instances actors of the benchmark mesh over a square grid, with a jitter
+/// and rotation from options_.seed. Every instance requests the same asset, so the registry
+/// loads it once and the GPU-driven path draws them as one instanced mesh.
+StressScene CreateStressScene(Pool<Actor>& actors_, AssetRegistry* assets_, const BenchmarkOptions& options_);
+
+/// Closed Catmull-Rom spline the benchmark camera follows, so every run sees the same frames
+class CameraSpline {
+public:
+    explicit CameraSpline(std::vector<glm::vec3> points_);
+
+    /// Loop around and across the scene: control points alternate between a wide orbit high
+    /// above it and close passes over it
+    static CameraSpline MakeFlyover(const StressScene& scene_, uint32_t seed_);
+
+    /// Position at t_ in [0, 1], one lap over the whole range
+    [[nodiscard]] glm::vec3 Evaluate(float t_) const;
+
+private:
+    std::vector<glm::vec3> points;
+};
+
+/// What one measured frame did
+struct BenchmarkFrame {
+    /// Wall time from the start of the previous frame to the start of this one
+    float cpuMs;
+    /// Declaring, recording and submitting the frame on the render thread
+    float renderMs;
+    /// Producing the frame's snapshot on the game thread
+    float simulationMs;
+    uint32_t visibleMeshes;
+    uint32_t instances;
+    uint32_t drawCommands;
+    /// Draw or multi-draw-indirect calls recorded
+    uint32_t drawCalls;
+};
+
+struct BenchmarkMemory {
+    uint64_t assetGpuBytes = 0;
+    uint64_t geometryArenaBytes = 0;
+    uint64_t peakResidentBytes = 0;
+};
+
+/// Peak resident set size of the process, 0 where it is unknown
+uint64_t GetPeakResidentBytes();
+
+/// Frame times and counts of a benchmark run, summarized as percentiles
+class BenchmarkRecorder {
+public:
+    void AddFrame(const BenchmarkFrame& frame_);
+    /// GPU times arrive a few frames late, from GpuProfiler
+    void AddGpuFrame(float ms_);
+
+    /// Writes the summary as JSON; false if the file could not be written
+    bool WriteJson(const std::string& path_, const BenchmarkOptions& options_, const std::string& deviceName_,
+                   const BenchmarkMemory& memory_) const;
+    void PrintSummary(std::ostream& out_) const;
+
+private:
+    std::vector<BenchmarkFrame> frames;
+    std::vector<float> gpuMs;
+};
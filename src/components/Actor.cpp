@@ -5,68 +5,82 @@
 #include <components/Actor.h>
 #include <iostream>
 #include <components/TransformComponent.h>
+#include <components/TransformHierarchy.h>
 
 bool Actor::OnCreate() {
     if (isCreated) return true;
-    std::cout << "Loading assets for Actor: " << __FILE__ << ":" << __LINE__ << std::endl;
-    for (const auto& component : components) {
-        if (component->OnCreate() == false) {
+    bool created = true;
+    world->ForEachComponent(entity, [&](BaseComponent* component) {
+        if (created && component->OnCreate() == false) {
             std::cerr << "Loading assets for Actor/Components: " << __FILE__ << ":" << __LINE__ << std::endl;
-            isCreated = false;
-            return isCreated;
+            created = false;
         }
+    });
+    isCreated = created;
+
+    // Register with the world's transform cache under the parent actor, if any
+    TransformHierarchy* hierarchy = world->GetSystem<TransformHierarchy>();
+    if (isCreated && hierarchy) {
+        const Actor* parentActor = dynamic_cast<Actor*>(parent);
+        hierarchy->Add(entity, parentActor ? parentActor->GetEntity() : Entity{});
     }
-    isCreated = true;
     return isCreated;
 }
 
 Actor::~Actor() {
     Actor::OnDestroy();
+    world->DestroyEntity(entity);
 }
 
 void Actor::OnDestroy() {
-    std::cout << "Deleting assets for Actor: " << __FILE__ << ":" << __LINE__ << std::endl;
     RemoveAllComponents();
     isCreated = false;
 }
 
 void Actor::Update(const float deltaTime) {
-    for (BaseComponent* component : components) {
+    world->ForEachComponent(entity, [&](BaseComponent* component) {
         component->Update(deltaTime);
-    }
+    });
 }
 
 void Actor::Render() const {
-    for (BaseComponent* component : components) {
+    world->ForEachComponent(entity, [](const BaseComponent* component) {
         component->Render();
-    }
+    });
 }
 
 void Actor::RemoveAllComponents() {
-    // First destroy all components
-    for (auto* component : components) {
-        if (component) {
-            component->OnDestroy();
-        }
+    // Leave the transform cache before the TransformComponent goes away
+    if (const TransformComponent* transform = GetComponent<TransformComponent>(); transform && transform->GetHierarchy()) {
+        transform->GetHierarchy()->Remove(entity);
     }
+
+    // First destroy all components
+    world->ForEachComponent(entity, [](BaseComponent* component) {
+        component->OnDestroy();
+    });
     
-    // Then delete and clear
-    for (auto* component : components) {
-        delete component;
-    }
-    components.clear();
+    // Then drop them from the entity
+    world->RemoveAllComponents(entity);
 }
 
 void Actor::ListComponents() {
     std::cout << typeid(*this).name() << " contains the following components:\n";
-    for (const auto& component : components) {
+    world->ForEachComponent(entity, [](BaseComponent* component) {
         std::cout << typeid(*component).name() << std::endl;
-    }
+    });
     std::cout << '\n';
 }
 
 glm::mat4 Actor::GetModelMatrix() {
     TransformComponent* transform = GetComponent<TransformComponent>();
+    if (transform && transform->GetHierarchy()) {
+        // Cached world matrix, parents already applied
+        TransformHierarchy* hierarchy = transform->GetHierarchy();
+        hierarchy->Update();
+        modelMatrix = hierarchy->GetWorldMatrix(transform->GetHierarchyNode());
+        return modelMatrix;
+    }
     if (transform) {
         modelMatrix = transform->GetTransformMatrix();
     } else {
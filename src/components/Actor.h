@@ -7,11 +7,15 @@
 #define GLM_ENABLE_EXPERIMENTAL
 
 #include <components/BaseComponent.h>
+#include <ecs/World.h>
 #include <glm/glm.hpp>
-#include <vector>
 
+/// Compatibility handle over an ECS entity: components are stored by value in the World's
+/// archetype columns, and the AddComponent/GetComponent API forwards to it.
+/// GetComponent matches the exact component type.
 class Actor : public BaseComponent {
-    std::vector<BaseComponent*> components;
+    World* world;
+    Entity entity;
 
 protected:
     glm::mat4 modelMatrix;
@@ -22,9 +26,10 @@ public:
     Actor &operator=(const Actor &) = delete;
     Actor &operator=(Actor &&) = delete;
 
-    Actor(BaseComponent *parent_): BaseComponent(parent_) {}
+    explicit Actor(BaseComponent *parent_, World* world_ = &World::GetDefault())
+        : BaseComponent(parent_), world(world_), entity(world_->CreateEntity()) {}
 
-    Actor(): BaseComponent(nullptr) {}
+    Actor(): Actor(nullptr) {}
 
     bool OnCreate() override;
     ~Actor() override;
@@ -34,33 +39,25 @@ public:
 
     template<typename ComponentTemplate, typename... Args>
     void AddComponent(Args &&... args_) {
-        auto *componentObject = new ComponentTemplate(std::forward<Args>(args_)...);
-        components.push_back(componentObject);
+        world->AddComponent<ComponentTemplate>(entity, std::forward<Args>(args_)...);
     }
 
     template<typename ComponentTemplate>
     ComponentTemplate* GetComponent() {
-        for (BaseComponent* component: components) {
-            if (dynamic_cast<ComponentTemplate*>(component) != nullptr) {
-                return dynamic_cast<ComponentTemplate*>(component);
-            }
-        }
-        return nullptr;
+        return world->GetComponent<ComponentTemplate>(entity);
     }
 
     template<typename ComponentTemplate>
     void RemoveComponent() {
-        for (size_t i = 0; i < components.size(); i++) {
-            if (dynamic_cast<ComponentTemplate *>(components[i]) != nullptr) {
-                components[i]->OnDestroy();
-                delete components[i];
-                components.erase(components.begin() + i);
-                break;
-            }
+        if (ComponentTemplate* component = GetComponent<ComponentTemplate>()) {
+            component->OnDestroy();
+            world->RemoveComponent<ComponentTemplate>(entity);
         }
     }
 
     glm::mat4 GetModelMatrix();
+    [[nodiscard]] World* GetWorld() const { return world; }
+    [[nodiscard]] Entity GetEntity() const { return entity; }
 
     void ListComponents();
     void RemoveAllComponents();
@@ -58,10 +58,6 @@ void CameraComponent::OnDestroy() {
 }
 
 void CameraComponent::Update(float deltaTime_) {
-    static int updateCount = 0;
-    if (++updateCount % 60 == 0) {
-        std::cout << "Camera Update called, deltaTime: " << deltaTime_ << std::endl;
-    }
     // HandleInput is now called separately in main.cpp with window parameter
     // No need to call HandleInput here anymore
 }
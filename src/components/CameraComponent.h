@@ -32,6 +32,8 @@ public:
     glm::vec3 GetPosition() const { return position; }
     glm::vec3 GetTarget() const { return target; }
     glm::vec3 GetUp() const { return up; }
+    /// Vertical field of view in degrees
+    float GetFovY() const { return fovy; }
     
     // Input handling
     void HandleInput(float deltaTime);
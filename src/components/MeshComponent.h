@@ -4,45 +4,38 @@
 
 #pragma once
 #include <components/BaseComponent.h>
-#include <lvk/LVK.h>
-#include <glm/glm.hpp>
+#include <assets/AssetRegistry.h>
 #include <vector>
 #include <string>
-#include <assimp/scene.h>
-
-struct MeshBuffers {
-    lvk::Holder<lvk::BufferHandle> vertexBuffer;
-    lvk::Holder<lvk::BufferHandle> indexBuffer;
-    uint32_t indexCount;
-    
-    // Make it movable but not copyable
-    MeshBuffers() = default;
-    MeshBuffers(const MeshBuffers&) = delete;
-    MeshBuffers& operator=(const MeshBuffers&) = delete;
-    MeshBuffers(MeshBuffers&&) = default;
-    MeshBuffers& operator=(MeshBuffers&&) = default;
-};
 
 class MeshComponent : public BaseComponent {
 public:
-    MeshComponent(BaseComponent* parent_, lvk::IContext* ctx_, const std::string& modelPath_);
+    MeshComponent(BaseComponent* parent_, AssetRegistry* registry_, const std::string& modelPath_, const std::string& texturePath_ = {});
     ~MeshComponent() override;
+    /// Declared because the destructor suppresses the implicit ones; archetype moves relocate
+    /// components, which should steal the paths and references rather than copy them
+    MeshComponent(const MeshComponent&) = default;
+    MeshComponent(MeshComponent&&) noexcept = default;
     
     bool OnCreate() override;
     void OnDestroy() override;
     void Update(float deltaTime_) override;
     void Render() const override;
     
-    const std::vector<MeshBuffers>& GetMeshes() const { return meshes; }
-    const lvk::Holder<lvk::TextureHandle>& GetTexture() const { return texture; }
+    /// The model's meshes, or the registry placeholder while the model is still loading
+    const std::vector<MeshBuffers>& GetMeshes() const;
+    /// The texture, or the registry placeholder while it is still loading
+    lvk::TextureHandle GetTextureHandle() const;
+    /// TextureFlagBits for the handle returned by GetTextureHandle()
+    uint32_t GetTextureFlags() const;
+    const MeshRef& GetMesh() const { return mesh; }
+    const TextureRef& GetTexture() const { return texture; }
+    bool IsLoaded() const;
     
 private:
-    lvk::IContext* ctx;
+    AssetRegistry* registry;
     std::string modelPath;
-    std::vector<MeshBuffers> meshes;
-    lvk::Holder<lvk::TextureHandle> texture;
-    
-    bool LoadModel();
-    MeshBuffers UploadMesh(const aiMesh* mesh);
-    lvk::Holder<lvk::TextureHandle> LoadTexture(const char* fileName);
+    std::string texturePath;
+    MeshRef mesh;
+    TextureRef texture;
 };
@@ -3,6 +3,7 @@
 //
 
 #include <components/TransformComponent.h>
+#include <components/TransformHierarchy.h>
 
 TransformComponent::TransformComponent(BaseComponent* parent_): BaseComponent(parent_) {
     pos = glm::vec3(0.0f, 0.0f, 0.0f);
@@ -30,6 +31,14 @@ void TransformComponent::Update(const float deltaTime) {
 
 void TransformComponent::Render() const {}
 
+void TransformComponent::MarkDirty() {
+    if (dirty) return;
+    dirty = true;
+    if (hierarchy) {
+        hierarchy->MarkDirty(hierarchyNode);
+    }
+}
+
 glm::mat4 TransformComponent::GetTransformMatrix() const {
     // 1. Create a matrix that handles only local scale and rotation
     //    (Order: Scale then Rotate on the vertex)
@@ -6,6 +6,9 @@
 #include <components/BaseComponent.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+
+class TransformHierarchy;
 
 class TransformComponent final : public BaseComponent {
 public:
@@ -20,19 +23,35 @@ public:
     [[nodiscard]] glm::vec3 GetPosition() const { return pos; }
     [[nodiscard]] glm::vec3 GetScale() const { return scale; }
     [[nodiscard]] glm::quat GetQuaternion() const { return orientation; }
+    /// Local TRS matrix; the world matrix comes from the TransformHierarchy
     [[nodiscard]] glm::mat4 GetTransformMatrix() const;
     void SetTransform(const glm::vec3 pos_, const glm::quat orientation_, const glm::vec3 scale_ = glm::vec3(1.0f, 1.0f, 1.0f) ) {
         pos = pos_;
         orientation = orientation_;
         scale = scale_;
+        MarkDirty();
     }
 
-    void SetPosition(const glm::vec3& newPos) { pos = newPos; }
-    void SetScale(const glm::vec3& newScale) { scale = newScale; }
-    void SetRotation(const glm::quat& newRotation) { orientation = newRotation; }
+    void SetPosition(const glm::vec3& newPos) { pos = newPos; MarkDirty(); }
+    void SetScale(const glm::vec3& newScale) { scale = newScale; MarkDirty(); }
+    void SetRotation(const glm::quat& newRotation) { orientation = newRotation; MarkDirty(); }
+
+    /// The hierarchy caching this transform's world matrix, or nullptr if not registered
+    [[nodiscard]] TransformHierarchy* GetHierarchy() const { return hierarchy; }
+    /// Index of the world matrix in the hierarchy; changes when nodes are added or removed
+    [[nodiscard]] uint32_t GetHierarchyNode() const { return hierarchyNode; }
 
 private:
+    friend class TransformHierarchy;
+
+    /// Queues the node for the next TransformHierarchy::Update(); repeated calls are free
+    void MarkDirty();
+
     glm::vec3 pos{};
     glm::vec3 scale{};
     glm::quat orientation{};
+
+    TransformHierarchy* hierarchy = nullptr;
+    uint32_t hierarchyNode = UINT32_MAX;
+    bool dirty = false;
 };
@@ -0,0 +1,266 @@
+#include <components/TransformHierarchy.h>
+#include <components/TransformComponent.h>
+#include <algorithm>
+
+TransformHierarchy::TransformHierarchy(World& world_) : world(world_) {
+}
+
+TransformHierarchy::~TransformHierarchy() {
+    for (Entity entity : entities) {
+        if (TransformComponent* transform = world.GetComponent<TransformComponent>(entity)) {
+            transform->hierarchy = nullptr;
+            transform->hierarchyNode = kInvalidNode;
+        }
+    }
+}
+
+void TransformHierarchy::Add(Entity entity_, Entity parent_) {
+    TransformComponent* transform = world.GetComponent<TransformComponent>(entity_);
+    if (!transform || transform->hierarchy) return;
+
+    uint32_t parentNode = kInvalidNode;
+    const TransformComponent* parentTransform = world.GetComponent<TransformComponent>(parent_);
+    if (parentTransform && parentTransform->hierarchy == this) {
+        parentNode = parentTransform->hierarchyNode;
+    }
+
+    // Children go at the end of their parent's subtree, roots at the end of the array
+    const uint32_t node = parentNode != kInvalidNode ? parentNode + subtreeSizes[parentNode] : GetNodeCount();
+    for (uint32_t ancestor = parentNode; ancestor != kInvalidNode; ancestor = parents[ancestor]) {
+        subtreeSizes[ancestor]++;
+    }
+
+    if (node == GetNodeCount()) {
+        // Appending shifts nothing, so only the new node itself changes
+        entities.push_back(entity_);
+        parents.push_back(parentNode);
+        subtreeSizes.push_back(1);
+        localMatrices.push_back(glm::mat4(1.0f));
+        worldMatrices.push_back(glm::mat4(1.0f));
+    } else {
+        // Parents always precede their children, so only nodes from here on can point past it
+        for (uint32_t i = node; i < GetNodeCount(); ++i) {
+            if (parents[i] != kInvalidNode && parents[i] >= node) parents[i]++;
+        }
+        for (uint32_t& dirty : dirtyNodes) {
+            if (dirty >= node) dirty++;
+        }
+        entities.insert(entities.begin() + node, entity_);
+        parents.insert(parents.begin() + node, parentNode);
+        subtreeSizes.insert(subtreeSizes.begin() + node, 1);
+        localMatrices.insert(localMatrices.begin() + node, glm::mat4(1.0f));
+        worldMatrices.insert(worldMatrices.begin() + node, glm::mat4(1.0f));
+        RenumberFrom(node + 1);
+        MarkChangedFrom(node);
+    }
+
+    transform->hierarchy = this;
+    transform->hierarchyNode = node;
+    transform->dirty = false;
+    transform->MarkDirty();
+}
+
+void TransformHierarchy::Remove(Entity entity_) {
+    TransformComponent* transform = world.GetComponent<TransformComponent>(entity_);
+    if (!transform || transform->hierarchy != this) return;
+
+    const uint32_t node = transform->hierarchyNode;
+    transform->hierarchy = nullptr;
+    transform->hierarchyNode = kInvalidNode;
+    transform->dirty = false;
+
+    const uint32_t subtreeEnd = node + subtreeSizes[node];
+    if (subtreeSizes[node] == 1 || parents[node] == kInvalidNode) {
+        // Leaves and roots leave a tombstone behind, so no other node moves. A root's direct
+        // children become roots where they are, their subtrees already being contiguous.
+        for (uint32_t child = node + 1; child < subtreeEnd; child += subtreeSizes[child]) {
+            parents[child] = kInvalidNode;
+            if (TransformComponent* childTransform = world.GetComponent<TransformComponent>(entities[child])) {
+                childTransform->MarkDirty();
+            }
+        }
+        entities[node] = {};
+        subtreeSizes[node] = 1;
+        deadNodes++;
+        PopDeadTail();
+        return;
+    }
+
+    // An inner node's children become roots, so their subtrees move out of its ancestors'
+    // ranges to the end of the array. Rare enough to renumber everything after it.
+    for (uint32_t child = node + 1; child < subtreeEnd; child += subtreeSizes[child]) {
+        parents[child] = kInvalidNode;
+        if (TransformComponent* childTransform = world.GetComponent<TransformComponent>(entities[child])) {
+            childTransform->MarkDirty();
+        }
+    }
+    std::vector<uint32_t> order;
+    order.reserve(GetNodeCount() - 1);
+    for (uint32_t i = 0; i < node; ++i) order.push_back(i);
+    for (uint32_t i = subtreeEnd; i < GetNodeCount(); ++i) order.push_back(i);
+    for (uint32_t i = node + 1; i < subtreeEnd; ++i) order.push_back(i);
+    Reorder(order);
+}
+
+void TransformHierarchy::MarkDirty(uint32_t node_) {
+    dirtyNodes.push_back(node_);
+}
+
+void TransformHierarchy::Update() {
+    if (deadNodes > kMinCompactNodes && deadNodes * 4 > GetNodeCount()) {
+        Compact();
+    }
+    if (dirtyNodes.empty()) return;
+
+    std::sort(dirtyNodes.begin(), dirtyNodes.end());
+    dirtyNodes.erase(std::unique(dirtyNodes.begin(), dirtyNodes.end()), dirtyNodes.end());
+
+    // Gather the dirty TRS values and compose all local matrices in one SIMD batch
+    batch.Clear();
+    for (uint32_t node : dirtyNodes) {
+        TransformComponent* transform = world.GetComponent<TransformComponent>(entities[node]);
+        if (transform) {
+            batch.Push(transform->pos, transform->orientation, transform->scale);
+            transform->dirty = false;
+        } else {
+            batch.Push(glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f));
+        }
+    }
+    composed.resize(batch.GetSize());
+    ComposeTransforms(batch, composed.data());
+    for (size_t i = 0; i < dirtyNodes.size(); ++i) {
+        localMatrices[dirtyNodes[i]] = composed[i];
+    }
+
+    // Ancestors precede descendants, so each parent's world matrix is final before its children read it
+    uint32_t refreshedEnd = 0;
+    for (uint32_t node : dirtyNodes) {
+        if (node < refreshedEnd) continue; // inside a subtree already refreshed in this pass
+
+        refreshedEnd = node + subtreeSizes[node];
+        for (uint32_t i = node; i < refreshedEnd; ++i) {
+            worldMatrices[i] = parents[i] != kInvalidNode ? worldMatrices[parents[i]] * localMatrices[i] : localMatrices[i];
+        }
+        changedRanges.push_back({ node, refreshedEnd - node });
+    }
+    dirtyNodes.clear();
+
+    // Keep the accumulated ranges sorted and merged for the consumers
+    std::sort(changedRanges.begin(), changedRanges.end(), [](const TransformRange& a, const TransformRange& b) { return a.first < b.first; });
+    size_t merged = 0;
+    for (size_t i = 1; i < changedRanges.size(); ++i) {
+        TransformRange& last = changedRanges[merged];
+        const TransformRange& range = changedRanges[i];
+        if (range.first <= last.first + last.count) {
+            last.count = std::max(last.count, range.first + range.count - last.first);
+        } else {
+            changedRanges[++merged] = range;
+        }
+    }
+    changedRanges.resize(merged + 1);
+}
+
+void TransformHierarchy::CaptureChanges(TransformDelta& delta_) const {
+    delta_.nodeCount = GetNodeCount();
+    delta_.ranges.clear();
+    delta_.matrices.clear();
+    for (const TransformRange& range : changedRanges) {
+        // Ranges recorded before a removal may reach past the current end
+        if (range.first >= delta_.nodeCount) break;
+        const TransformRange clamped = { range.first, std::min(range.count, delta_.nodeCount - range.first) };
+        delta_.ranges.push_back(clamped);
+        delta_.matrices.insert(delta_.matrices.end(), worldMatrices.begin() + clamped.first,
+                               worldMatrices.begin() + clamped.first + clamped.count);
+    }
+}
+
+void TransformDelta::Apply(std::vector<glm::mat4>& worldMatrices_) const {
+    worldMatrices_.resize(nodeCount);
+    auto source = matrices.begin();
+    for (const TransformRange& range : ranges) {
+        std::copy(source, source + range.count, worldMatrices_.begin() + range.first);
+        source += range.count;
+    }
+}
+
+void TransformHierarchy::RenumberFrom(uint32_t first_) {
+    for (uint32_t node = first_; node < GetNodeCount(); ++node) {
+        if (TransformComponent* transform = world.GetComponent<TransformComponent>(entities[node])) {
+            transform->hierarchyNode = node;
+        }
+    }
+}
+
+void TransformHierarchy::MarkChangedFrom(uint32_t first_) {
+    // Ranges from first_ on are covered by the new one; clip the one reaching into it
+    std::erase_if(changedRanges, [&](const TransformRange& range) { return range.first >= first_; });
+    for (TransformRange& range : changedRanges) {
+        range.count = std::min(range.count, first_ - range.first);
+    }
+    if (first_ < GetNodeCount()) {
+        changedRanges.push_back({ first_, GetNodeCount() - first_ });
+    }
+}
+
+void TransformHierarchy::PopDeadTail() {
+    while (!entities.empty() && !entities.back().IsValid()) {
+        const uint32_t node = GetNodeCount() - 1;
+        for (uint32_t ancestor = parents[node]; ancestor != kInvalidNode; ancestor = parents[ancestor]) {
+            subtreeSizes[ancestor]--;
+        }
+        dirtyNodes.erase(std::remove(dirtyNodes.begin(), dirtyNodes.end(), node), dirtyNodes.end());
+        entities.pop_back();
+        parents.pop_back();
+        subtreeSizes.pop_back();
+        localMatrices.pop_back();
+        worldMatrices.pop_back();
+        deadNodes--;
+    }
+}
+
+void TransformHierarchy::Compact() {
+    std::vector<uint32_t> order;
+    order.reserve(GetNodeCount() - deadNodes);
+    for (uint32_t node = 0; node < GetNodeCount(); ++node) {
+        if (entities[node].IsValid()) order.push_back(node);
+    }
+    Reorder(order);
+    deadNodes = 0;
+}
+
+void TransformHierarchy::Reorder(const std::vector<uint32_t>& order_) {
+    const uint32_t oldCount = GetNodeCount();
+    std::vector<uint32_t> newIndex(oldCount, kInvalidNode);
+    uint32_t firstMoved = static_cast<uint32_t>(order_.size());
+    for (uint32_t i = 0; i < order_.size(); ++i) {
+        newIndex[order_[i]] = i;
+        if (firstMoved == order_.size() && order_[i] != i) firstMoved = i;
+    }
+    if (firstMoved == order_.size() && order_.size() == oldCount) return;
+
+    auto permute = [&](auto& values_) {
+        std::remove_reference_t<decltype(values_)> permuted;
+        permuted.reserve(order_.size());
+        for (const uint32_t node : order_) permuted.push_back(values_[node]);
+        values_ = std::move(permuted);
+    };
+    permute(entities);
+    permute(parents);
+    permute(localMatrices);
+    permute(worldMatrices);
+    for (uint32_t& parent : parents) {
+        if (parent != kInvalidNode) parent = newIndex[parent];
+    }
+
+    // Preorder is kept, so the sizes follow from the parents in one backward pass
+    subtreeSizes.assign(order_.size(), 1);
+    for (uint32_t node = GetNodeCount(); node-- > 0;) {
+        if (parents[node] != kInvalidNode) subtreeSizes[parents[node]] += subtreeSizes[node];
+    }
+
+    for (uint32_t& dirty : dirtyNodes) dirty = newIndex[dirty];
+    dirtyNodes.erase(std::remove(dirtyNodes.begin(), dirtyNodes.end(), kInvalidNode), dirtyNodes.end());
+
+    RenumberFrom(firstMoved);
+    MarkChangedFrom(firstMoved);
+}
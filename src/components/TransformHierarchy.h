@@ -0,0 +1,101 @@
+#pragma once
+#include <ecs/World.h>
+#include <core/TransformKernels.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+/// Contiguous run of hierarchy nodes
+struct TransformRange {
+    uint32_t first;
+    uint32_t count;
+};
+
+/// World matrices that changed in one TransformHierarchy update, packed range after range, so a
+/// copy of the matrices owned by another thread can be brought up to date without touching the
+/// hierarchy. Deltas must be applied in the order they were captured.
+struct TransformDelta {
+    /// Node count of the hierarchy when captured
+    uint32_t nodeCount = 0;
+    std::vector<TransformRange> ranges;
+    /// Matrices of every range, in range order
+    std::vector<glm::mat4> matrices;
+
+    /// Resizes worldMatrices_ to nodeCount and overwrites the changed nodes
+    void Apply(std::vector<glm::mat4>& worldMatrices_) const;
+};
+
+/// World matrices for every registered TransformComponent, cached and recomputed only when
+/// something moves. Nodes are stored flattened in depth-first preorder: a parent always precedes
+/// its children and every subtree is one contiguous range, so updating a dirty node and all of
+/// its descendants is a single linear pass over [node, node + subtreeSize).
+///
+/// TransformComponent setters report the node as dirty; Update() refreshes only those subtrees
+/// and records the node ranges it changed so GPU copies can be patched incrementally.
+///
+/// Roots and new children at the end of the array are appended without moving anything. Removed
+/// leaves and roots leave a tombstone (an invalid entity) in place; Update() compacts them once
+/// they make up a quarter of the nodes, so despawning costs no renumbering until then.
+class TransformHierarchy {
+public:
+    static constexpr uint32_t kInvalidNode = UINT32_MAX;
+
+    explicit TransformHierarchy(World& world_);
+    ~TransformHierarchy();
+
+    TransformHierarchy(const TransformHierarchy&) = delete;
+    TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+    /// Registers the entity's TransformComponent under parent_'s. The entity becomes a root
+    /// when parent_ is invalid or not in the hierarchy.
+    void Add(Entity entity_, Entity parent_ = {});
+    /// Unregisters the entity; its children become roots
+    void Remove(Entity entity_);
+
+    void MarkDirty(uint32_t node_);
+    /// Recomputes the world matrices of dirty subtrees; returns immediately when nothing moved
+    void Update();
+
+    /// Includes tombstones of removed nodes not compacted yet
+    [[nodiscard]] uint32_t GetNodeCount() const { return static_cast<uint32_t>(entities.size()); }
+    [[nodiscard]] const glm::mat4& GetWorldMatrix(uint32_t node_) const { return worldMatrices[node_]; }
+    [[nodiscard]] const std::vector<glm::mat4>& GetWorldMatrices() const { return worldMatrices; }
+    /// Sorted, non-overlapping node ranges whose world matrices changed since ClearChanges().
+    /// An insert in the middle of the array, a compaction or the removal of an inner node with
+    /// children shift indices, and report every node from the first shifted one on as changed.
+    [[nodiscard]] const std::vector<TransformRange>& GetChangedRanges() const { return changedRanges; }
+    void ClearChanges() { changedRanges.clear(); }
+    /// Copies the changed ranges and their world matrices into delta_, reusing its storage
+    void CaptureChanges(TransformDelta& delta_) const;
+
+private:
+    /// Tombstones below this count are never compacted
+    static constexpr uint32_t kMinCompactNodes = 64;
+
+    /// Rewrites node indices after nodes from first_ on were shifted by an insert or erase
+    void RenumberFrom(uint32_t first_);
+    /// Replaces the changed ranges from first_ on with one range up to the end
+    void MarkChangedFrom(uint32_t first_);
+    /// Drops tombstones at the end of the array, which shifts nothing
+    void PopDeadTail();
+    void Compact();
+    /// Rebuilds the arrays with the nodes listed in order_ (old indices, preorder kept); nodes
+    /// not listed are dropped
+    void Reorder(const std::vector<uint32_t>& order_);
+
+    World& world;
+    std::vector<Entity> entities;
+    /// Parent node, or kInvalidNode for roots; always lower than the node's own index
+    std::vector<uint32_t> parents;
+    /// Number of nodes in the subtree, including the node itself
+    std::vector<uint32_t> subtreeSizes;
+    std::vector<glm::mat4> localMatrices;
+    std::vector<glm::mat4> worldMatrices;
+    std::vector<uint32_t> dirtyNodes;
+    std::vector<TransformRange> changedRanges;
+    uint32_t deadNodes = 0;
+
+    /// Scratch for Update(), kept to avoid reallocating every frame
+    TransformBatch batch;
+    std::vector<glm::mat4> composed;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+/// Axis-aligned bounding box; an empty box has min > max
+struct Aabb {
+    glm::vec3 min = glm::vec3(FLT_MAX);
+    glm::vec3 max = glm::vec3(-FLT_MAX);
+
+    [[nodiscard]] bool IsEmpty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+    [[nodiscard]] glm::vec3 GetCenter() const { return (min + max) * 0.5f; }
+    [[nodiscard]] glm::vec3 GetExtent() const { return max - min; }
+    [[nodiscard]] float GetSurfaceArea() const {
+        const glm::vec3 e = GetExtent();
+        return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+    [[nodiscard]] bool Contains(const Aabb& other_) const {
+        return glm::all(glm::lessThanEqual(min, other_.min)) && glm::all(glm::greaterThanEqual(max, other_.max));
+    }
+    [[nodiscard]] Aabb Expanded(float margin_) const { return { min - glm::vec3(margin_), max + glm::vec3(margin_) }; }
+
+    void Extend(const glm::vec3& point_) {
+        min = glm::min(min, point_);
+        max = glm::max(max, point_);
+    }
+    void Extend(const Aabb& other_) {
+        min = glm::min(min, other_.min);
+        max = glm::max(max, other_.max);
+    }
+};
+
+inline Aabb Union(const Aabb& a_, const Aabb& b_) {
+    return { glm::min(a_.min, b_.min), glm::max(a_.max, b_.max) };
+}
+
+/// World-space box enclosing box_ after transform_ (Arvo's method: no corner enumeration)
+inline Aabb TransformAabb(const Aabb& box_, const glm::mat4& transform_) {
+    const glm::vec3 center = glm::vec3(transform_ * glm::vec4(box_.GetCenter(), 1.0f));
+    const glm::vec3 halfExtent = box_.GetExtent() * 0.5f;
+    const glm::mat3 absolute(glm::abs(glm::vec3(transform_[0])), glm::abs(glm::vec3(transform_[1])), glm::abs(glm::vec3(transform_[2])));
+    const glm::vec3 worldHalfExtent = absolute * halfExtent;
+    return { center - worldHalfExtent, center + worldHalfExtent };
+}
+
+/// Largest axis scale of transform_, for scaling bounding sphere radii
+inline float GetMaxScale(const glm::mat4& transform_) {
+    const float x = glm::dot(glm::vec3(transform_[0]), glm::vec3(transform_[0]));
+    const float y = glm::dot(glm::vec3(transform_[1]), glm::vec3(transform_[1]));
+    const float z = glm::dot(glm::vec3(transform_[2]), glm::vec3(transform_[2]));
+    return std::sqrt(std::max(x, std::max(y, z)));
+}
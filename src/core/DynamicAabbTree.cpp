@@ -0,0 +1,140 @@
+#include <core/DynamicAabbTree.h>
+
+DynamicAabbTree::DynamicAabbTree(float margin_) : margin(margin_) {
+}
+
+uint32_t DynamicAabbTree::AllocateNode() {
+    if (freeList == kNullNode) {
+        nodes.emplace_back();
+        nodes.back().height = 0;
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+    const uint32_t index = freeList;
+    freeList = nodes[index].parent;
+    nodes[index] = Node{};
+    nodes[index].height = 0;
+    return index;
+}
+
+void DynamicAabbTree::FreeNode(uint32_t index_) {
+    nodes[index_].parent = freeList;
+    nodes[index_].height = -1;
+    freeList = index_;
+}
+
+uint32_t DynamicAabbTree::CreateProxy(const Aabb& bounds_, uint32_t userData_) {
+    const uint32_t leaf = AllocateNode();
+    nodes[leaf].bounds = bounds_.Expanded(margin);
+    nodes[leaf].userData = userData_;
+    InsertLeaf(leaf);
+    proxyCount++;
+    return leaf;
+}
+
+void DynamicAabbTree::DestroyProxy(uint32_t proxy_) {
+    RemoveLeaf(proxy_);
+    FreeNode(proxy_);
+    proxyCount--;
+}
+
+bool DynamicAabbTree::MoveProxy(uint32_t proxy_, const Aabb& bounds_) {
+    Node& leaf = nodes[proxy_];
+    if (leaf.bounds.Contains(bounds_)) return false;
+
+    const Aabb fatBounds = bounds_.Expanded(margin);
+    if (leaf.parent != kNullNode && nodes[leaf.parent].bounds.Contains(fatBounds)) {
+        // Still local: shrink-wrap the ancestors instead of searching for a new sibling
+        leaf.bounds = fatBounds;
+        RefitAncestors(leaf.parent);
+    } else {
+        RemoveLeaf(proxy_);
+        nodes[proxy_].bounds = fatBounds;
+        InsertLeaf(proxy_);
+    }
+    return true;
+}
+
+void DynamicAabbTree::InsertLeaf(uint32_t leaf_) {
+    if (root == kNullNode) {
+        root = leaf_;
+        nodes[root].parent = kNullNode;
+        return;
+    }
+
+    // Descend towards the sibling with the lowest surface area cost (Box2D's branch and bound)
+    const Aabb leafBounds = nodes[leaf_].bounds;
+    uint32_t index = root;
+    while (!nodes[index].IsLeaf()) {
+        const Node& node = nodes[index];
+        const float area = node.bounds.GetSurfaceArea();
+        const float combinedArea = Union(node.bounds, leafBounds).GetSurfaceArea();
+
+        // Cost of pairing with this node, and the increase every descendant path pays
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto childCost = [&](uint32_t child_) {
+            const Node& child = nodes[child_];
+            const float unionArea = Union(leafBounds, child.bounds).GetSurfaceArea();
+            return (child.IsLeaf() ? unionArea : unionArea - child.bounds.GetSurfaceArea()) + inheritanceCost;
+        };
+        const float cost1 = childCost(node.child1);
+        const float cost2 = childCost(node.child2);
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const uint32_t sibling = index;
+    const uint32_t oldParent = nodes[sibling].parent;
+    const uint32_t newParent = AllocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].bounds = Union(leafBounds, nodes[sibling].bounds);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf_;
+    nodes[sibling].parent = newParent;
+    nodes[leaf_].parent = newParent;
+
+    if (oldParent == kNullNode) {
+        root = newParent;
+    } else if (nodes[oldParent].child1 == sibling) {
+        nodes[oldParent].child1 = newParent;
+    } else {
+        nodes[oldParent].child2 = newParent;
+    }
+    RefitAncestors(oldParent);
+}
+
+void DynamicAabbTree::RemoveLeaf(uint32_t leaf_) {
+    if (leaf_ == root) {
+        root = kNullNode;
+        return;
+    }
+
+    // The parent disappears and the sibling takes its place
+    const uint32_t parent = nodes[leaf_].parent;
+    const uint32_t grandParent = nodes[parent].parent;
+    const uint32_t sibling = nodes[parent].child1 == leaf_ ? nodes[parent].child2 : nodes[parent].child1;
+    nodes[sibling].parent = grandParent;
+    if (grandParent == kNullNode) {
+        root = sibling;
+    } else {
+        if (nodes[grandParent].child1 == parent) {
+            nodes[grandParent].child1 = sibling;
+        } else {
+            nodes[grandParent].child2 = sibling;
+        }
+        RefitAncestors(grandParent);
+    }
+    FreeNode(parent);
+}
+
+void DynamicAabbTree::RefitAncestors(uint32_t index_) {
+    for (uint32_t index = index_; index != kNullNode; index = nodes[index].parent) {
+        Node& node = nodes[index];
+        const Node& child1 = nodes[node.child1];
+        const Node& child2 = nodes[node.child2];
+        node.bounds = Union(child1.bounds, child2.bounds);
+        node.height = 1 + std::max(child1.height, child2.height);
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <core/Bounds.h>
+#include <core/Frustum.h>
+#include <cstdint>
+#include <vector>
+
+/// Incrementally updated bounding volume hierarchy over moving objects (a binary AABB tree in
+/// the style of Box2D's b2DynamicTree). Leaves store "fat" boxes grown by a margin, so small
+/// movements inside the fat box cost nothing. A leaf that outgrows its box but stays within its
+/// parent's bounds is refitted in place up to the root; one that left them is reinserted, so
+/// fast movers do not drag their ancestors' boxes across the scene.
+class DynamicAabbTree {
+public:
+    static constexpr uint32_t kNullNode = UINT32_MAX;
+
+    explicit DynamicAabbTree(float margin_ = 0.1f);
+
+    /// Inserts a leaf for bounds_ and returns its proxy id
+    uint32_t CreateProxy(const Aabb& bounds_, uint32_t userData_);
+    void DestroyProxy(uint32_t proxy_);
+    /// Updates a leaf after its object moved; returns false if the fat box still contained it
+    bool MoveProxy(uint32_t proxy_, const Aabb& bounds_);
+
+    [[nodiscard]] uint32_t GetUserData(uint32_t proxy_) const { return nodes[proxy_].userData; }
+    [[nodiscard]] const Aabb& GetFatBounds(uint32_t proxy_) const { return nodes[proxy_].bounds; }
+    [[nodiscard]] uint32_t GetProxyCount() const { return proxyCount; }
+    [[nodiscard]] uint32_t GetHeight() const { return root != kNullNode ? nodes[root].height : 0; }
+
+    /// Calls visit_(userData) for every leaf whose fat box touches the frustum. Subtrees entirely
+    /// inside are reported without further plane tests. Returns the number of nodes tested.
+    template<typename F>
+    uint32_t Query(const Frustum& frustum_, F&& visit_) const {
+        if (root == kNullNode) return 0;
+        uint32_t tested = 0;
+        stack.clear();
+        stack.push_back({ root, false });
+        while (!stack.empty()) {
+            const auto [index, inside] = stack.back();
+            stack.pop_back();
+            const Node& node = nodes[index];
+
+            bool nodeInside = inside;
+            if (!inside) {
+                tested++;
+                const FrustumTest test = frustum_.Classify(node.bounds);
+                if (test == FrustumTest::Outside) continue;
+                nodeInside = test == FrustumTest::Inside;
+            }
+            if (node.IsLeaf()) {
+                visit_(node.userData);
+            } else {
+                stack.push_back({ node.child1, nodeInside });
+                stack.push_back({ node.child2, nodeInside });
+            }
+        }
+        return tested;
+    }
+
+private:
+    struct Node {
+        Aabb bounds;
+        uint32_t parent = kNullNode; // next free node while on the free list
+        uint32_t child1 = kNullNode;
+        uint32_t child2 = kNullNode;
+        uint32_t userData = 0;
+        /// Leaves are 0; -1 marks a free node
+        int32_t height = -1;
+
+        [[nodiscard]] bool IsLeaf() const { return child1 == kNullNode; }
+    };
+
+    struct StackEntry {
+        uint32_t node;
+        /// Parent was entirely inside the frustum
+        bool inside;
+    };
+
+    uint32_t AllocateNode();
+    void FreeNode(uint32_t index_);
+    void InsertLeaf(uint32_t leaf_);
+    void RemoveLeaf(uint32_t leaf_);
+    /// Recomputes bounds and heights from index_ up to the root
+    void RefitAncestors(uint32_t index_);
+
+    std::vector<Node> nodes;
+    uint32_t root = kNullNode;
+    uint32_t freeList = kNullNode;
+    uint32_t proxyCount = 0;
+    float margin;
+    /// Traversal scratch, kept to avoid allocating per query
+    mutable std::vector<StackEntry> stack;
+};
@@ -0,0 +1,119 @@
+#include <core/Frustum.h>
+#include <core/Simd.h>
+#include <core/TransformKernels.h>
+#include <bit>
+
+Frustum Frustum::FromViewProjection(const glm::mat4& viewProj_) {
+    // glm is column-major: row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&](int i_) { return glm::vec4(viewProj_[0][i_], viewProj_[1][i_], viewProj_[2][i_], viewProj_[3][i_]); };
+    const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    Frustum frustum;
+    frustum.planes[0] = r3 + r0; // left
+    frustum.planes[1] = r3 - r0; // right
+    frustum.planes[2] = r3 + r1; // bottom
+    frustum.planes[3] = r3 - r1; // top
+    frustum.planes[4] = r3 + r2; // near
+    frustum.planes[5] = r3 - r2; // far
+    for (glm::vec4& plane : frustum.planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+FrustumTest Frustum::Classify(const Aabb& box_) const {
+    const glm::vec3 center = box_.GetCenter();
+    const glm::vec3 halfExtent = box_.GetExtent() * 0.5f;
+    FrustumTest result = FrustumTest::Inside;
+    for (const glm::vec4& plane : planes) {
+        const float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+        // Projected radius of the box onto the plane normal
+        const float radius = glm::dot(glm::abs(glm::vec3(plane)), halfExtent);
+        if (distance < -radius) return FrustumTest::Outside;
+        if (distance < radius) result = FrustumTest::Intersecting;
+    }
+    return result;
+}
+
+bool Frustum::IntersectsSphere(const glm::vec3& center_, float radius_) const {
+    for (const glm::vec4& plane : planes) {
+        if (glm::dot(glm::vec3(plane), center_) + plane.w < -radius_) return false;
+    }
+    return true;
+}
+
+namespace {
+
+uint32_t CullSpheresScalar(const Frustum& frustum_, const float* x_, const float* y_, const float* z_, const float* r_,
+                           uint8_t* visible_, uint32_t first_, uint32_t end_) {
+    uint32_t visibleCount = 0;
+    for (uint32_t i = first_; i < end_; ++i) {
+        visible_[i] = frustum_.IntersectsSphere(glm::vec3(x_[i], y_[i], z_[i]), r_[i]) ? 1 : 0;
+        visibleCount += visible_[i];
+    }
+    return visibleCount;
+}
+
+#if defined(VKENGINE_SIMD_X64)
+
+// A sphere is outside as soon as its signed distance to any plane is below -radius; the six
+// plane tests are OR-ed into one mask per lane, so the loop has no per-sphere branches.
+uint32_t CullSpheresSse2(const Frustum& frustum_, const float* x_, const float* y_, const float* z_, const float* r_,
+                         uint8_t* visible_, uint32_t count_, uint32_t& visibleCount_) {
+    const uint32_t end = count_ & ~3u;
+    for (uint32_t i = 0; i < end; i += 4) {
+        const __m128 x = _mm_loadu_ps(x_ + i), y = _mm_loadu_ps(y_ + i), z = _mm_loadu_ps(z_ + i);
+        const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(r_ + i));
+        __m128 outside = _mm_setzero_ps();
+        for (const glm::vec4& plane : frustum_.planes) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+            distance = _mm_add_ps(distance, _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negRadius));
+        }
+        const int outsideBits = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; ++lane) {
+            visible_[i + lane] = (outsideBits >> lane) & 1 ? 0 : 1;
+        }
+        visibleCount_ += 4 - static_cast<uint32_t>(std::popcount(static_cast<unsigned>(outsideBits)));
+    }
+    return end;
+}
+
+VKENGINE_TARGET_AVX2 uint32_t CullSpheresAvx2(const Frustum& frustum_, const float* x_, const float* y_, const float* z_, const float* r_,
+                                              uint8_t* visible_, uint32_t count_, uint32_t& visibleCount_) {
+    const uint32_t end = count_ & ~7u;
+    for (uint32_t i = 0; i < end; i += 8) {
+        const __m256 x = _mm256_loadu_ps(x_ + i), y = _mm256_loadu_ps(y_ + i), z = _mm256_loadu_ps(z_ + i);
+        const __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(r_ + i));
+        __m256 outside = _mm256_setzero_ps();
+        for (const glm::vec4& plane : frustum_.planes) {
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(plane.x)), _mm256_mul_ps(y, _mm256_set1_ps(plane.y)));
+            distance = _mm256_add_ps(distance, _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(plane.z)), _mm256_set1_ps(plane.w)));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, negRadius, _CMP_LT_OQ));
+        }
+        const int outsideBits = _mm256_movemask_ps(outside);
+        for (int lane = 0; lane < 8; ++lane) {
+            visible_[i + lane] = (outsideBits >> lane) & 1 ? 0 : 1;
+        }
+        visibleCount_ += 8 - static_cast<uint32_t>(std::popcount(static_cast<unsigned>(outsideBits)));
+    }
+    return end;
+}
+
+#endif
+
+} // namespace
+
+uint32_t Frustum::CullSpheres(const float* centerX_, const float* centerY_, const float* centerZ_, const float* radius_,
+                              uint8_t* visible_, uint32_t count_) const {
+    uint32_t visibleCount = 0;
+    uint32_t done = 0;
+#if defined(VKENGINE_SIMD_X64)
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX2: done = CullSpheresAvx2(*this, centerX_, centerY_, centerZ_, radius_, visible_, count_, visibleCount); break;
+        case SimdLevel::SSE2: done = CullSpheresSse2(*this, centerX_, centerY_, centerZ_, radius_, visible_, count_, visibleCount); break;
+        default: break;
+    }
+#endif
+    return visibleCount + CullSpheresScalar(*this, centerX_, centerY_, centerZ_, radius_, visible_, done, count_);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <core/Bounds.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+enum class FrustumTest : uint8_t {
+    Outside,
+    Intersecting,
+    Inside,
+};
+
+/// Six world-space planes extracted from a view-projection matrix. Points p with
+/// dot(plane.xyz, p) + plane.w >= 0 are on the inner side of a plane.
+struct Frustum {
+    glm::vec4 planes[6];
+
+    /// Gribb-Hartmann extraction. The near plane assumes a -1..1 clip depth, as produced by
+    /// glm::perspective; under a 0..1 projection it is slightly looser, which only culls less.
+    static Frustum FromViewProjection(const glm::mat4& viewProj_);
+
+    [[nodiscard]] FrustumTest Classify(const Aabb& box_) const;
+    [[nodiscard]] bool IntersectsSphere(const glm::vec3& center_, float radius_) const;
+
+    /// Tests count_ spheres given as structure-of-arrays and writes 1 (visible) or 0 per sphere
+    /// into visible_. Runs 4 or 8 spheres per step at the level returned by GetSimdLevel().
+    /// Returns the number of visible spheres.
+    uint32_t CullSpheres(const float* centerX_, const float* centerY_, const float* centerZ_, const float* radius_,
+                         uint8_t* visible_, uint32_t count_) const;
+};
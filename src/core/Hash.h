@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// Small non-cryptographic 64-bit hash used for cache keys (mesh cache, asset registry, shader cache).
+// Reads 8 bytes per step, so hashing a large source asset stays well below the cost of parsing it.
+
+inline uint64_t RotateLeft64(uint64_t value_, int bits_) {
+    return (value_ << bits_) | (value_ >> (64 - bits_));
+}
+
+inline uint64_t FinalizeHash64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+inline uint64_t HashBytes(const void* data_, size_t size_, uint64_t seed_ = 0x9e3779b97f4a7c15ull) {
+    constexpr uint64_t c1 = 0x87c37b91114253d5ull;
+    constexpr uint64_t c2 = 0x4cf5ad432745937full;
+
+    const auto* bytes = static_cast<const uint8_t*>(data_);
+    uint64_t h = seed_ ^ (size_ * c1);
+
+    const size_t numWords = size_ / 8;
+    for (size_t i = 0; i < numWords; i++) {
+        uint64_t k;
+        std::memcpy(&k, bytes + i * 8, sizeof(k));
+        k *= c1;
+        k = RotateLeft64(k, 31);
+        k *= c2;
+        h ^= k;
+        h = RotateLeft64(h, 27) * 5 + 0x52dce729;
+    }
+
+    uint64_t tail = 0;
+    const size_t tailSize = size_ & 7;
+    if (tailSize) {
+        std::memcpy(&tail, bytes + numWords * 8, tailSize);
+        tail *= c1;
+        tail = RotateLeft64(tail, 31);
+        tail *= c2;
+        h ^= tail;
+    }
+
+    return FinalizeHash64(h);
+}
+
+inline uint64_t HashString(std::string_view str_, uint64_t seed_ = 0x9e3779b97f4a7c15ull) {
+    return HashBytes(str_.data(), str_.size(), seed_);
+}
+
+inline uint64_t HashCombine(uint64_t a_, uint64_t b_) {
+    return FinalizeHash64(a_ ^ (b_ + 0x9e3779b97f4a7c15ull + (a_ << 6) + (a_ >> 2)));
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+/// Read-only memory mapping of a whole file. The mapping stays valid until Close()
+/// or destruction, so pointers into GetData() can be handed straight to GPU uploads.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other_) noexcept;
+    MappedFile& operator=(MappedFile&& other_) noexcept;
+
+    bool Open(const std::filesystem::path& path_);
+    void Close();
+
+    [[nodiscard]] bool IsOpen() const { return data != nullptr; }
+    [[nodiscard]] const uint8_t* GetData() const { return data; }
+    [[nodiscard]] size_t GetSize() const { return size; }
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
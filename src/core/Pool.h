@@ -0,0 +1,140 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+/// Generational handle into a Pool<T>. A handle to a destroyed object never resolves, even after
+/// its slot has been reused.
+template<typename T>
+struct Handle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    [[nodiscard]] bool IsValid() const { return index != UINT32_MAX; }
+    bool operator==(const Handle& other_) const = default;
+};
+
+/// Slab allocator for objects of one type. Objects are constructed in place inside fixed-size
+/// slabs that are never moved or freed until the pool dies, so pointers stay valid for the
+/// object's lifetime, neighbours sit next to each other, and once warmed up creating and
+/// destroying objects touches only the free list.
+template<typename T, uint32_t SlabSize = 256>
+class Pool {
+public:
+    Pool() = default;
+    ~Pool() { Clear(); }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    template<typename... Args>
+    Handle<T> Create(Args&&... args_) {
+        const uint32_t index = AcquireSlot();
+        Slot& slot = GetSlot(index);
+        new (slot.storage) T(std::forward<Args>(args_)...);
+        slot.alive = true;
+        size++;
+        return { index, slot.generation };
+    }
+
+    /// Bulk variant: constructs out_.size() objects from the same arguments
+    template<typename... Args>
+    void CreateMany(std::span<Handle<T>> out_, const Args&... args_) {
+        Reserve(size + static_cast<uint32_t>(out_.size()));
+        for (Handle<T>& handle : out_) {
+            handle = Create(args_...);
+        }
+    }
+
+    void Destroy(Handle<T> handle_) {
+        if (!Get(handle_)) return;
+        Slot& slot = GetSlot(handle_.index);
+        std::launder(reinterpret_cast<T*>(slot.storage))->~T();
+        slot.alive = false;
+        slot.generation++;
+        freeList.push_back(handle_.index);
+        size--;
+    }
+
+    void DestroyMany(std::span<const Handle<T>> handles_) {
+        for (Handle<T> handle : handles_) {
+            Destroy(handle);
+        }
+    }
+
+    /// The object, or nullptr if the handle is stale or invalid
+    [[nodiscard]] T* Get(Handle<T> handle_) const {
+        if (handle_.index >= capacity) return nullptr;
+        Slot& slot = GetSlot(handle_.index);
+        return slot.alive && slot.generation == handle_.generation ? std::launder(reinterpret_cast<T*>(slot.storage)) : nullptr;
+    }
+
+    /// Grows to at least capacity_ slots up front so later Create() calls do not allocate
+    void Reserve(uint32_t capacity_) {
+        while (capacity < capacity_) {
+            AddSlab();
+        }
+        if (freeList.capacity() < capacity) {
+            freeList.reserve(capacity);
+        }
+    }
+
+    /// Calls func_(Handle<T>, T&) for every live object in slot order
+    template<typename F>
+    void ForEach(F&& func_) {
+        for (uint32_t index = 0; index < capacity; ++index) {
+            Slot& slot = GetSlot(index);
+            if (slot.alive) {
+                func_(Handle<T>{ index, slot.generation }, *std::launder(reinterpret_cast<T*>(slot.storage)));
+            }
+        }
+    }
+
+    void Clear() {
+        for (uint32_t index = 0; index < capacity; ++index) {
+            Slot& slot = GetSlot(index);
+            if (slot.alive) {
+                Destroy({ index, slot.generation });
+            }
+        }
+    }
+
+    [[nodiscard]] uint32_t GetSize() const { return size; }
+    [[nodiscard]] uint32_t GetCapacity() const { return capacity; }
+
+private:
+    struct Slot {
+        alignas(T) std::byte storage[sizeof(T)];
+        uint32_t generation = 0;
+        bool alive = false;
+    };
+
+    Slot& GetSlot(uint32_t index_) const { return slabs[index_ / SlabSize][index_ % SlabSize]; }
+
+    void AddSlab() {
+        slabs.push_back(std::make_unique<Slot[]>(SlabSize));
+        // Hand out low indices first so live objects stay packed towards the front
+        for (uint32_t i = SlabSize; i > 0; --i) {
+            freeList.push_back(capacity + i - 1);
+        }
+        capacity += SlabSize;
+    }
+
+    uint32_t AcquireSlot() {
+        if (freeList.empty()) {
+            AddSlab();
+        }
+        const uint32_t index = freeList.back();
+        freeList.pop_back();
+        return index;
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    std::vector<uint32_t> freeList;
+    uint32_t capacity = 0;
+    uint32_t size = 0;
+};
@@ -0,0 +1,162 @@
+#include <core/Profiler.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+thread_local uint32_t tThreadIndex = UINT32_MAX;
+
+void WriteJsonString(std::ostream& out_, std::string_view text_) {
+    out_ << '"';
+    for (const char c : text_) {
+        if (c == '"' || c == '\\') out_ << '\\';
+        out_ << c;
+    }
+    out_ << '"';
+}
+}
+
+Profiler& Profiler::Get() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : start(std::chrono::steady_clock::now()) {
+}
+
+double Profiler::Now() const {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint32_t Profiler::GetThreadIndex() {
+    if (tThreadIndex == UINT32_MAX) {
+        tThreadIndex = static_cast<uint32_t>(threadNames.size());
+        threadNames.push_back("Thread " + std::to_string(tThreadIndex));
+    }
+    return tThreadIndex;
+}
+
+void Profiler::SetThreadName(const char* name_) {
+#if defined(VKENGINE_WITH_TRACY)
+    tracy::SetThreadName(name_);
+#endif
+    std::lock_guard lock(mutex);
+    threadNames[GetThreadIndex()] = name_;
+}
+
+void Profiler::AddCpuEvent(const char* name_, double startUs_, double endUs_) {
+    std::lock_guard lock(mutex);
+    AddEvent({ name_, GetThreadIndex(), frame, startUs_, endUs_ - startUs_ }, false);
+}
+
+void Profiler::AddGpuEvent(const char* name_, double startUs_, double durationUs_) {
+    std::lock_guard lock(mutex);
+    AddEvent({ name_, kGpuThread, frame, startUs_, durationUs_ }, true);
+}
+
+void Profiler::AddEvent(const ProfileEvent& event_, bool gpu_) {
+    if (event_.frame == 0) {
+        startupEvents.push_back(event_);
+    } else {
+        events.push_back(event_);
+    }
+
+    std::unordered_map<std::string_view, uint32_t>& indices = gpu_ ? gpuZoneIndices : cpuZoneIndices;
+    auto [it, inserted] = indices.try_emplace(event_.name, static_cast<uint32_t>(zones.size()));
+    if (inserted) {
+        zones.push_back({ .name = event_.name, .gpu = gpu_ });
+    }
+    Zone& zone = zones[it->second];
+    zone.currentUs += event_.durationUs;
+    zone.lastSeenFrame = frame;
+}
+
+void Profiler::EndFrame() {
+#if defined(VKENGINE_WITH_TRACY)
+    FrameMark;
+#endif
+    std::lock_guard lock(mutex);
+    for (Zone& zone : zones) {
+        zone.frameMs[frame % kStatsFrames] = static_cast<float>(zone.currentUs / 1000.0);
+        zone.currentUs = 0.0;
+    }
+    frame++;
+    while (!events.empty() && events.front().frame + kHistoryFrames < frame) {
+        events.pop_front();
+    }
+}
+
+uint64_t Profiler::GetFrame() const {
+    std::lock_guard lock(mutex);
+    return frame;
+}
+
+std::vector<ProfileZoneStats> Profiler::GetStats() const {
+    std::lock_guard lock(mutex);
+    std::vector<ProfileZoneStats> stats;
+    const uint32_t frameCount = static_cast<uint32_t>(std::min<uint64_t>(frame, kStatsFrames));
+    if (frameCount == 0) return stats;
+    for (const Zone& zone : zones) {
+        if (zone.lastSeenFrame + kStatsFrames < frame) continue;
+        ProfileZoneStats& zoneStats = stats.emplace_back(ProfileZoneStats{
+            .name      = zone.name,
+            .gpu       = zone.gpu,
+            .lastMs    = zone.frameMs[(frame - 1) % kStatsFrames],
+            .averageMs = 0.0f,
+            .maxMs     = 0.0f,
+        });
+        for (uint32_t i = 0; i < frameCount; ++i) {
+            zoneStats.averageMs += zone.frameMs[(frame - 1 - i) % kStatsFrames];
+            zoneStats.maxMs = std::max(zoneStats.maxMs, zone.frameMs[(frame - 1 - i) % kStatsFrames]);
+        }
+        zoneStats.averageMs /= static_cast<float>(frameCount);
+    }
+    return stats;
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path_, uint64_t firstFrame_, uint64_t lastFrame_) const {
+    std::lock_guard lock(mutex);
+    const std::filesystem::path path(path_);
+    if (path.has_parent_path()) {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to write trace: " << path_ << std::endl;
+        return false;
+    }
+
+    // The GPU track comes after the threads
+    const uint32_t gpuTrack = static_cast<uint32_t>(threadNames.size());
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    auto writeMetadata = [&](uint32_t track_, std::string_view name_) {
+        out << (first ? "" : ",\n") << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << track_ << R"(,"args":{"name":)";
+        WriteJsonString(out, name_);
+        out << "}}";
+        first = false;
+    };
+    for (uint32_t i = 0; i < threadNames.size(); ++i) {
+        writeMetadata(i, threadNames[i]);
+    }
+    writeMetadata(gpuTrack, "GPU");
+
+    out.precision(3);
+    out << std::fixed;
+    auto writeEvents = [&](const auto& events_) {
+        for (const ProfileEvent& event : events_) {
+            if (event.frame < firstFrame_ || event.frame > lastFrame_) continue;
+            const bool gpu = event.thread == kGpuThread;
+            out << ",\n{\"name\":";
+            WriteJsonString(out, event.name);
+            out << ",\"cat\":\"" << (gpu ? "gpu" : "cpu") << R"(","ph":"X","pid":1,"tid":)" << (gpu ? gpuTrack : event.thread)
+                << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs << ",\"args\":{\"frame\":" << event.frame << "}}";
+        }
+    };
+    writeEvents(startupEvents);
+    writeEvents(events);
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
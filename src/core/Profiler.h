@@ -0,0 +1,131 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#if defined(VKENGINE_WITH_TRACY)
+#include <tracy/Tracy.hpp>
+#endif
+
+/// A finished zone, timed in microseconds since the profiler started
+struct ProfileEvent {
+    const char* name;
+    /// Index of the recording thread, or Profiler::kGpuThread
+    uint32_t thread;
+    uint64_t frame;
+    double startUs;
+    double durationUs;
+};
+
+/// Time spent in one zone per frame, summed over all its occurrences in the frame
+struct ProfileZoneStats {
+    const char* name;
+    bool gpu;
+    float lastMs;
+    /// Over the last Profiler::kStatsFrames frames
+    float averageMs;
+    float maxMs;
+};
+
+/// CPU and GPU zones of the whole engine, for the statistics panel and trace export.
+///
+/// VKENGINE_PROFILE_ZONE("Name") times the rest of its scope on any thread. Names must outlive
+/// the profiler (string literals): events keep the pointer. The main thread calls EndFrame() once
+/// per frame, which closes the per-zone totals of the rolling statistics. GPU zones come from
+/// GpuProfiler a few frames late; the GPU clock is not correlated with the CPU one, so they are
+/// placed on their own track relative to the CPU time their frame started recording.
+///
+/// Events of the last kHistoryFrames frames are kept, plus everything of frame 0, the start-up.
+/// With VKENGINE_WITH_TRACY the CPU zones and frame marks also go to Tracy.
+class Profiler {
+public:
+    static constexpr uint32_t kGpuThread = UINT32_MAX;
+    static constexpr uint32_t kHistoryFrames = 600;
+    static constexpr uint32_t kStatsFrames = 120;
+
+    static Profiler& Get();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /// Microseconds since the profiler started
+    [[nodiscard]] double Now() const;
+    /// Names the calling thread in traces
+    void SetThreadName(const char* name_);
+
+    void AddCpuEvent(const char* name_, double startUs_, double endUs_);
+    void AddGpuEvent(const char* name_, double startUs_, double durationUs_);
+    /// Closes the current frame; called by the main thread once per frame
+    void EndFrame();
+
+    [[nodiscard]] uint64_t GetFrame() const;
+    /// Zones seen in the last kStatsFrames frames, in order of first appearance
+    [[nodiscard]] std::vector<ProfileZoneStats> GetStats() const;
+    /// Writes the kept events of frames firstFrame_ to lastFrame_ as Chrome trace JSON (for
+    /// chrome://tracing or Perfetto); false if the file could not be written
+    bool ExportChromeTrace(const std::string& path_, uint64_t firstFrame_, uint64_t lastFrame_) const;
+
+private:
+    struct Zone {
+        const char* name;
+        bool gpu;
+        /// Microseconds spent in the zone in the current frame
+        double currentUs = 0.0;
+        /// Milliseconds per frame, indexed by frame % kStatsFrames
+        std::array<float, kStatsFrames> frameMs = {};
+        uint64_t lastSeenFrame = 0;
+    };
+
+    Profiler();
+
+    /// Index of the calling thread, registered on first use; mutex must be held
+    uint32_t GetThreadIndex();
+    void AddEvent(const ProfileEvent& event_, bool gpu_);
+
+    std::chrono::steady_clock::time_point start;
+    mutable std::mutex mutex;
+    uint64_t frame = 0;
+    std::vector<ProfileEvent> startupEvents;
+    std::deque<ProfileEvent> events;
+    std::vector<std::string> threadNames;
+    std::vector<Zone> zones;
+    std::unordered_map<std::string_view, uint32_t> cpuZoneIndices;
+    std::unordered_map<std::string_view, uint32_t> gpuZoneIndices;
+};
+
+/// Records a CPU zone from construction to End() or destruction
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name_) : name(name_), start(Profiler::Get().Now()) {}
+    ~ProfileScope() { End(); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    /// Ends the zone before the scope does; later calls do nothing
+    void End() {
+        if (!name) return;
+        Profiler& profiler = Profiler::Get();
+        profiler.AddCpuEvent(name, start, profiler.Now());
+        name = nullptr;
+    }
+
+private:
+    const char* name;
+    double start;
+};
+
+#define VKENGINE_PROFILE_CONCAT_IMPL(a_, b_) a_##b_
+#define VKENGINE_PROFILE_CONCAT(a_, b_) VKENGINE_PROFILE_CONCAT_IMPL(a_, b_)
+#if defined(VKENGINE_WITH_TRACY)
+#define VKENGINE_PROFILE_ZONE(name_) \
+    ZoneScopedN(name_);              \
+    ProfileScope VKENGINE_PROFILE_CONCAT(profileScope, __LINE__)(name_)
+#else
+#define VKENGINE_PROFILE_ZONE(name_) ProfileScope VKENGINE_PROFILE_CONCAT(profileScope, __LINE__)(name_)
+#endif
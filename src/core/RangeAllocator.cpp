@@ -0,0 +1,81 @@
+#include <core/RangeAllocator.h>
+#include <algorithm>
+
+RangeAllocator::RangeAllocator(uint32_t capacity_) : capacity(capacity_) {
+    if (capacity > 0) {
+        freeBlocks.emplace(0, capacity);
+    }
+}
+
+uint32_t RangeAllocator::Allocate(uint32_t size_) {
+    if (size_ == 0) {
+        return kInvalidOffset;
+    }
+    for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it) {
+        if (it->second < size_) continue;
+
+        const uint32_t offset = it->first;
+        const uint32_t remaining = it->second - size_;
+        freeBlocks.erase(it);
+        if (remaining > 0) {
+            freeBlocks.emplace(offset + size_, remaining);
+        }
+        usedSize += size_;
+        return offset;
+    }
+    return kInvalidOffset;
+}
+
+void RangeAllocator::Free(uint32_t offset_, uint32_t size_) {
+    if (size_ == 0) return;
+    usedSize -= size_;
+
+    auto next = freeBlocks.lower_bound(offset_);
+    uint32_t offset = offset_;
+    uint32_t size = size_;
+
+    // Merge with the block that ends where this one starts
+    if (next != freeBlocks.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            freeBlocks.erase(prev);
+        }
+    }
+    // ...and with the block that starts where this one ends
+    if (next != freeBlocks.end() && offset + size == next->first) {
+        size += next->second;
+        freeBlocks.erase(next);
+    }
+    freeBlocks.emplace(offset, size);
+}
+
+void RangeAllocator::Grow(uint32_t newCapacity_) {
+    if (newCapacity_ <= capacity) return;
+    const uint32_t oldCapacity = capacity;
+    capacity = newCapacity_;
+    usedSize += newCapacity_ - oldCapacity; // Free() below subtracts it again
+    Free(oldCapacity, newCapacity_ - oldCapacity);
+}
+
+void RangeAllocator::Reset(uint32_t usedSize_) {
+    freeBlocks.clear();
+    usedSize = usedSize_;
+    if (usedSize_ < capacity) {
+        freeBlocks.emplace(usedSize_, capacity - usedSize_);
+    }
+}
+
+uint32_t RangeAllocator::GetLargestFreeBlock() const {
+    uint32_t largest = 0;
+    for (const auto& [offset, size] : freeBlocks) {
+        largest = std::max(largest, size);
+    }
+    return largest;
+}
+
+float RangeAllocator::GetFragmentation() const {
+    const uint32_t freeSize = capacity - usedSize;
+    return freeSize > 0 ? 1.0f - float(GetLargestFreeBlock()) / float(freeSize) : 0.0f;
+}
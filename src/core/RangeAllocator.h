@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <map>
+
+/// First-fit offset allocator over [0, capacity) in abstract units (bytes, vertices, indices).
+/// Free blocks are kept sorted by offset and coalesced with their neighbours on release.
+/// Only bookkeeping: the caller owns whatever memory the offsets refer to.
+class RangeAllocator {
+public:
+    static constexpr uint32_t kInvalidOffset = UINT32_MAX;
+
+    explicit RangeAllocator(uint32_t capacity_ = 0);
+
+    /// Returns the offset of a free range of size_ units, or kInvalidOffset if none fits
+    uint32_t Allocate(uint32_t size_);
+    void Free(uint32_t offset_, uint32_t size_);
+    /// Extends the managed range; the new tail is free
+    void Grow(uint32_t newCapacity_);
+    /// Forgets every allocation and makes [usedSize_, capacity) the only free block.
+    /// Used after compaction, when live ranges have been packed to the front.
+    void Reset(uint32_t usedSize_);
+
+    [[nodiscard]] uint32_t GetCapacity() const { return capacity; }
+    [[nodiscard]] uint32_t GetUsedSize() const { return usedSize; }
+    [[nodiscard]] uint32_t GetLargestFreeBlock() const;
+    [[nodiscard]] uint32_t GetFreeBlockCount() const { return static_cast<uint32_t>(freeBlocks.size()); }
+    /// 0 when all free space is one block, approaching 1 as it splinters
+    [[nodiscard]] float GetFragmentation() const;
+
+private:
+    std::map<uint32_t, uint32_t> freeBlocks; // offset -> size
+    uint32_t capacity = 0;
+    uint32_t usedSize = 0;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+// Shared switches for the hand-written SIMD kernels. x86-64 always has SSE2; AVX2 kernels are
+// compiled per function and only called after a runtime CPU check (see GetSupportedSimdLevel()).
+#if defined(__x86_64__) || defined(_M_X64)
+#define VKENGINE_SIMD_X64 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC emits any intrinsic without per-function flags; GCC and Clang need the target attribute
+#if defined(VKENGINE_SIMD_X64) && !(defined(_MSC_VER) && !defined(__clang__))
+#define VKENGINE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define VKENGINE_TARGET_AVX2
+#endif
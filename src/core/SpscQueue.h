@@ -0,0 +1,75 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <utility>
+
+/// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+/// Head and tail are monotonically increasing counters on separate cache lines; each side only
+/// writes its own counter, so pushing and popping never take a lock. The blocking variants park on
+/// the other side's counter with C++20 atomic wait instead of spinning.
+template<typename T, uint32_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() = default;
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// Producer only; returns false when the queue is full
+    bool TryPush(T value_) {
+        const uint32_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - headIndex.load(std::memory_order_acquire) == Capacity) return false;
+        slots[tail & (Capacity - 1)] = std::move(value_);
+        tailIndex.store(tail + 1, std::memory_order_release);
+        tailIndex.notify_one();
+        return true;
+    }
+
+    /// Producer only; waits while the queue is full
+    void Push(T value_) {
+        const uint32_t tail = tailIndex.load(std::memory_order_relaxed);
+        for (uint32_t head = headIndex.load(std::memory_order_acquire); tail - head == Capacity;
+             head = headIndex.load(std::memory_order_acquire)) {
+            headIndex.wait(head, std::memory_order_acquire);
+        }
+        slots[tail & (Capacity - 1)] = std::move(value_);
+        tailIndex.store(tail + 1, std::memory_order_release);
+        tailIndex.notify_one();
+    }
+
+    /// Consumer only; returns nothing when the queue is empty
+    std::optional<T> TryPop() {
+        const uint32_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailIndex.load(std::memory_order_acquire)) return std::nullopt;
+        T value = std::move(slots[head & (Capacity - 1)]);
+        headIndex.store(head + 1, std::memory_order_release);
+        headIndex.notify_one();
+        return value;
+    }
+
+    /// Consumer only; waits while the queue is empty
+    T Pop() {
+        const uint32_t head = headIndex.load(std::memory_order_relaxed);
+        for (uint32_t tail = tailIndex.load(std::memory_order_acquire); tail == head;
+             tail = tailIndex.load(std::memory_order_acquire)) {
+            tailIndex.wait(tail, std::memory_order_acquire);
+        }
+        T value = std::move(slots[head & (Capacity - 1)]);
+        headIndex.store(head + 1, std::memory_order_release);
+        headIndex.notify_one();
+        return value;
+    }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    alignas(kCacheLine) std::atomic<uint32_t> headIndex{0};
+    alignas(kCacheLine) std::atomic<uint32_t> tailIndex{0};
+    alignas(kCacheLine) std::array<T, Capacity> slots{};
+};
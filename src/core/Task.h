@@ -0,0 +1,135 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <utility>
+
+/// Lazily started coroutine returning T. Awaiting a Task starts it and resumes the awaiter
+/// (via symmetric transfer) when it finishes, on whichever thread the task completed on.
+template<typename T>
+class Task;
+
+namespace detail {
+
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr exception;
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle_) noexcept {
+            std::coroutine_handle<> continuation = handle_.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+    void return_value(T value_) { value = std::move(value_); }
+
+    T TakeResult() {
+        if (exception) std::rethrow_exception(exception);
+        return std::move(*value);
+    }
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+
+    void TakeResult() const {
+        if (exception) std::rethrow_exception(exception);
+    }
+};
+
+} // namespace detail
+
+template<typename T = void>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle_) : handle(handle_) {}
+    ~Task() {
+        if (handle) handle.destroy();
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    Task(Task&& other_) noexcept : handle(std::exchange(other_.handle, {})) {}
+    Task& operator=(Task&& other_) noexcept {
+        if (this != &other_) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other_.handle, {});
+        }
+        return *this;
+    }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            Handle handle;
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting_) noexcept {
+                handle.promise().continuation = awaiting_;
+                return handle;
+            }
+            T await_resume() { return handle.promise().TakeResult(); }
+        };
+        return Awaiter{handle};
+    }
+
+private:
+    Handle handle;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+/// Eagerly started coroutine that owns and frees its own frame
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+} // namespace detail
+
+/// Starts a task without waiting for it. Exceptions escaping the task are logged and dropped.
+template<typename T>
+void SpawnDetached(Task<T> task_) {
+    [](Task<T> task) -> detail::DetachedTask {
+        try {
+            co_await std::move(task);
+        } catch (const std::exception& e) {
+            std::cerr << "Detached task failed: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Detached task failed with an unknown exception" << std::endl;
+        }
+    }(std::move(task_));
+}
@@ -0,0 +1,75 @@
+#include <core/ThreadPool.h>
+#include <core/Profiler.h>
+#include <algorithm>
+
+ThreadPool::ThreadPool(uint32_t numThreads_) {
+    if (numThreads_ == 0) {
+        const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        numThreads_ = std::max(1u, hardwareThreads > 1 ? hardwareThreads - 1 : 1u);
+    }
+    workers.reserve(numThreads_);
+    for (uint32_t i = 0; i < numThreads_; i++) {
+        workers.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Enqueue(std::function<void()> job_) {
+    {
+        std::lock_guard lock(mutex);
+        jobs.push_back(std::move(job_));
+    }
+    condition.notify_one();
+}
+
+void ThreadPool::WorkerLoop() {
+    Profiler::Get().SetThreadName("Worker");
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(mutex);
+            condition.wait(lock, [this] { return stopping || !jobs.empty(); });
+            // Drain the queue before exiting so no suspended coroutine is lost
+            if (jobs.empty()) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+void TaskQueue::Push(std::coroutine_handle<> handle_) {
+    std::lock_guard lock(mutex);
+    pending.push_back(handle_);
+}
+
+uint32_t TaskQueue::Pump(uint32_t maxTasks_) {
+    uint32_t numResumed = 0;
+    while (numResumed < maxTasks_) {
+        std::coroutine_handle<> handle;
+        {
+            std::lock_guard lock(mutex);
+            if (pending.empty()) break;
+            handle = pending.front();
+            pending.pop_front();
+        }
+        handle.resume();
+        numResumed++;
+    }
+    return numResumed;
+}
+
+bool TaskQueue::IsEmpty() {
+    std::lock_guard lock(mutex);
+    return pending.empty();
+}
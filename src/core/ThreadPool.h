@@ -0,0 +1,71 @@
+#pragma once
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Fixed set of worker threads consuming a FIFO job queue
+class ThreadPool {
+public:
+    /// numThreads_ == 0 picks one worker per hardware thread minus the calling thread
+    explicit ThreadPool(uint32_t numThreads_ = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Enqueue(std::function<void()> job_);
+    [[nodiscard]] uint32_t GetNumThreads() const { return static_cast<uint32_t>(workers.size()); }
+
+    /// co_await pool.Schedule() continues the coroutine on a worker thread
+    auto Schedule() {
+        struct Awaiter {
+            ThreadPool* pool;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle_) const {
+                pool->Enqueue([handle_] { handle_.resume(); });
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this};
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+
+    void WorkerLoop();
+};
+
+/// Queue of coroutines that must continue on one specific thread (e.g. the render thread).
+/// The owning thread resumes them in batches with Pump().
+class TaskQueue {
+public:
+    /// co_await queue.Schedule() continues the coroutine on the thread that calls Pump()
+    auto Schedule() {
+        struct Awaiter {
+            TaskQueue* queue;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle_) const { queue->Push(handle_); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this};
+    }
+
+    /// Resumes at most maxTasks_ queued coroutines, returns how many ran
+    uint32_t Pump(uint32_t maxTasks_ = UINT32_MAX);
+    [[nodiscard]] bool IsEmpty();
+
+private:
+    std::mutex mutex;
+    std::deque<std::coroutine_handle<>> pending;
+
+    void Push(std::coroutine_handle<> handle_);
+};
@@ -0,0 +1,468 @@
+#include <core/TransformKernels.h>
+#include <core/Simd.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+void TransformBatch::Clear() {
+    for (std::vector<float>* array : { &positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &rotationW, &scaleX, &scaleY, &scaleZ }) {
+        array->clear();
+    }
+}
+
+void TransformBatch::Reserve(uint32_t count_) {
+    for (std::vector<float>* array : { &positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &rotationW, &scaleX, &scaleY, &scaleZ }) {
+        array->reserve(count_);
+    }
+}
+
+void TransformBatch::Push(const glm::vec3& position_, const glm::quat& rotation_, const glm::vec3& scale_) {
+    positionX.push_back(position_.x);
+    positionY.push_back(position_.y);
+    positionZ.push_back(position_.z);
+    rotationX.push_back(rotation_.x);
+    rotationY.push_back(rotation_.y);
+    rotationZ.push_back(rotation_.z);
+    rotationW.push_back(rotation_.w);
+    scaleX.push_back(scale_.x);
+    scaleY.push_back(scale_.y);
+    scaleZ.push_back(scale_.z);
+}
+
+namespace {
+
+/// Column-major float outputs; normals and mvps may be null
+struct ComposeOutputs {
+    float* models;
+    float* normals;
+    const float* viewProj;
+    float* mvps;
+};
+
+// Model = T * S * R, so column c of the upper 3x3 is S * R[c] and, R being orthonormal, the
+// normal matrix (S * R)^-T = S^-1 * R has column c = R[c] / S. No inverse is ever computed.
+
+void ComposeScalar(const TransformBatch& batch_, uint32_t first_, uint32_t end_, const ComposeOutputs& out_) {
+    for (uint32_t i = first_; i < end_; ++i) {
+        const float x = batch_.rotationX[i], y = batch_.rotationY[i], z = batch_.rotationZ[i], w = batch_.rotationW[i];
+        const float xx = x * x, yy = y * y, zz = z * z;
+        const float xy = x * y, xz = x * z, yz = y * z;
+        const float wx = w * x, wy = w * y, wz = w * z;
+        const float rotation[3][3] = {
+            { 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy) },
+            { 2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx) },
+            { 2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy) },
+        };
+        const float scale[3] = { batch_.scaleX[i], batch_.scaleY[i], batch_.scaleZ[i] };
+
+        float* model = out_.models + size_t(i) * 16;
+        for (int c = 0; c < 3; ++c) {
+            for (int r = 0; r < 3; ++r) {
+                model[c * 4 + r] = scale[r] * rotation[c][r];
+            }
+            model[c * 4 + 3] = 0.0f;
+        }
+        model[12] = batch_.positionX[i];
+        model[13] = batch_.positionY[i];
+        model[14] = batch_.positionZ[i];
+        model[15] = 1.0f;
+
+        if (out_.normals) {
+            float* normal = out_.normals + size_t(i) * 12;
+            for (int c = 0; c < 3; ++c) {
+                for (int r = 0; r < 3; ++r) {
+                    normal[c * 4 + r] = rotation[c][r] / scale[r];
+                }
+                normal[c * 4 + 3] = 0.0f;
+            }
+        }
+        if (out_.mvps) {
+            float* mvp = out_.mvps + size_t(i) * 16;
+            for (int c = 0; c < 4; ++c) {
+                for (int r = 0; r < 4; ++r) {
+                    mvp[c * 4 + r] = out_.viewProj[r] * model[c * 4] + out_.viewProj[4 + r] * model[c * 4 + 1] +
+                                     out_.viewProj[8 + r] * model[c * 4 + 2] + out_.viewProj[12 + r] * model[c * 4 + 3];
+                }
+            }
+        }
+    }
+}
+
+void MultiplyScalar(const float* lhs_, const float* rhs_, float* out_, uint32_t count_) {
+    for (uint32_t i = 0; i < count_; ++i) {
+        const float* rhs = rhs_ + size_t(i) * 16;
+        float* out = out_ + size_t(i) * 16;
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                out[c * 4 + r] = lhs_[r] * rhs[c * 4] + lhs_[4 + r] * rhs[c * 4 + 1] + lhs_[8 + r] * rhs[c * 4 + 2] + lhs_[12 + r] * rhs[c * 4 + 3];
+            }
+        }
+    }
+}
+
+#if defined(VKENGINE_SIMD_X64)
+
+// SSE2 is part of x86-64, so this level needs no runtime check. Lanes hold 4 transforms; each
+// 4x4 transpose turns one matrix column of 4 lanes into that column of 4 output matrices.
+uint32_t ComposeSse2(const TransformBatch& batch_, uint32_t count_, const ComposeOutputs& out_) {
+    const uint32_t end = count_ & ~3u;
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 zero = _mm_setzero_ps();
+    for (uint32_t i = 0; i < end; i += 4) {
+        const __m128 x = _mm_loadu_ps(&batch_.rotationX[i]);
+        const __m128 y = _mm_loadu_ps(&batch_.rotationY[i]);
+        const __m128 z = _mm_loadu_ps(&batch_.rotationZ[i]);
+        const __m128 w = _mm_loadu_ps(&batch_.rotationW[i]);
+        const __m128 sx = _mm_loadu_ps(&batch_.scaleX[i]);
+        const __m128 sy = _mm_loadu_ps(&batch_.scaleY[i]);
+        const __m128 sz = _mm_loadu_ps(&batch_.scaleZ[i]);
+
+        const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+        const __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+        const __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+        const __m128 r00 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+        const __m128 r01 = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+        const __m128 r02 = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+        const __m128 r10 = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+        const __m128 r11 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+        const __m128 r12 = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+        const __m128 r20 = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+        const __m128 r21 = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+        const __m128 r22 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+
+        __m128 model[4][4] = {
+            { _mm_mul_ps(sx, r00), _mm_mul_ps(sy, r01), _mm_mul_ps(sz, r02), zero },
+            { _mm_mul_ps(sx, r10), _mm_mul_ps(sy, r11), _mm_mul_ps(sz, r12), zero },
+            { _mm_mul_ps(sx, r20), _mm_mul_ps(sy, r21), _mm_mul_ps(sz, r22), zero },
+            { _mm_loadu_ps(&batch_.positionX[i]), _mm_loadu_ps(&batch_.positionY[i]), _mm_loadu_ps(&batch_.positionZ[i]), one },
+        };
+
+        if (out_.mvps) {
+            __m128 mvp[4][4];
+            for (int c = 0; c < 4; ++c) {
+                for (int r = 0; r < 4; ++r) {
+                    __m128 sum = _mm_mul_ps(_mm_set1_ps(out_.viewProj[r]), model[c][0]);
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(out_.viewProj[4 + r]), model[c][1]));
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(out_.viewProj[8 + r]), model[c][2]));
+                    mvp[c][r] = c == 3 ? _mm_add_ps(sum, _mm_set1_ps(out_.viewProj[12 + r])) : sum;
+                }
+                _MM_TRANSPOSE4_PS(mvp[c][0], mvp[c][1], mvp[c][2], mvp[c][3]);
+                for (int lane = 0; lane < 4; ++lane) {
+                    _mm_storeu_ps(out_.mvps + size_t(i + lane) * 16 + c * 4, mvp[c][lane]);
+                }
+            }
+        }
+        if (out_.normals) {
+            const __m128 invX = _mm_div_ps(one, sx), invY = _mm_div_ps(one, sy), invZ = _mm_div_ps(one, sz);
+            __m128 normal[3][4] = {
+                { _mm_mul_ps(r00, invX), _mm_mul_ps(r01, invY), _mm_mul_ps(r02, invZ), zero },
+                { _mm_mul_ps(r10, invX), _mm_mul_ps(r11, invY), _mm_mul_ps(r12, invZ), zero },
+                { _mm_mul_ps(r20, invX), _mm_mul_ps(r21, invY), _mm_mul_ps(r22, invZ), zero },
+            };
+            for (int c = 0; c < 3; ++c) {
+                _MM_TRANSPOSE4_PS(normal[c][0], normal[c][1], normal[c][2], normal[c][3]);
+                for (int lane = 0; lane < 4; ++lane) {
+                    _mm_storeu_ps(out_.normals + size_t(i + lane) * 12 + c * 4, normal[c][lane]);
+                }
+            }
+        }
+        for (int c = 0; c < 4; ++c) {
+            _MM_TRANSPOSE4_PS(model[c][0], model[c][1], model[c][2], model[c][3]);
+            for (int lane = 0; lane < 4; ++lane) {
+                _mm_storeu_ps(out_.models + size_t(i + lane) * 16 + c * 4, model[c][lane]);
+            }
+        }
+    }
+    return end;
+}
+
+void MultiplySse2(const float* lhs_, const float* rhs_, float* out_, uint32_t count_) {
+    const __m128 l0 = _mm_loadu_ps(lhs_), l1 = _mm_loadu_ps(lhs_ + 4), l2 = _mm_loadu_ps(lhs_ + 8), l3 = _mm_loadu_ps(lhs_ + 12);
+    for (uint32_t i = 0; i < count_; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            const __m128 column = _mm_loadu_ps(rhs_ + size_t(i) * 16 + c * 4);
+            __m128 sum = _mm_mul_ps(l0, _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(l1, _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1))));
+            sum = _mm_add_ps(sum, _mm_mul_ps(l2, _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2))));
+            sum = _mm_add_ps(sum, _mm_mul_ps(l3, _mm_shuffle_ps(column, column, _MM_SHUFFLE(3, 3, 3, 3))));
+            _mm_storeu_ps(out_ + size_t(i) * 16 + c * 4, sum);
+        }
+    }
+}
+
+/// Transposes 8 registers holding one matrix element each into 8 registers holding 8
+/// consecutive floats of one output matrix each
+VKENGINE_TARGET_AVX2 inline void Transpose8x8(__m256 (&rows_)[8]) {
+    const __m256 t0 = _mm256_unpacklo_ps(rows_[0], rows_[1]), t1 = _mm256_unpackhi_ps(rows_[0], rows_[1]);
+    const __m256 t2 = _mm256_unpacklo_ps(rows_[2], rows_[3]), t3 = _mm256_unpackhi_ps(rows_[2], rows_[3]);
+    const __m256 t4 = _mm256_unpacklo_ps(rows_[4], rows_[5]), t5 = _mm256_unpackhi_ps(rows_[4], rows_[5]);
+    const __m256 t6 = _mm256_unpacklo_ps(rows_[6], rows_[7]), t7 = _mm256_unpackhi_ps(rows_[6], rows_[7]);
+    const __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)), u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)), u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0)), u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0)), u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+    rows_[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+    rows_[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+    rows_[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+    rows_[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+    rows_[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+    rows_[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+    rows_[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+    rows_[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+}
+
+/// Stores 16 element registers (8 lanes) as 8 column-major 4x4 matrices
+VKENGINE_TARGET_AVX2 inline void StoreMatrices8(const __m256 (&elements_)[16], float* out_) {
+    for (int half = 0; half < 2; ++half) {
+        __m256 rows[8];
+        std::copy(elements_ + half * 8, elements_ + half * 8 + 8, rows);
+        Transpose8x8(rows);
+        for (int lane = 0; lane < 8; ++lane) {
+            _mm256_storeu_ps(out_ + lane * 16 + half * 8, rows[lane]);
+        }
+    }
+}
+
+// Same math as ComposeSse2 over 8 lanes
+VKENGINE_TARGET_AVX2 uint32_t ComposeAvx2(const TransformBatch& batch_, uint32_t count_, const ComposeOutputs& out_) {
+    const uint32_t end = count_ & ~7u;
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    for (uint32_t i = 0; i < end; i += 8) {
+        const __m256 x = _mm256_loadu_ps(&batch_.rotationX[i]);
+        const __m256 y = _mm256_loadu_ps(&batch_.rotationY[i]);
+        const __m256 z = _mm256_loadu_ps(&batch_.rotationZ[i]);
+        const __m256 w = _mm256_loadu_ps(&batch_.rotationW[i]);
+        const __m256 sx = _mm256_loadu_ps(&batch_.scaleX[i]);
+        const __m256 sy = _mm256_loadu_ps(&batch_.scaleY[i]);
+        const __m256 sz = _mm256_loadu_ps(&batch_.scaleZ[i]);
+
+        const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+        const __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+        const __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+        const __m256 r00 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz)));
+        const __m256 r01 = _mm256_mul_ps(two, _mm256_add_ps(xy, wz));
+        const __m256 r02 = _mm256_mul_ps(two, _mm256_sub_ps(xz, wy));
+        const __m256 r10 = _mm256_mul_ps(two, _mm256_sub_ps(xy, wz));
+        const __m256 r11 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz)));
+        const __m256 r12 = _mm256_mul_ps(two, _mm256_add_ps(yz, wx));
+        const __m256 r20 = _mm256_mul_ps(two, _mm256_add_ps(xz, wy));
+        const __m256 r21 = _mm256_mul_ps(two, _mm256_sub_ps(yz, wx));
+        const __m256 r22 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy)));
+
+        const __m256 model[16] = {
+            _mm256_mul_ps(sx, r00), _mm256_mul_ps(sy, r01), _mm256_mul_ps(sz, r02), zero,
+            _mm256_mul_ps(sx, r10), _mm256_mul_ps(sy, r11), _mm256_mul_ps(sz, r12), zero,
+            _mm256_mul_ps(sx, r20), _mm256_mul_ps(sy, r21), _mm256_mul_ps(sz, r22), zero,
+            _mm256_loadu_ps(&batch_.positionX[i]), _mm256_loadu_ps(&batch_.positionY[i]), _mm256_loadu_ps(&batch_.positionZ[i]), one,
+        };
+        StoreMatrices8(model, out_.models + size_t(i) * 16);
+
+        if (out_.mvps) {
+            __m256 mvp[16];
+            for (int c = 0; c < 4; ++c) {
+                for (int r = 0; r < 4; ++r) {
+                    __m256 sum = _mm256_mul_ps(_mm256_set1_ps(out_.viewProj[r]), model[c * 4]);
+                    sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(out_.viewProj[4 + r]), model[c * 4 + 1]));
+                    sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(out_.viewProj[8 + r]), model[c * 4 + 2]));
+                    mvp[c * 4 + r] = c == 3 ? _mm256_add_ps(sum, _mm256_set1_ps(out_.viewProj[12 + r])) : sum;
+                }
+            }
+            StoreMatrices8(mvp, out_.mvps + size_t(i) * 16);
+        }
+        if (out_.normals) {
+            const __m256 invX = _mm256_div_ps(one, sx), invY = _mm256_div_ps(one, sy), invZ = _mm256_div_ps(one, sz);
+            // Columns 0-1 are 8 floats per matrix; column 2 is 4 more, transposed per 128-bit half
+            __m256 rows[8] = {
+                _mm256_mul_ps(r00, invX), _mm256_mul_ps(r01, invY), _mm256_mul_ps(r02, invZ), zero,
+                _mm256_mul_ps(r10, invX), _mm256_mul_ps(r11, invY), _mm256_mul_ps(r12, invZ), zero,
+            };
+            Transpose8x8(rows);
+            const __m256 c0 = _mm256_mul_ps(r20, invX), c1 = _mm256_mul_ps(r21, invY), c2 = _mm256_mul_ps(r22, invZ);
+            __m128 low[4] = { _mm256_castps256_ps128(c0), _mm256_castps256_ps128(c1), _mm256_castps256_ps128(c2), _mm_setzero_ps() };
+            __m128 high[4] = { _mm256_extractf128_ps(c0, 1), _mm256_extractf128_ps(c1, 1), _mm256_extractf128_ps(c2, 1), _mm_setzero_ps() };
+            _MM_TRANSPOSE4_PS(low[0], low[1], low[2], low[3]);
+            _MM_TRANSPOSE4_PS(high[0], high[1], high[2], high[3]);
+            float* normals = out_.normals + size_t(i) * 12;
+            for (int lane = 0; lane < 8; ++lane) {
+                _mm256_storeu_ps(normals + lane * 12, rows[lane]);
+                _mm_storeu_ps(normals + lane * 12 + 8, lane < 4 ? low[lane] : high[lane - 4]);
+            }
+        }
+    }
+    return end;
+}
+
+// Two output columns per 256-bit register, each half multiplied by the same lhs column
+VKENGINE_TARGET_AVX2 void MultiplyAvx2(const float* lhs_, const float* rhs_, float* out_, uint32_t count_) {
+    const __m256 l0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs_));
+    const __m256 l1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs_ + 4));
+    const __m256 l2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs_ + 8));
+    const __m256 l3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs_ + 12));
+    for (uint32_t i = 0; i < count_; ++i) {
+        for (int c = 0; c < 4; c += 2) {
+            const __m256 columns = _mm256_loadu_ps(rhs_ + size_t(i) * 16 + c * 4);
+            __m256 sum = _mm256_mul_ps(l0, _mm256_permute_ps(columns, 0x00));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(l1, _mm256_permute_ps(columns, 0x55)));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(l2, _mm256_permute_ps(columns, 0xAA)));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(l3, _mm256_permute_ps(columns, 0xFF)));
+            _mm256_storeu_ps(out_ + size_t(i) * 16 + c * 4, sum);
+        }
+    }
+}
+
+bool CpuSupportsAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    const bool osUsesXsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    // The OS must also save the upper halves of the ymm registers on context switches
+    if (!osUsesXsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+std::atomic<SimdLevel> activeLevel = GetSupportedSimdLevel();
+
+} // namespace
+
+SimdLevel GetSupportedSimdLevel() {
+#if defined(VKENGINE_SIMD_X64)
+    static const SimdLevel level = CpuSupportsAvx2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel GetSimdLevel() {
+    return activeLevel.load(std::memory_order_relaxed);
+}
+
+void SetSimdLevel(SimdLevel level_) {
+    activeLevel.store(std::min(level_, GetSupportedSimdLevel()), std::memory_order_relaxed);
+}
+
+const char* GetSimdLevelName(SimdLevel level_) {
+    switch (level_) {
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::AVX2: return "AVX2";
+        default: return "Scalar";
+    }
+}
+
+void ComposeTransforms(const TransformBatch& batch_, glm::mat4* models_, glm::mat3x4* normals_, const glm::mat4& viewProj_, glm::mat4* mvps_) {
+    const uint32_t count = batch_.GetSize();
+    if (count == 0) return;
+
+    const ComposeOutputs out = {
+        &models_[0][0][0],
+        normals_ ? &normals_[0][0][0] : nullptr,
+        &viewProj_[0][0],
+        mvps_ ? &mvps_[0][0][0] : nullptr,
+    };
+    uint32_t done = 0;
+#if defined(VKENGINE_SIMD_X64)
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX2: done = ComposeAvx2(batch_, count, out); break;
+        case SimdLevel::SSE2: done = ComposeSse2(batch_, count, out); break;
+        default: break;
+    }
+#endif
+    // Remainder that does not fill a whole register
+    ComposeScalar(batch_, done, count, out);
+}
+
+void MultiplyMatrices(const glm::mat4& lhs_, const glm::mat4* rhs_, glm::mat4* out_, uint32_t count_) {
+    if (count_ == 0) return;
+
+    const float* lhs = &lhs_[0][0];
+    const float* rhs = &rhs_[0][0][0];
+    float* out = &out_[0][0][0];
+    switch (GetSimdLevel()) {
+#if defined(VKENGINE_SIMD_X64)
+        case SimdLevel::AVX2: MultiplyAvx2(lhs, rhs, out, count_); break;
+        case SimdLevel::SSE2: MultiplySse2(lhs, rhs, out, count_); break;
+#endif
+        default: MultiplyScalar(lhs, rhs, out, count_); break;
+    }
+}
+
+bool VerifyTransformKernels() {
+    // Odd count so every SIMD level also runs its scalar remainder
+    constexpr uint32_t kCount = 67;
+    constexpr float kTolerance = 1e-4f;
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.1f, 4.0f);
+
+    TransformBatch batch;
+    std::vector<glm::mat4> expectedModels, expectedMvps;
+    std::vector<glm::mat3> expectedNormals;
+    const glm::mat4 viewProj = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f) *
+                               glm::lookAt(glm::vec3(3.0f, 2.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    for (uint32_t i = 0; i < kCount; ++i) {
+        const glm::vec3 p(position(rng), position(rng), position(rng));
+        const glm::quat q = glm::normalize(glm::quat(unit(rng), unit(rng), unit(rng), unit(rng)));
+        const glm::vec3 s(scale(rng), scale(rng), scale(rng));
+        batch.Push(p, q, s);
+
+        // Same composition as TransformComponent::GetTransformMatrix()
+        const glm::mat4 model = glm::translate(glm::mat4(1.0f), p) * (glm::scale(glm::mat4(1.0f), s) * glm::mat4_cast(q));
+        expectedModels.push_back(model);
+        expectedNormals.push_back(glm::transpose(glm::inverse(glm::mat3(model))));
+        expectedMvps.push_back(viewProj * model);
+    }
+
+    // Relative to the magnitude of the expected value, since MVPs reach the hundreds
+    auto matches = [&](const float* actual_, const float* expected_, int count_) {
+        for (int k = 0; k < count_; ++k) {
+            if (std::abs(actual_[k] - expected_[k]) > kTolerance * std::max(1.0f, std::abs(expected_[k]))) return false;
+        }
+        return true;
+    };
+
+    const SimdLevel previous = GetSimdLevel();
+    bool passed = true;
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2 }) {
+        if (level > GetSupportedSimdLevel()) break;
+        SetSimdLevel(level);
+
+        std::vector<glm::mat4> models(kCount), mvps(kCount), products(kCount);
+        std::vector<glm::mat3x4> normals(kCount);
+        ComposeTransforms(batch, models.data(), normals.data(), viewProj, mvps.data());
+        MultiplyMatrices(viewProj, expectedModels.data(), products.data(), kCount);
+
+        for (uint32_t i = 0; i < kCount && passed; ++i) {
+            const glm::mat3x4 expectedNormal(glm::vec4(expectedNormals[i][0], 0.0f), glm::vec4(expectedNormals[i][1], 0.0f),
+                                             glm::vec4(expectedNormals[i][2], 0.0f));
+            const char* kernel = !matches(&models[i][0][0], &expectedModels[i][0][0], 16) ? "model"
+                               : !matches(&normals[i][0][0], &expectedNormal[0][0], 12) ? "normal"
+                               : !matches(&mvps[i][0][0], &expectedMvps[i][0][0], 16) ? "MVP"
+                               : !matches(&products[i][0][0], &expectedMvps[i][0][0], 16) ? "multiply"
+                               : nullptr;
+            if (kernel) {
+                std::cerr << "Transform kernels: " << GetSimdLevelName(level) << " " << kernel << " matrix " << i
+                          << " differs from glm" << std::endl;
+                passed = false;
+            }
+        }
+    }
+    SetSimdLevel(previous);
+    return passed;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <vector>
+
+/// Instruction set used by the batched transform kernels
+enum class SimdLevel : uint8_t {
+    Scalar,
+    SSE2,
+    AVX2,
+};
+
+/// Structure-of-arrays translation/rotation/scale input for ComposeTransforms(). Each component
+/// lives in its own array, so one SIMD register holds the same component of 4 or 8 transforms
+/// and composing them needs no shuffles until the matrices are stored.
+struct TransformBatch {
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+    std::vector<float> scaleX, scaleY, scaleZ;
+
+    void Clear();
+    void Reserve(uint32_t count_);
+    void Push(const glm::vec3& position_, const glm::quat& rotation_, const glm::vec3& scale_);
+    [[nodiscard]] uint32_t GetSize() const { return static_cast<uint32_t>(positionX.size()); }
+};
+
+/// Writes the model matrix of every transform in the batch, composed as in
+/// TransformComponent::GetTransformMatrix() (translate * scale * rotate). Optionally also writes
+/// the normal matrix (inverse transpose of the upper 3x3, in std430 mat3 layout) and
+/// viewProj_ * model. Rotations must be unit quaternions.
+void ComposeTransforms(const TransformBatch& batch_, glm::mat4* models_, glm::mat3x4* normals_ = nullptr,
+                       const glm::mat4& viewProj_ = glm::mat4(1.0f), glm::mat4* mvps_ = nullptr);
+
+/// out_[i] = lhs_ * rhs_[i], e.g. MVPs from one view-projection and many world matrices
+void MultiplyMatrices(const glm::mat4& lhs_, const glm::mat4* rhs_, glm::mat4* out_, uint32_t count_);
+
+/// Best level this CPU supports, detected once
+[[nodiscard]] SimdLevel GetSupportedSimdLevel();
+/// Level the kernels currently dispatch to; the supported level unless overridden
+[[nodiscard]] SimdLevel GetSimdLevel();
+/// Selects a kernel level, clamped to what the CPU supports (e.g. to compare against scalar)
+void SetSimdLevel(SimdLevel level_);
+[[nodiscard]] const char* GetSimdLevelName(SimdLevel level_);
+
+/// Runs every supported level on random transforms and compares the results with the glm path
+/// used by TransformComponent. Logs the first mismatch and returns false if any level disagrees.
+bool VerifyTransformKernels();
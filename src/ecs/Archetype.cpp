@@ -0,0 +1,82 @@
+#include <ecs/Archetype.h>
+#include <algorithm>
+#include <new>
+
+Archetype::Archetype(std::vector<const ComponentTypeInfo*> types_) {
+    signature.reserve(types_.size());
+    columns.reserve(types_.size());
+    for (const ComponentTypeInfo* type : types_) {
+        signature.push_back(type->id);
+        columns.push_back({type, {}});
+    }
+}
+
+Archetype::~Archetype() {
+    while (size > 0) {
+        RemoveRow(size - 1);
+    }
+    for (Column& column : columns) {
+        for (std::byte* chunk : column.chunks) {
+            ::operator delete(chunk, std::align_val_t(column.type->alignment));
+        }
+    }
+}
+
+int32_t Archetype::FindColumn(ComponentTypeId type_) const {
+    // Signatures are sorted and typically hold a handful of types
+    const auto it = std::lower_bound(signature.begin(), signature.end(), type_);
+    return it != signature.end() && *it == type_ ? static_cast<int32_t>(it - signature.begin()) : -1;
+}
+
+uint32_t Archetype::GetChunkSize(uint32_t chunk_) const {
+    return std::min(kRowsPerChunk, size - chunk_ * kRowsPerChunk);
+}
+
+void* Archetype::GetComponent(uint32_t column_, uint32_t row_) const {
+    const Column& column = columns[column_];
+    return column.chunks[row_ / kRowsPerChunk] + size_t(row_ % kRowsPerChunk) * column.type->size;
+}
+
+void Archetype::AddChunk() {
+    for (Column& column : columns) {
+        const size_t bytes = size_t(kRowsPerChunk) * column.type->size;
+        column.chunks.push_back(static_cast<std::byte*>(::operator new(bytes, std::align_val_t(column.type->alignment))));
+    }
+    chunkCapacity++;
+}
+
+void Archetype::Reserve(uint32_t rows_) {
+    while (chunkCapacity * kRowsPerChunk < rows_) {
+        AddChunk();
+    }
+    entities.reserve(rows_);
+}
+
+uint32_t Archetype::AppendRow(Entity entity_) {
+    if (size == chunkCapacity * kRowsPerChunk) {
+        AddChunk();
+    }
+    entities.push_back(entity_);
+    return size++;
+}
+
+Entity Archetype::RemoveRow(uint32_t row_) {
+    const uint32_t last = size - 1;
+    for (uint32_t c = 0; c < columns.size(); ++c) {
+        const ComponentTypeInfo& type = *columns[c].type;
+        type.destroy(GetComponent(c, row_));
+        if (row_ != last) {
+            type.moveConstruct(GetComponent(c, row_), GetComponent(c, last));
+            type.destroy(GetComponent(c, last));
+        }
+    }
+
+    Entity moved;
+    if (row_ != last) {
+        entities[row_] = entities[last];
+        moved = entities[row_];
+    }
+    entities.pop_back();
+    size--;
+    return moved;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <ecs/ComponentType.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// Generational entity handle; stale handles to destroyed entities are detected, never reused
+struct Entity {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    [[nodiscard]] bool IsValid() const { return index != UINT32_MAX; }
+    bool operator==(const Entity& other_) const = default;
+};
+
+/// All entities with exactly the same set of component types. Each component type is a column
+/// (structure of arrays) split into fixed-size chunks, so appending a row never moves existing
+/// components, and iteration walks contiguous memory per column.
+class Archetype {
+public:
+    static constexpr uint32_t kRowsPerChunk = 256;
+
+    /// types_ must be sorted by id and free of duplicates
+    explicit Archetype(std::vector<const ComponentTypeInfo*> types_);
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    [[nodiscard]] const std::vector<ComponentTypeId>& GetSignature() const { return signature; }
+    [[nodiscard]] const ComponentTypeInfo& GetType(uint32_t column_) const { return *columns[column_].type; }
+    [[nodiscard]] uint32_t GetColumnCount() const { return static_cast<uint32_t>(columns.size()); }
+    /// Column index of the type, or -1 when the archetype does not have it
+    [[nodiscard]] int32_t FindColumn(ComponentTypeId type_) const;
+
+    [[nodiscard]] uint32_t GetSize() const { return size; }
+    [[nodiscard]] uint32_t GetChunkCount() const { return (size + kRowsPerChunk - 1) / kRowsPerChunk; }
+    [[nodiscard]] uint32_t GetChunkSize(uint32_t chunk_) const;
+    /// First component of column_ in chunk_; rows within a chunk are contiguous
+    [[nodiscard]] void* GetChunkData(uint32_t column_, uint32_t chunk_) const { return columns[column_].chunks[chunk_]; }
+    [[nodiscard]] void* GetComponent(uint32_t column_, uint32_t row_) const;
+    [[nodiscard]] Entity GetEntity(uint32_t row_) const { return entities[row_]; }
+
+    /// Allocates chunks up front so the next rows_ - GetSize() appends do not touch the heap
+    void Reserve(uint32_t rows_);
+    /// Reserves a row for entity_; its components are left unconstructed for the caller
+    uint32_t AppendRow(Entity entity_);
+    /// Destroys the row's components and moves the last row into the hole.
+    /// Returns the entity that now occupies row_, or an invalid entity if it was the last row.
+    Entity RemoveRow(uint32_t row_);
+
+    /// Cached archetype transitions, keyed by the component type added or removed
+    std::unordered_map<ComponentTypeId, Archetype*> addEdges;
+    std::unordered_map<ComponentTypeId, Archetype*> removeEdges;
+
+private:
+    struct Column {
+        const ComponentTypeInfo* type;
+        std::vector<std::byte*> chunks;
+    };
+
+    std::vector<ComponentTypeId> signature;
+    std::vector<Column> columns;
+    std::vector<Entity> entities;
+    uint32_t size = 0;
+    /// Chunks stay allocated when rows are removed and are refilled by later appends
+    uint32_t chunkCapacity = 0;
+
+    void AddChunk();
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <components/BaseComponent.h>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+using ComponentTypeId = uint64_t;
+
+namespace detail {
+
+template<typename T>
+constexpr std::string_view RawTypeName() {
+#if defined(_MSC_VER)
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+}
+
+constexpr uint64_t Fnv1a64(std::string_view text_) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (char c : text_) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+} // namespace detail
+
+/// Compile-time component type ID: a hash of the compiler's spelling of the type, so it needs no
+/// registration, is the same in every translation unit and can be used in constant expressions
+template<typename T>
+inline constexpr ComponentTypeId kComponentTypeId = detail::Fnv1a64(detail::RawTypeName<std::remove_cv_t<T>>());
+
+/// Type-erased operations an archetype column needs to store components of one type
+struct ComponentTypeInfo {
+    ComponentTypeId id;
+    uint32_t size;
+    uint32_t alignment;
+    /// Move-constructs *src_ into uninitialized dst_
+    void (*moveConstruct)(void* dst_, void* src_);
+    void (*destroy)(void* object_);
+    /// The component as a BaseComponent, or nullptr for plain data components
+    BaseComponent* (*asBase)(void* object_);
+
+    template<typename T>
+    static const ComponentTypeInfo& Get() {
+        static_assert(std::is_move_constructible_v<T>, "Components are relocated between archetypes and must be movable");
+        static const ComponentTypeInfo info = {
+            kComponentTypeId<T>,
+            static_cast<uint32_t>(sizeof(T)),
+            static_cast<uint32_t>(alignof(T)),
+            [](void* dst_, void* src_) { new (dst_) T(std::move(*static_cast<T*>(src_))); },
+            [](void* object_) { static_cast<T*>(object_)->~T(); },
+            [](void* object_) -> BaseComponent* {
+                if constexpr (std::is_base_of_v<BaseComponent, T>) {
+                    return static_cast<BaseComponent*>(static_cast<T*>(object_));
+                } else {
+                    return nullptr;
+                }
+            },
+        };
+        return info;
+    }
+};
@@ -0,0 +1,173 @@
+#include <ecs/World.h>
+#include <algorithm>
+
+World::World() {
+    emptyArchetype = GetOrCreateArchetype({});
+}
+
+World::~World() {
+    // Archetypes destroy their remaining components
+    archetypes.clear();
+}
+
+World& World::GetDefault() {
+    static World world;
+    return world;
+}
+
+Entity World::CreateEntity() {
+    return AllocateEntity(emptyArchetype);
+}
+
+Entity World::AllocateEntity(Archetype* archetype_) {
+    uint32_t index;
+    if (!freeIndices.empty()) {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    } else {
+        index = static_cast<uint32_t>(records.size());
+        records.emplace_back();
+    }
+
+    const Entity entity = { index, records[index].generation };
+    records[index].archetype = archetype_;
+    records[index].row = archetype_->AppendRow(entity);
+    entityCount++;
+    return entity;
+}
+
+void World::DestroyEntity(Entity entity_) {
+    EntityRecord* record = FindRecord(entity_);
+    if (!record) return;
+
+    const Entity moved = record->archetype->RemoveRow(record->row);
+    if (moved.IsValid()) {
+        records[moved.index].row = record->row;
+    }
+    record->archetype = nullptr;
+    record->generation++;
+    freeIndices.push_back(entity_.index);
+    entityCount--;
+}
+
+void World::ReserveEntities(Archetype& archetype_, uint32_t count_) {
+    archetype_.Reserve(archetype_.GetSize() + count_);
+    if (count_ > freeIndices.size()) {
+        records.reserve(records.size() + count_ - freeIndices.size());
+    }
+}
+
+void World::DestroyEntities(std::span<const Entity> entities_) {
+    freeIndices.reserve(freeIndices.size() + entities_.size());
+    for (Entity entity : entities_) {
+        DestroyEntity(entity);
+    }
+}
+
+bool World::IsAlive(Entity entity_) const {
+    return FindRecord(entity_) != nullptr;
+}
+
+const World::EntityRecord* World::FindRecord(Entity entity_) const {
+    if (entity_.index >= records.size()) return nullptr;
+    const EntityRecord& record = records[entity_.index];
+    return record.archetype && record.generation == entity_.generation ? &record : nullptr;
+}
+
+World::EntityRecord* World::FindRecord(Entity entity_) {
+    return const_cast<EntityRecord*>(std::as_const(*this).FindRecord(entity_));
+}
+
+void* World::GetComponentById(Entity entity_, ComponentTypeId type_) const {
+    const EntityRecord* record = FindRecord(entity_);
+    if (!record) return nullptr;
+    const int32_t column = record->archetype->FindColumn(type_);
+    return column >= 0 ? record->archetype->GetComponent(static_cast<uint32_t>(column), record->row) : nullptr;
+}
+
+void* World::AddComponentStorage(Entity entity_, const ComponentTypeInfo& type_) {
+    EntityRecord* record = FindRecord(entity_);
+    if (!record) return nullptr;
+
+    Archetype* from = record->archetype;
+    const int32_t existing = from->FindColumn(type_.id);
+    if (existing >= 0) {
+        void* storage = from->GetComponent(static_cast<uint32_t>(existing), record->row);
+        type_.destroy(storage);
+        return storage;
+    }
+
+    Archetype*& to = from->addEdges[type_.id];
+    if (!to) {
+        std::vector<const ComponentTypeInfo*> types;
+        for (uint32_t c = 0; c < from->GetColumnCount(); ++c) {
+            types.push_back(&from->GetType(c));
+        }
+        types.insert(std::upper_bound(types.begin(), types.end(), type_.id,
+                                      [](ComponentTypeId id, const ComponentTypeInfo* t) { return id < t->id; }), &type_);
+        to = GetOrCreateArchetype(std::move(types));
+        to->removeEdges[type_.id] = from;
+    }
+
+    MoveEntity(entity_, *record, to);
+    return to->GetComponent(static_cast<uint32_t>(to->FindColumn(type_.id)), record->row);
+}
+
+void World::RemoveComponentById(Entity entity_, ComponentTypeId type_) {
+    EntityRecord* record = FindRecord(entity_);
+    if (!record || record->archetype->FindColumn(type_) < 0) return;
+
+    Archetype* from = record->archetype;
+    Archetype*& to = from->removeEdges[type_];
+    if (!to) {
+        std::vector<const ComponentTypeInfo*> types;
+        for (uint32_t c = 0; c < from->GetColumnCount(); ++c) {
+            if (from->GetType(c).id != type_) types.push_back(&from->GetType(c));
+        }
+        to = GetOrCreateArchetype(std::move(types));
+        to->addEdges[type_] = from;
+    }
+    MoveEntity(entity_, *record, to);
+}
+
+void World::RemoveAllComponents(Entity entity_) {
+    EntityRecord* record = FindRecord(entity_);
+    if (!record || record->archetype == emptyArchetype) return;
+    MoveEntity(entity_, *record, emptyArchetype);
+}
+
+void World::MoveEntity(Entity entity_, EntityRecord& record_, Archetype* to_) {
+    Archetype* from = record_.archetype;
+    const uint32_t newRow = to_->AppendRow(entity_);
+    for (uint32_t c = 0; c < from->GetColumnCount(); ++c) {
+        const ComponentTypeInfo& type = from->GetType(c);
+        const int32_t target = to_->FindColumn(type.id);
+        if (target >= 0) {
+            type.moveConstruct(to_->GetComponent(static_cast<uint32_t>(target), newRow), from->GetComponent(c, record_.row));
+        }
+    }
+
+    // Destroys the moved-from (or dropped) components and fills the hole
+    const Entity moved = from->RemoveRow(record_.row);
+    if (moved.IsValid()) {
+        records[moved.index].row = record_.row;
+    }
+    record_.archetype = to_;
+    record_.row = newRow;
+}
+
+Archetype* World::GetOrCreateArchetype(std::vector<const ComponentTypeInfo*> types_) {
+    std::vector<ComponentTypeId> signature;
+    signature.reserve(types_.size());
+    for (const ComponentTypeInfo* type : types_) {
+        signature.push_back(type->id);
+    }
+
+    auto it = archetypeLookup.find(signature);
+    if (it != archetypeLookup.end()) {
+        return it->second;
+    }
+    Archetype* archetype = archetypes.emplace_back(std::make_unique<Archetype>(std::move(types_))).get();
+    archetypeLookup.emplace(std::move(signature), archetype);
+    return archetype;
+}
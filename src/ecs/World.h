@@ -0,0 +1,175 @@
+#pragma once
+#include <ecs/Archetype.h>
+#include <ecs/ComponentType.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// Archetype-based entity/component storage. Components live by value in contiguous per-type
+/// columns grouped by the entity's exact component set, and systems iterate them with ForEach.
+///
+/// Component pointers stay valid until the entity gains or loses a component, or another entity
+/// of the same archetype is destroyed (its last row is moved into the hole). Structural changes
+/// are not allowed inside ForEach.
+class World {
+public:
+    World();
+    ~World();
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    /// The world used by Actors constructed without an explicit one
+    static World& GetDefault();
+
+    Entity CreateEntity();
+    /// Destroys the entity's components and invalidates the handle
+    void DestroyEntity(Entity entity_);
+    [[nodiscard]] bool IsAlive(Entity entity_) const;
+
+    /// Bulk spawn: creates out_.size() entities straight into the archetype of Ts, each component
+    /// copy-constructed from its prototype. Skips the per-component archetype moves AddComponent
+    /// would do, and allocates storage once for the whole batch.
+    template<typename... Ts>
+    void CreateEntities(std::span<Entity> out_, const Ts&... prototypes_) {
+        Archetype* archetype = GetOrCreateArchetype(SortedTypes<Ts...>());
+        const uint32_t columns[] = { static_cast<uint32_t>(archetype->FindColumn(kComponentTypeId<Ts>))... };
+        ReserveEntities(*archetype, static_cast<uint32_t>(out_.size()));
+        for (Entity& entity : out_) {
+            entity = AllocateEntity(archetype);
+            const uint32_t row = records[entity.index].row;
+            size_t i = 0;
+            ((new (archetype->GetComponent(columns[i++], row)) Ts(prototypes_)), ...);
+        }
+    }
+
+    /// Bulk despawn; stale handles are ignored
+    void DestroyEntities(std::span<const Entity> entities_);
+
+    /// Constructs T on the entity, replacing an existing T; nullptr if the entity is stale or dead
+    template<typename T, typename... Args>
+    T* AddComponent(Entity entity_, Args&&... args_) {
+        void* storage = AddComponentStorage(entity_, ComponentTypeInfo::Get<T>());
+        if (!storage) return nullptr;
+        return new (storage) T(std::forward<Args>(args_)...);
+    }
+
+    /// The entity's T (exact type, no derived-type lookup), or nullptr
+    template<typename T>
+    [[nodiscard]] T* GetComponent(Entity entity_) const {
+        return static_cast<T*>(GetComponentById(entity_, kComponentTypeId<T>));
+    }
+
+    template<typename T>
+    [[nodiscard]] bool HasComponent(Entity entity_) const {
+        return GetComponentById(entity_, kComponentTypeId<T>) != nullptr;
+    }
+
+    template<typename T>
+    void RemoveComponent(Entity entity_) {
+        RemoveComponentById(entity_, kComponentTypeId<T>);
+    }
+
+    void RemoveAllComponents(Entity entity_);
+
+    /// Calls func_(BaseComponent*) for each of the entity's components derived from BaseComponent
+    template<typename F>
+    void ForEachComponent(Entity entity_, F&& func_) const {
+        const EntityRecord* record = FindRecord(entity_);
+        if (!record) return;
+        for (uint32_t c = 0; c < record->archetype->GetColumnCount(); ++c) {
+            if (BaseComponent* component = record->archetype->GetType(c).asBase(record->archetype->GetComponent(c, record->row))) {
+                func_(component);
+            }
+        }
+    }
+
+    /// Calls func_(Entity, Ts&...) for every entity that has all of Ts, walking each matching
+    /// archetype chunk by chunk so every column is read sequentially
+    template<typename... Ts, typename F>
+    void ForEach(F&& func_) {
+        static constexpr ComponentTypeId kTypes[] = { kComponentTypeId<Ts>... };
+        for (const std::unique_ptr<Archetype>& archetype : archetypes) {
+            if (archetype->GetSize() == 0) continue;
+
+            int32_t columns[sizeof...(Ts)];
+            bool matches = true;
+            for (size_t i = 0; i < sizeof...(Ts) && matches; ++i) {
+                columns[i] = archetype->FindColumn(kTypes[i]);
+                matches = columns[i] >= 0;
+            }
+            if (matches) {
+                ForEachInArchetype<Ts...>(*archetype, columns, func_, std::index_sequence_for<Ts...>{});
+            }
+        }
+    }
+
+    /// Registers a per-world system (such as the transform hierarchy) for actors and components
+    /// to look up by type; the caller keeps ownership
+    template<typename T>
+    void SetSystem(T* system_) { systems[kComponentTypeId<T>] = system_; }
+
+    template<typename T>
+    [[nodiscard]] T* GetSystem() const {
+        const auto it = systems.find(kComponentTypeId<T>);
+        return it != systems.end() ? static_cast<T*>(it->second) : nullptr;
+    }
+
+    [[nodiscard]] uint32_t GetEntityCount() const { return entityCount; }
+    [[nodiscard]] uint32_t GetArchetypeCount() const { return static_cast<uint32_t>(archetypes.size()); }
+
+private:
+    struct EntityRecord {
+        Archetype* archetype = nullptr;
+        uint32_t row = 0;
+        uint32_t generation = 0;
+    };
+
+    template<typename... Ts>
+    static std::vector<const ComponentTypeInfo*> SortedTypes() {
+        std::vector<const ComponentTypeInfo*> types = { &ComponentTypeInfo::Get<Ts>()... };
+        std::sort(types.begin(), types.end(), [](const ComponentTypeInfo* a, const ComponentTypeInfo* b) { return a->id < b->id; });
+        return types;
+    }
+
+    template<typename... Ts, typename F, size_t... Is>
+    static void ForEachInArchetype(Archetype& archetype_, const int32_t* columns_, F& func_, std::index_sequence<Is...>) {
+        for (uint32_t chunk = 0; chunk < archetype_.GetChunkCount(); ++chunk) {
+            const uint32_t firstRow = chunk * Archetype::kRowsPerChunk;
+            const uint32_t rows = archetype_.GetChunkSize(chunk);
+            std::tuple<Ts*...> data = { static_cast<Ts*>(archetype_.GetChunkData(static_cast<uint32_t>(columns_[Is]), chunk))... };
+            for (uint32_t r = 0; r < rows; ++r) {
+                func_(archetype_.GetEntity(firstRow + r), std::get<Is>(data)[r]...);
+            }
+        }
+    }
+
+    Entity AllocateEntity(Archetype* archetype_);
+    void ReserveEntities(Archetype& archetype_, uint32_t count_);
+    [[nodiscard]] const EntityRecord* FindRecord(Entity entity_) const;
+    EntityRecord* FindRecord(Entity entity_);
+    [[nodiscard]] void* GetComponentById(Entity entity_, ComponentTypeId type_) const;
+    /// Moves the entity to the archetype with type_ added and returns the unconstructed slot for it
+    void* AddComponentStorage(Entity entity_, const ComponentTypeInfo& type_);
+    void RemoveComponentById(Entity entity_, ComponentTypeId type_);
+    /// Relocates the components both archetypes share; the rest are destroyed (from_) or left unconstructed (to_)
+    void MoveEntity(Entity entity_, EntityRecord& record_, Archetype* to_);
+    Archetype* GetOrCreateArchetype(std::vector<const ComponentTypeInfo*> types_);
+
+    std::vector<EntityRecord> records;
+    std::vector<uint32_t> freeIndices;
+    uint32_t entityCount = 0;
+
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::map<std::vector<ComponentTypeId>, Archetype*> archetypeLookup;
+    Archetype* emptyArchetype = nullptr;
+
+    std::unordered_map<ComponentTypeId, void*> systems;
+};
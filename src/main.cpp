@@ -9,144 +9,160 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/cimport.h>
-#include <stb_image.h>
 #include <iostream>
+#include <cmath>
 #include <vector>
 #include <fstream>
 #include <filesystem>
 #include <memory>
+#include <array>
+#include <algorithm>
+#include <optional>
+#include <thread>
+#include <unordered_set>
 
 // Component system includes
+#include <bench/Benchmark.h>
 #include <components/Actor.h>
+#include <core/Pool.h>
+#include <core/Profiler.h>
+#include <core/TransformKernels.h>
 #include <components/TransformComponent.h>
+#include <components/TransformHierarchy.h>
 #include <components/MeshComponent.h>
 #include <components/CameraComponent.h>
+#include <assets/AssetRegistry.h>
+#include <renderer/Bloom.h>
+#include <renderer/DynamicResolution.h>
+#include <renderer/FramePipeline.h>
+#include <renderer/GpuProfiler.h>
+#include <renderer/HiZPyramid.h>
+#include <renderer/IndirectRenderer.h>
+#include <renderer/PipelineCache.h>
+#include <renderer/PipelineLibrary.h>
+#include <renderer/PostStack.h>
+#include <renderer/RenderGraph.h>
+#include <renderer/SceneCulling.h>
 
 // ImGui includes
 #include <imgui.h>
 #include <lvk/HelpersImGui.h>
 #include <float.h> // For FLT_MAX
 
-std::string ReadFile(const std::filesystem::path& shader_path) {
-    if (!std::filesystem::exists(shader_path) || !std::filesystem::is_regular_file(shader_path)) {
-        return {};
-    }
-
-    std::ifstream file(shader_path, std::ios::binary);
-    if (!file.is_open()) {
-        return {};
-    }
-
-    file.seekg(0, std::ios::end);
-    const auto file_size = file.tellg();
-    file.seekg(0, std::ios::beg);
+// MeshBuffers struct is now defined in assets/AssetRegistry.h
+// Mesh and texture loading goes through AssetRegistry
 
-    std::string content;
-    content.reserve(static_cast<size_t>(file_size));
-    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+int main(int argc, char *argv[]) {
+    // Start-up phases are frame 0 of the profiler, kept for export for the whole run
+    Profiler::Get().SetThreadName("Main");
     
-    return content;
-}
-
-// Helper function for texture loading (still needed for rendering)
-lvk::Holder<lvk::TextureHandle> LoadTexture(lvk::IContext* ctx, const char* fileName) {
-    int width, height, channels;
-    unsigned char* data = stbi_load(fileName, &width, &height, &channels, 4); // Force RGBA
-    if (!data) {
-        std::cerr << "Failed to load texture: " << fileName << std::endl;
-        return {};
+    // --bench renders a fixed stress scene headless, along a fixed camera path, and writes the frame
+    // time percentiles to a JSON file instead of opening a window
+    BenchmarkOptions benchOptions;
+    if (!ParseBenchmarkOptions(argc, argv, benchOptions)) {
+        return -1;
     }
+    const bool bench = benchOptions.enabled;
     
-    auto texture = ctx->createTexture({
-        .type = lvk::TextureType_2D,
-        .format = lvk::Format_RGBA_SRGB8, // Use sRGB for color textures
-        .dimensions = {static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1},
-        .usage = lvk::TextureUsageBits_Sampled,
-        .data = data,
-        .debugName = fileName
-    });
-    
-    stbi_image_free(data);
-    return texture;
-}
-
-// Vertex structure with position, normal, and texture coordinates
-struct Vertex {
-    glm::vec3 position;
-    glm::vec3 normal;
-    glm::vec2 texCoord;
-};
-
-// MeshBuffers struct is now defined in MeshComponent.h
-// UploadMesh function is now part of MeshComponent class
-
-int main(int argc, char *argv[]) {
-    glfwInit();
+    ProfileScope startupZone("Start-up");
+    ProfileScope contextZone("Start-up: window and context");
     int width{-70};
     int height{-70};
-    GLFWwindow *window = lvk::initWindow("VKEngine", width, height, false);
-    
-    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-    std::unique_ptr<lvk::IContext> ctx = lvk::createVulkanContextWithSwapchain(window, width, height, {});
-    
-    // Initialize ImGui exactly like the cookbook
-    std::unique_ptr<lvk::ImGuiRenderer> imgui = std::make_unique<lvk::ImGuiRenderer>(*ctx);
-    
-    // GLFW input callbacks exactly like the cookbook
-    glfwSetCursorPosCallback(window, [](auto* window, double x, double y) { 
-        ImGui::GetIO().MousePos = ImVec2(x, y); 
-    });
-    glfwSetMouseButtonCallback(window, [](auto* window, int button, int action, int mods) {
-        double xpos, ypos;
-        glfwGetCursorPos(window, &xpos, &ypos);
-        const ImGuiMouseButton_ imguiButton = (button == GLFW_MOUSE_BUTTON_LEFT)
-                                                  ? ImGuiMouseButton_Left
-                                                  : (button == GLFW_MOUSE_BUTTON_RIGHT ? ImGuiMouseButton_Right : ImGuiMouseButton_Middle);
-        ImGuiIO& io = ImGui::GetIO();
-        io.MousePos = ImVec2((float)xpos, (float)ypos);
-        io.MouseDown[imguiButton] = action == GLFW_PRESS;
-    });
-    glfwSetKeyCallback(window, [](auto* window, int key, int scancode, int action, int mods) {
-        if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
-            glfwSetWindowShouldClose(window, GLFW_TRUE);
-        }
-    });
-    
-    // Simple setup like cookbook
+    GLFWwindow *window = nullptr;
+    if (bench) {
+        width = static_cast<int>(benchOptions.width);
+        height = static_cast<int>(benchOptions.height);
+    } else {
+        glfwInit();
+        window = lvk::initWindow("VKEngine", width, height, false);
+        glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+    }
+    // GLFW is not initialized in benchmark mode, so frame timing uses the profiler clock there
+    auto getTime = [bench] { return bench ? Profiler::Get().Now() * 1e-6 : glfwGetTime(); };
     
     // Change to parent directory if we're in cmake-build-debug
     if (std::filesystem::current_path().filename() == "cmake-build-debug") {
         std::filesystem::current_path("..");
     }
     
-    // Load texture for rendering
-    auto skullColor = LoadTexture(ctx.get(), "assets/skull/textures/skullColor.png");
-    if (!skullColor.valid()) {
-        std::cerr << "ERROR: Failed to load skull texture!" << std::endl;
+    // Pipelines compiled by earlier runs are handed to the driver before anything is created
+    const PipelineCacheData pipelineCache = LoadPipelineCache(kPipelineCachePath);
+    lvk::ContextConfig contextConfig;
+    contextConfig.pipelineCacheData = pipelineCache.data.data();
+    contextConfig.pipelineCacheDataSize = pipelineCache.data.size();
+    std::string deviceName;
+    std::unique_ptr<lvk::IContext> ctx = bench ? CreateHeadlessContext(contextConfig, deviceName)
+                                               : lvk::createVulkanContextWithSwapchain(window, width, height, contextConfig);
+    if (!ctx) {
         return -1;
     }
-    std::cout << "Skull texture loaded successfully, index: " << skullColor.index() << std::endl;
-    
-    // Load noise texture for fog effects
-    auto noise = LoadTexture(ctx.get(), "assets/noise/512x512/Super Perlin/Super Perlin 9 - 512x512.png");
-    if (!noise.valid()) {
-        std::cerr << "ERROR: Failed to load Gabor noise texture!" << std::endl;
-        return -1;
+    if (IsPipelineCacheCompatible(ctx.get(), pipelineCache)) {
+        std::cout << "Pipeline cache: warm start (" << pipelineCache.data.size() << " bytes)" << std::endl;
+    } else {
+        std::cout << "Pipeline cache: cold start" << (pipelineCache.IsEmpty() ? "" : " (saved by another device or driver)") << std::endl;
     }
-    std::cout << "Gabor noise texture loaded successfully, index: " << noise.index() << std::endl;
-
-    auto noise2 = LoadTexture(ctx.get(), "assets/noise/512x512/Swirl/Swirl 6 - 512x512.png");
-    if (!noise2.valid()) {
-        std::cerr << "ERROR: Failed to load Gabor noise texture!" << std::endl;
-        return -1;
+    
+    // Initialize ImGui exactly like the cookbook; the benchmark draws no overlay
+    std::unique_ptr<lvk::ImGuiRenderer> imgui = bench ? nullptr : std::make_unique<lvk::ImGuiRenderer>(*ctx);
+    contextZone.End();
+    
+    // GLFW input callbacks exactly like the cookbook
+    if (window) {
+        glfwSetCursorPosCallback(window, [](auto* window, double x, double y) { 
+            ImGui::GetIO().MousePos = ImVec2(x, y); 
+        });
+        glfwSetMouseButtonCallback(window, [](auto* window, int button, int action, int mods) {
+            double xpos, ypos;
+            glfwGetCursorPos(window, &xpos, &ypos);
+            const ImGuiMouseButton_ imguiButton = (button == GLFW_MOUSE_BUTTON_LEFT)
+                                                      ? ImGuiMouseButton_Left
+                                                      : (button == GLFW_MOUSE_BUTTON_RIGHT ? ImGuiMouseButton_Right : ImGuiMouseButton_Middle);
+            ImGuiIO& io = ImGui::GetIO();
+            io.MousePos = ImVec2((float)xpos, (float)ypos);
+            io.MouseDown[imguiButton] = action == GLFW_PRESS;
+        });
+        glfwSetKeyCallback(window, [](auto* window, int key, int scancode, int action, int mods) {
+            if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
+                glfwSetWindowShouldClose(window, GLFW_TRUE);
+            }
+        });
     }
-    std::cout << "Gabor noise texture loaded successfully, index: " << noise2.index() << std::endl;
+    
+    // Simple setup like cookbook
+    
+    ProfileScope sceneZone("Start-up: scene");
+    // Every mesh and texture is loaded through the registry, so repeated paths share one GPU copy
+    std::unique_ptr<AssetRegistry> assets = std::make_unique<AssetRegistry>(ctx.get());
+    
+    // Noise textures for fog effects; decoded in the background, placeholders until then
+    TextureRef noise = assets->RequestTexture("assets/noise/512x512/Super Perlin/Super Perlin 9 - 512x512.png");
+    TextureRef noise2 = assets->RequestTexture("assets/noise/512x512/Swirl/Swirl 6 - 512x512.png");
     
     // Component System Example
     std::cout << "\n=== Component System Demo ===" << std::endl;
     
+    // Transform math runs through the batched SIMD kernels; check them against glm in debug builds
+    std::cout << "Transform kernels: " << GetSimdLevelName(GetSimdLevel()) << std::endl;
+#if defined(DEBUG_MODE)
+    if (!VerifyTransformKernels()) {
+        std::cerr << "Transform kernels disagree with glm, falling back to scalar" << std::endl;
+        SetSimdLevel(SimdLevel::Scalar);
+    }
+#endif
+    
+    // Actors store their components in the default ECS world; the main pass iterates it directly.
+    // World matrices are cached per node in the transform hierarchy, which actors join in OnCreate.
+    World& world = World::GetDefault();
+    TransformHierarchy transforms(world);
+    world.SetSystem(&transforms);
+    
+    // Actors live in a slab pool and are owned through generational handles; declared after the
+    // registry and the hierarchy so any actor still alive on an early return is destroyed before them
+    Pool<Actor> actors;
+    
     // Create a skull actor with components
-    Actor* skullActor = new Actor();
+    const Handle<Actor> skullHandle = actors.Create();
+    Actor* skullActor = actors.Get(skullHandle);
     
     // Add transform component
     skullActor->AddComponent<TransformComponent>(skullActor, 
@@ -156,16 +172,17 @@ int main(int argc, char *argv[]) {
     );
     
     // Add mesh component
-    skullActor->AddComponent<MeshComponent>(skullActor, ctx.get(), "assets/skull/source/skull.fbx");
+    skullActor->AddComponent<MeshComponent>(skullActor, assets.get(), "assets/skull/source/skull.fbx", "assets/skull/textures/skullColor.png");
     
-    // Initialize the actor
+    // Initialize the actor (starts loading its assets in the background)
     if (!skullActor->OnCreate()) {
         std::cerr << "Failed to create skull actor" << std::endl;
         return -1;
     }
     
     // Create a second actor (another skull) next to the first one
-    Actor* skullActor2 = new Actor();
+    const Handle<Actor> skullHandle2 = actors.Create();
+    Actor* skullActor2 = actors.Get(skullHandle2);
     
     // Add transform component for the second skull
     skullActor2->AddComponent<TransformComponent>(skullActor2, 
@@ -175,7 +192,7 @@ int main(int argc, char *argv[]) {
     );
     
     // Add mesh component for the second skull
-    skullActor2->AddComponent<MeshComponent>(skullActor2, ctx.get(), "assets/skull/source/skull.fbx");
+    skullActor2->AddComponent<MeshComponent>(skullActor2, assets.get(), "assets/skull/source/skull.fbx", "assets/skull/textures/skullColor.png");
     
     // Initialize the second actor
     if (!skullActor2->OnCreate()) {
@@ -183,6 +200,16 @@ int main(int argc, char *argv[]) {
         return -1;
     }
     
+    // The benchmark adds its instances around the demo skulls and flies the camera over them
+    StressScene stressScene;
+    std::optional<CameraSpline> cameraPath;
+    if (bench) {
+        stressScene = CreateStressScene(actors, assets.get(), benchOptions);
+        cameraPath = CameraSpline::MakeFlyover(stressScene, benchOptions.seed);
+        std::cout << "Benchmark: " << benchOptions.instances << " instances, " << benchOptions.width << "x"
+                  << benchOptions.height << " on " << deviceName << std::endl;
+    }
+    
     // List components for both actors
     std::cout << "\n=== First Skull Actor ===" << std::endl;
     skullActor->ListComponents();
@@ -205,11 +232,13 @@ int main(int argc, char *argv[]) {
     if (meshComp) {
         std::cout << "Mesh component has " << meshComp->GetMeshes().size() << " meshes" << std::endl;
     }
+    assets->LogStats();
     
     std::cout << "=== Component System Demo Complete ===\n" << std::endl;
 
     // Create camera actor
-    Actor* cameraActor = new Actor();
+    const Handle<Actor> cameraHandle = actors.Create();
+    Actor* cameraActor = actors.Get(cameraHandle);
     cameraActor->AddComponent<CameraComponent>(cameraActor, 45.0f, 16.0f/9.0f, 0.1f, 1000.0f);
     if (!cameraActor->OnCreate()) {
         std::cerr << "Failed to create camera actor" << std::endl;
@@ -236,152 +265,115 @@ int main(int argc, char *argv[]) {
         std::cerr << "No mesh component found!" << std::endl;
         return -1;
     }
-    const std::vector<MeshBuffers>& meshes = meshComp->GetMeshes();
-
-    // Create main rendering shaders
-    const std::string vertSource = ReadFile("shaders/blinn_phong.vert");
-    const std::string fragSource = ReadFile("shaders/blinn_phong.frag");
-    
-    const lvk::Holder<lvk::ShaderModuleHandle> vert = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{vertSource.c_str(), lvk::Stage_Vert, "vert shader"}, nullptr);
-    const lvk::Holder<lvk::ShaderModuleHandle> frag = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{fragSource.c_str(), lvk::Stage_Frag, "frag shader"}, nullptr);
-    
-    // Load post-processing shaders
-    const std::string postVertSource = ReadFile("shaders/post.vert");
-    const lvk::Holder<lvk::ShaderModuleHandle> postVert = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{postVertSource.c_str(), lvk::Stage_Vert, "post vert shader"}, nullptr);
-    
-    // Load all post-processing fragment shaders
-    const std::string nopostFragSource = ReadFile("shaders/nopost.frag");
-    const std::string crtFragSource = ReadFile("shaders/CRT-dynamic.frag");
-    const std::string bloomFragSource = ReadFile("shaders/bloom.frag");
-    const std::string dreamFragSource = ReadFile("shaders/dream.frag");
-    const std::string glitchFragSource = ReadFile("shaders/glitch.frag");
-    const std::string pixelFragSource = ReadFile("shaders/pixelation.frag");
-    const std::string fogFragSource = ReadFile("shaders/fog.frag");
-    const std::string underwaterFragSource = ReadFile("shaders/underwater.frag");
-    const std::string ditheringFragSource = ReadFile("shaders/dithering.frag");
-    const std::string posterizationFragSource = ReadFile("shaders/posterization.frag");
+    // The render thread holds its own references to the skull assets and resolves them through the
+    // registry; the component itself belongs to the game thread once it starts
+    const MeshRef skullMesh = meshComp->GetMesh();
+    const TextureRef skullTexture = meshComp->GetTexture();
 
-    const lvk::Holder<lvk::ShaderModuleHandle> nopostFrag = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{nopostFragSource.c_str(), lvk::Stage_Frag, "nopost frag shader"}, nullptr);
-    const lvk::Holder<lvk::ShaderModuleHandle> crtFrag = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{crtFragSource.c_str(), lvk::Stage_Frag, "crt frag shader"}, nullptr);
-    const lvk::Holder<lvk::ShaderModuleHandle> bloomFrag = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{bloomFragSource.c_str(), lvk::Stage_Frag, "bloom frag shader"}, nullptr);
-    const lvk::Holder<lvk::ShaderModuleHandle> dreamFrag = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{dreamFragSource.c_str(), lvk::Stage_Frag, "dream frag shader"}, nullptr);
-    const lvk::Holder<lvk::ShaderModuleHandle> glitchFrag = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{glitchFragSource.c_str(), lvk::Stage_Frag, "glitch frag shader"}, nullptr);
-    const lvk::Holder<lvk::ShaderModuleHandle> pixelFrag = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{pixelFragSource.c_str(), lvk::Stage_Frag, "pixel frag shader"}, nullptr);
-    const lvk::Holder<lvk::ShaderModuleHandle> fogFrag = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{fogFragSource.c_str(), lvk::Stage_Frag, "fog frag shader"}, nullptr);
-    const lvk::Holder<lvk::ShaderModuleHandle> underwaterFrag = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{underwaterFragSource.c_str(), lvk::Stage_Frag, "underwater frag shader"}, nullptr);
-    const lvk::Holder<lvk::ShaderModuleHandle> ditheringFrag = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{ditheringFragSource.c_str(), lvk::Stage_Frag, "dithering frag shader"}, nullptr);
-    const lvk::Holder<lvk::ShaderModuleHandle> posterizationFrag = ctx->createShaderModule(
-        lvk::ShaderModuleDesc{posterizationFragSource.c_str(), lvk::Stage_Frag, "posterization frag shader"}, nullptr);
-    
-    // Create pipeline with texture support
-    const lvk::VertexInput vdesc = {
-        .attributes    = { 
-            { .location = 0, .format = lvk::VertexFormat::Float3, .offset = offsetof(Vertex, position) },
-            { .location = 1, .format = lvk::VertexFormat::Float3, .offset = offsetof(Vertex, normal) },
-            { .location = 2, .format = lvk::VertexFormat::Float2, .offset = offsetof(Vertex, texCoord) }
-        },
-        .inputBindings = { { .stride = sizeof(Vertex) } },
-    };
-    
-    lvk::Holder<lvk::RenderPipelineHandle> pipeline = ctx->createRenderPipeline({
-        .vertexInput = vdesc,
-        .smVert      = vert,
-        .smFrag      = frag,
-        .color       = { { .format = ctx->getSwapchainFormat() } },
-        .depthFormat = lvk::Format_Z_F32,
-        .cullMode    = lvk::CullMode_Back,
-        .debugName   = "Main Pipeline",
-    });
-    
-    // Create post-processing pipelines following cookbook pattern
-    lvk::Holder<lvk::RenderPipelineHandle> pipelineToneMap = ctx->createRenderPipeline({
-        .smVert = postVert,
-        .smFrag = nopostFrag,
-        .color  = { { .format = ctx->getSwapchainFormat() } },
-    });
+    sceneZone.End();
     
-    lvk::Holder<lvk::RenderPipelineHandle> pipelineCRT = ctx->createRenderPipeline({
-        .smVert = postVert,
-        .smFrag = crtFrag,
-        .color  = { { .format = ctx->getSwapchainFormat() } },
-    });
+    // The benchmark renders into an offscreen target of its own instead of the swapchain
+    const lvk::Format outputFormat = bench ? lvk::Format_RGBA_UN8 : ctx->getSwapchainFormat();
+    lvk::Holder<lvk::TextureHandle> benchTarget;
+    if (bench) {
+        benchTarget = ctx->createTexture({
+            .format     = outputFormat,
+            .dimensions = { benchOptions.width, benchOptions.height, 1 },
+            .usage      = lvk::TextureUsageBits_Attachment | lvk::TextureUsageBits_Sampled,
+            .debugName  = "Benchmark target",
+        });
+    }
+
+    // Shaders and pipelines are created the first time a frame uses them; the rest are built
+    // in the background of later frames (see the Prewarm call after submit)
+    ProfileScope pipelinesZone("Start-up: pipelines");
+    PipelineLibrary pipelines(ctx.get());
     
-    lvk::Holder<lvk::RenderPipelineHandle> pipelineBloom = ctx->createRenderPipeline({
-        .smVert = postVert,
-        .smFrag = bloomFrag,
-        .color  = { { .format = ctx->getSwapchainFormat() } },
-    });
+    // Main pipeline with texture support; the vertex layout is whatever the registry uploads
+    const lvk::VertexInput vdesc = GetVertexInput(assets->GetVertexLayout());
+    const uint32_t packedVertices = assets->GetVertexLayout() == VertexLayout::Packed ? 1 : 0;
+    const lvk::SpecializationConstantDesc vertexLayoutSpec = {
+        .entries  = { { .constantId = 0, .size = sizeof(packedVertices) } },
+        .data     = &packedVertices,
+        .dataSize = sizeof(packedVertices),
+    };
     
-    lvk::Holder<lvk::RenderPipelineHandle> pipelineDream = ctx->createRenderPipeline({
-        .smVert = postVert,
-        .smFrag = dreamFrag,
-        .color  = { { .format = ctx->getSwapchainFormat() } },
+    const PipelineId pipeline = pipelines.AddRenderPipeline({
+        .vertexShader   = "shaders/blinn_phong.vert",
+        .fragmentShader = "shaders/blinn_phong.frag",
+        .vertexInput    = vdesc,
+        .specInfo       = vertexLayoutSpec,
+        .colorFormat    = outputFormat,
+        .depthFormat    = lvk::Format_Z_F32,
+        .cullMode       = lvk::CullMode_Back,
+        .debugName      = "Main Pipeline",
     });
     
-    lvk::Holder<lvk::RenderPipelineHandle> pipelineGlitch = ctx->createRenderPipeline({
-        .smVert = postVert,
-        .smFrag = glitchFrag,
-        .color  = { { .format = ctx->getSwapchainFormat() } },
+    // GPU-driven variant: per-instance data comes from a storage buffer instead of push constants
+    const PipelineId pipelineIndirect = pipelines.AddRenderPipeline({
+        .vertexShader   = "shaders/blinn_phong_indirect.vert",
+        .fragmentShader = "shaders/blinn_phong.frag",
+        .vertexInput    = vdesc,
+        .specInfo       = vertexLayoutSpec,
+        .colorFormat    = outputFormat,
+        .depthFormat    = lvk::Format_Z_F32,
+        .cullMode       = lvk::CullMode_Back,
+        .debugName      = "Main Pipeline (indirect)",
     });
     
-    lvk::Holder<lvk::RenderPipelineHandle> pipelinePixel = ctx->createRenderPipeline({
-        .smVert = postVert,
-        .smFrag = pixelFrag,
-        .color  = { { .format = ctx->getSwapchainFormat() } },
-    });
-
-    lvk::Holder<lvk::RenderPipelineHandle> pipelineFog = ctx->createRenderPipeline({
-        .smVert = postVert,
-        .smFrag = fogFrag,
-        .color  = { { .format = ctx->getSwapchainFormat() } },
-    });
-
-    lvk::Holder<lvk::RenderPipelineHandle> pipelineUnderwater = ctx->createRenderPipeline({
-        .smVert = postVert,
-        .smFrag = underwaterFrag,
-        .color  = { { .format = ctx->getSwapchainFormat() } },
-    });
-
-    lvk::Holder<lvk::RenderPipelineHandle> pipelineDithering = ctx->createRenderPipeline({
-        .smVert = postVert,
-        .smFrag = ditheringFrag,
-        .color  = { { .format = ctx->getSwapchainFormat() } },
-    });
-
-    lvk::Holder<lvk::RenderPipelineHandle> pipelinePosterization = ctx->createRenderPipeline({
-        .smVert = postVert,
-        .smFrag = posterizationFrag,
-        .color  = { { .format = ctx->getSwapchainFormat() } },
-    });
+    // GPU culling: per-instance frustum and Hi-Z occlusion tests, compacted into the indirect commands.
+    // Both run every frame, so they are compiled up front.
+    IndirectRenderer indirectRenderer(ctx.get());
+    indirectRenderer.SetCullShader(pipelines.GetShaderModule("shaders/cull_instances.comp"));
+    SceneCulling culling(world, transforms);
+    HiZPyramid hiz(ctx.get(), pipelines.GetShaderModule("shaders/hiz_build.comp"));
     
-    // Create intermediate framebuffer for post-processing (following cookbook pattern)
-    const lvk::Dimensions sizeFb = ctx->getDimensions(ctx->getCurrentSwapchainTexture());
+    // Push constants for post-processing
+    struct PostPushConstants {
+        uint32_t texColor;
+        uint32_t smpl;
+        float time;
+        uint32_t noise;
+        uint32_t noise2;
+        uint32_t noiseFlags; // TextureFlagBits of noise, then of noise2 shifted by 8
+        uint32_t bloom;      // result of the bloom chain, for passes starting with Bloom
+        float bloomIntensity;
+    };
     
-    lvk::Holder<lvk::TextureHandle> intermediateTexture = ctx->createTexture({
-        .format     = ctx->getSwapchainFormat(),
-        .dimensions = sizeFb,
-        .usage      = lvk::TextureUsageBits_Attachment | lvk::TextureUsageBits_Sampled,
-        .debugName  = "Intermediate Texture",
-    });
+    // Every frame is declared as a render graph; the scene targets and the post-processing chain are
+    // transient textures from its pool, so they follow the window size and stacked effects share them
+    RenderGraph renderGraph(ctx.get());
+    // Threshold and downsample/upsample chain the bloom effect composites
+    Bloom bloom(ctx.get(), pipelines);
+    // Every effect lives in one über shader; stacked effects share a pass where they can
+    PostStack postStack(pipelines, outputFormat, sizeof(PostPushConstants));
+    // The scene renders below native resolution when the GPU misses its frame time budget
+    DynamicResolution dynamicResolution(pipelines, outputFormat);
+    // Times the whole frame and every render graph pass; the frame time drives dynamic resolution
+    GpuProfiler gpuProfiler(ctx.get());
     
-    lvk::Holder<lvk::TextureHandle> intermediateDepth = ctx->createTexture({
-        .format     = lvk::Format_Z_F32,
-        .dimensions = sizeFb,
-        .usage      = lvk::TextureUsageBits_Attachment,
-        .debugName  = "Intermediate Depth",
-    });
+    // Post-processing effects that can be stacked, applied in the order they were added
+    struct PostEffect {
+        const char* name;
+        PostEffectType type;
+    };
+    const std::array postEffects = {
+        PostEffect{ "CRT Dynamic", PostEffectType::CRT },
+        PostEffect{ "Bloom", PostEffectType::Bloom },
+        PostEffect{ "Dream", PostEffectType::Dream },
+        PostEffect{ "Glitch", PostEffectType::Glitch },
+        PostEffect{ "Pixelation", PostEffectType::Pixelation },
+        PostEffect{ "Fog", PostEffectType::Fog },
+        PostEffect{ "Underwater", PostEffectType::Underwater },
+        PostEffect{ "Dithering", PostEffectType::Dithering },
+        PostEffect{ "Posterization", PostEffectType::Posterization },
+    };
+    // Copies the scene to the swapchain when no effect is selected
+    const PostEffect noPostEffect = { "No Post-Processing", PostEffectType::ToneMap };
+    auto getPostEffectName = [&](PostEffectType type) {
+        const auto it = std::find_if(postEffects.begin(), postEffects.end(), [&](const PostEffect& effect) { return effect.type == type; });
+        return it != postEffects.end() ? it->name : noPostEffect.name;
+    };
     
     // Create sampler for textures (following cookbook pattern)
     lvk::Holder<lvk::SamplerHandle> sampler = ctx->createSampler({
@@ -390,210 +382,664 @@ int main(int argc, char *argv[]) {
         .wrapW = lvk::SamplerWrap_Clamp,
     });
 
+    // Scene textures carry full mip chains (cooked or generated on upload)
+    lvk::Holder<lvk::SamplerHandle> samplerMips = ctx->createSampler({
+        .mipMap = lvk::SamplerMip_Linear,
+        .wrapU = lvk::SamplerWrap_Repeat,
+        .wrapV = lvk::SamplerWrap_Repeat,
+        .wrapW = lvk::SamplerWrap_Repeat,
+        .debugName = "Sampler: mipmapped",
+    });
+
+    // Simulation runs one frame ahead on a game thread while this thread records and submits the
+    // frame before it. GLFW events and input, asset uploads and everything touching the GPU stay here.
+    int initialWidth = width, initialHeight = height;
+    if (window) {
+        glfwGetFramebufferSize(window, &initialWidth, &initialHeight);
+    }
+    FrameInput frameInput = {
+        .framebufferWidth  = static_cast<uint32_t>(std::max(initialWidth, 1)),
+        .framebufferHeight = static_cast<uint32_t>(std::max(initialHeight, 1)),
+    };
+    FramePipeline framePipeline(frameInput);
+    
+    // Owns the actors, the hierarchy and culling until it is joined below
+    std::thread gameThread([&] {
+        Profiler::Get().SetThreadName("Game");
+        double lastTime = getTime();
+        uint64_t frameIndex = 0;
+        // Assets already pinned by the snapshot being filled
+        std::unordered_set<const void*> pinnedAssets;
+        while (FrameSnapshot* snapshot = framePipeline.BeginSimulation()) {
+            VKENGINE_PROFILE_ZONE("Simulation");
+            const FrameInput& input = snapshot->input;
+            
+            // Calculate delta time; the benchmark steps at a fixed rate so every run simulates the same frames
+            const double currentTime = getTime();
+            const float deltaTime = bench ? 1.0f / 60.0f : static_cast<float>(currentTime - lastTime);
+            lastTime = currentTime;
+            
+            // One lap of the camera path over the measured frames; warm-up frames hold its start
+            if (cameraPath && camera) {
+                const float measuredFrame = static_cast<float>(std::max<int64_t>(
+                    static_cast<int64_t>(frameIndex) - static_cast<int64_t>(benchOptions.warmupFrames), 0));
+                camera->SetLookAt(cameraPath->Evaluate(measuredFrame / static_cast<float>(benchOptions.frames)),
+                                  stressScene.center, glm::vec3(0.0f, 1.0f, 0.0f));
+            }
+            
+            const float ratio = input.framebufferWidth / (float)input.framebufferHeight;
+            
+            // Update camera with new aspect ratio
+            if (camera) {
+                camera->SetPerspective(45.0f, ratio, 0.1f, 1000.0f);
+                
+                // Debug: Print camera position every 60 frames (about once per second); the
+                // benchmark keeps stdout out of its measured frames
+                if (!bench && frameIndex % 60 == 59) {
+                    std::cout << "Camera position: " << camera->GetPosition().x << ", " 
+                              << camera->GetPosition().y << ", " << camera->GetPosition().z << std::endl;
+                }
+            } else {
+                static bool cameraNullWarning = false;
+                if (!cameraNullWarning) {
+                    std::cout << "WARNING: Camera is null!" << std::endl;
+                    cameraNullWarning = true;
+                }
+            }
+            {
+                VKENGINE_PROFILE_ZONE("Update actors");
+                actors.ForEach([&](Handle<Actor>, Actor& actor) { actor.Update(deltaTime); });
+            }
+            
+            // Get camera matrices
+            const glm::mat4 v = camera ? camera->GetViewMatrix() : glm::mat4(1.0f);
+            const glm::mat4 p = camera ? camera->GetProjectionMatrix() : glm::perspective(45.0f, ratio, 0.1f, 1000.0f);
+            const glm::mat4 viewProj = camera ? camera->GetViewProjectionMatrix() : p * v;
+            
+            // Recompute only the subtrees that moved and hand the changed matrices to the render thread
+            transforms.Update();
+            culling.Update();
+            transforms.CaptureChanges(snapshot->transforms);
+            transforms.ClearChanges();
+            
+            // Only submeshes whose bounds touch the view frustum are drawn by either path
+            culling.SetEnabled(input.frustumCulling);
+            const float fovy = camera ? camera->GetFovY() : 45.0f;
+            culling.SetLodSettings({
+                .enabled         = input.lodSelection,
+                .cameraPosition  = camera ? camera->GetPosition() : glm::vec3(0.0f),
+                .projectionScale = static_cast<float>(input.framebufferHeight) * input.renderScale /
+                                   (2.0f * std::tan(glm::radians(fovy) * 0.5f)),
+                .maxPixelError   = input.lodPixelError,
+            });
+            {
+                VKENGINE_PROFILE_ZONE("Culling");
+                culling.Cull(viewProj);
+            }
+            
+            // Resolve everything recording needs now, so the render thread never reads components
+            snapshot->draws.clear();
+            pinnedAssets.clear();
+            for (const VisibleMesh& draw : culling.GetVisibleMeshes()) {
+                snapshot->draws.push_back({ draw.mesh, draw.lod, draw.transformNode,
+                                            draw.component->GetTextureHandle().index(), draw.component->GetTextureFlags() });
+                // Placeholders belong to the registry; loaded assets are pinned once per snapshot
+                const MeshRef& mesh = draw.component->GetMesh();
+                if (mesh && pinnedAssets.insert(mesh.get()).second) snapshot->pinnedMeshes.push_back(mesh);
+                const TextureRef& texture = draw.component->GetTexture();
+                if (texture && pinnedAssets.insert(texture.get()).second) snapshot->pinnedTextures.push_back(texture);
+            }
+            snapshot->frameIndex = frameIndex++;
+            snapshot->viewProj = viewProj;
+            snapshot->cullingStats = culling.GetStats();
+            snapshot->bvhHeight = culling.GetTree().GetHeight();
+            snapshot->simulationTime = static_cast<float>(getTime() - currentTime);
+            framePipeline.EndSimulation(snapshot);
+        }
+    });
+    
     // Main render loop
-    // Delta time tracking
-    double lastTime = glfwGetTime();
+    // World matrices as of the snapshot being recorded, for the per-draw fallback
+    std::vector<glm::mat4> worldMatrices;
+    // Per-node MVPs for the per-draw fallback, computed in one batch per frame
+    std::vector<glm::mat4> mvps;
+    // Recording and submission of the previous frame, shown next to the snapshot's simulation time
+    float renderTime = 0.0f;
+    
+    // Benchmark state: frames rendered so far, warm-up included, and the last submission. Without a
+    // swapchain nothing paces the CPU, so every benchmark frame waits for the one before it; the
+    // GPU profiler's query slots assume no more frames in flight than that.
+    BenchmarkRecorder benchRecorder;
+    uint32_t benchFrame = 0;
+    double lastFrameStart = 0.0;
+    lvk::SubmitHandle lastSubmit;
+    if (bench) {
+        // Loading is not part of the measurement
+        assets->WaitIdle();
+    }
+    
+    // Shader sources of everything not drawn yet are read while the first frames render
+    pipelines.StartPrewarm();
+    pipelinesZone.End();
+    startupZone.End();
+    Profiler::Get().EndFrame();
+    lastFrameStart = getTime();
 
-    while (!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
+    while (bench ? benchFrame < benchOptions.warmupFrames + benchOptions.frames : !glfwWindowShouldClose(window)) {
+        if (window) {
+            glfwPollEvents();
+        }
         
-        // Calculate delta time
-        double currentTime = glfwGetTime();
-        float deltaTime = static_cast<float>(currentTime - lastTime);
-        lastTime = currentTime;
+        // Finish a batch of background loads (GPU uploads must happen on this thread)
+        assets->ProcessUploads();
         
-        int currentWidth, currentHeight;
-        glfwGetFramebufferSize(window, &currentWidth, &currentHeight);
-        if (!currentWidth || !currentHeight) continue;
+        if (window) {
+            int currentWidth, currentHeight;
+            glfwGetFramebufferSize(window, &currentWidth, &currentHeight);
+            if (!currentWidth || !currentHeight) continue;
+            if (currentWidth != width || currentHeight != height) {
+                width = currentWidth;
+                height = currentHeight;
+                ctx->recreateSwapchain(width, height);
+            }
+            frameInput.framebufferWidth = static_cast<uint32_t>(currentWidth);
+            frameInput.framebufferHeight = static_cast<uint32_t>(currentHeight);
+        }
         
-        const float ratio = currentWidth / (float)currentHeight;
+        // The oldest simulated frame; waits only when the game thread is slower than recording
+        ProfileScope waitZone("Wait for simulation");
+        FrameSnapshot* frame = framePipeline.BeginRender();
+        waitZone.End();
+        ProfileScope recordZone("Record");
+        const double currentTime = getTime();
+        const glm::mat4& viewProj = frame->viewProj;
         
-        // Update camera with new aspect ratio
-        if (camera) {
-            camera->SetPerspective(45.0f, ratio, 0.1f, 1000.0f);
-            
-            
-            camera->Update(deltaTime);
-            
-            // Debug: Print camera position every 60 frames (about once per second)
-            static int frameCount = 0;
-            if (++frameCount % 60 == 0) {
-                std::cout << "Camera position: " << camera->GetPosition().x << ", " 
-                          << camera->GetPosition().y << ", " << camera->GetPosition().z << std::endl;
+        // Post-processing chain, indices into postEffects
+        static std::vector<uint32_t> effectChain;
+        // Runs stacked effects in as few über-shader passes as possible instead of one pass each
+        static bool fusePostEffects = true;
+        static BloomSettings bloomSettings;
+        static DynamicResolutionSettings resolutionSettings;
+        // GPU-driven submission: actors sharing a mesh become one instanced indirect draw
+        static bool gpuDriven = true;
+        static bool frustumCulling = true;
+        // Refines the CPU result on the GPU; occlusion needs the Hi-Z pyramid of the early pass
+        static bool gpuCulling = true;
+        static bool occlusionCulling = true;
+        // Screen-space-error level of detail for every drawn submesh
+        static bool lodSelection = true;
+        static float lodPixelError = 1.0f;
+        // The benchmark measures the same work on every device, at the requested resolution
+        if (bench) {
+            resolutionSettings.enabled = false;
+        }
+        
+        // Assets still loading resolve to the registry placeholders
+        const lvk::TextureHandle skullColor = assets->Resolve(skullTexture);
+        const lvk::TextureHandle noiseTexture = assets->Resolve(noise);
+        const lvk::TextureHandle noise2Texture = assets->Resolve(noise2);
+        
+        // The GPU copy is patched even while the fallback path is active so switching back never
+        // sees stale transforms
+        frame->transforms.Apply(worldMatrices);
+        indirectRenderer.UpdateTransforms(worldMatrices, frame->transforms.ranges);
+        
+        // The scene targets are a fraction of the output; the Hi-Z pyramid is sized like the scene
+        // depth it is reduced from, before the culling parameters reference it
+        const lvk::Dimensions outputSize = { frameInput.framebufferWidth, frameInput.framebufferHeight, 1 };
+        const float renderScale = dynamicResolution.GetScale();
+        const lvk::Dimensions sceneSize = RenderGraph::GetScaledSize(outputSize, renderScale);
+        hiz.Resize(sceneSize);
+        
+        if (gpuDriven) {
+            indirectRenderer.BeginFrame();
+            for (const SnapshotDraw& draw : frame->draws) {
+                indirectRenderer.AddInstance(assets->GetGeometry(), *draw.mesh, draw.lod, draw.transformNode,
+                                             draw.textureIndex, samplerMips.index(), draw.textureFlags);
             }
-        } else {
-            static bool cameraNullWarning = false;
-            if (!cameraNullWarning) {
-                std::cout << "WARNING: Camera is null!" << std::endl;
-                cameraNullWarning = true;
+            if (gpuCulling) {
+                const GpuCullingDesc cullingDesc = {
+                    .viewProj    = viewProj,
+                    .hiz         = occlusionCulling ? hiz.GetTexture() : lvk::TextureHandle{},
+                    .hizWidth    = hiz.GetWidth(),
+                    .hizHeight   = hiz.GetHeight(),
+                    .hizMipCount = hiz.GetMipCount(),
+                };
+                indirectRenderer.Upload(&cullingDesc);
+            } else {
+                indirectRenderer.Upload();
             }
         }
         
-        // Get camera matrices
-        const glm::mat4 v = camera ? camera->GetViewMatrix() : glm::mat4(1.0f);
-        const glm::mat4 p = camera ? camera->GetProjectionMatrix() : glm::perspective(45.0f, ratio, 0.1f, 1000.0f);
-        
-        // Post-processing effect selection
-        static int currentEffect = 0;
+        // Declare the frame: scene passes, the post-processing chain and ImGui. The graph then drops
+        // passes nothing uses and places the transient targets.
+        renderGraph.Reset(outputSize);
+        const RenderGraphTexture sceneColor = renderGraph.CreateTexture({
+            .format = outputFormat, .scale = renderScale, .debugName = "Scene color" });
+        // Sampled so the Hi-Z pyramid can be reduced from it
+        const RenderGraphTexture sceneDepth = renderGraph.CreateTexture({
+            .format = lvk::Format_Z_F32, .scale = renderScale, .debugName = "Scene depth" });
+        const RenderGraphTexture swapchain = bench ? renderGraph.ImportTexture(benchTarget, "Benchmark target")
+                                                   : renderGraph.ImportTexture(ctx->getCurrentSwapchainTexture(), "Swapchain");
+        const RenderGraphTexture skullColorInput = renderGraph.ImportTexture(skullColor, "Skull color");
+        const RenderGraphTexture noiseInput = renderGraph.ImportTexture(noiseTexture, "Noise");
+        const RenderGraphTexture noise2Input = renderGraph.ImportTexture(noise2Texture, "Noise 2");
+        renderGraph.MarkOutput(swapchain);
         
-        lvk::ICommandBuffer& cmd = ctx->acquireCommandBuffer();
-        {
-            // Render main scene to intermediate framebuffer
-            const lvk::RenderPass renderPassOffscreen = {
-                .color = { { .loadOp = lvk::LoadOp_Clear, .clearColor = { 0.2f, 0.3f, 0.4f, 1.0f } } },
-                .depth = { .loadOp = lvk::LoadOp_Clear, .clearDepth = 1.0f }
-            };
-            
-            const lvk::Framebuffer framebufferOffscreen = {
-                .color        = { { .texture = intermediateTexture } },
-                .depthStencil = { .texture = intermediateDepth },
-            };
-            
-            cmd.cmdBeginRendering(renderPassOffscreen, framebufferOffscreen, { 
-                .textures = { skullColor }
+        // Early phase: what was visible last frame, tested against the frustum only
+        if (gpuDriven) {
+            renderGraph.AddPass({ .name = "Cull (early)", .sideEffects = true }, [&](const RenderGraphPassContext& pass) {
+                indirectRenderer.Cull(pass.cmd, CullPhase::Early);
             });
-            
-            {
-                cmd.cmdBindRenderPipeline(pipeline);
+        }
+        
+        // Render main scene to its transient targets
+        renderGraph.AddPass({
+            .name         = "Scene",
+            .reads        = { skullColorInput },
+            .color        = { .texture = sceneColor, .clearColor = { 0.2f, 0.3f, 0.4f, 1.0f } },
+            .depth        = { .texture = sceneDepth, .clearDepth = 1.0f },
+            .dependencies = gpuDriven ? indirectRenderer.GetDrawDependencies() : lvk::Dependencies{},
+        }, [&](const RenderGraphPassContext& pass) {
+            lvk::ICommandBuffer& cmd = pass.cmd;
+            if (gpuDriven) {
+                cmd.cmdBindRenderPipeline(pipelines.GetRenderPipeline(pipelineIndirect));
+                cmd.cmdBindDepthState({ .compareOp = lvk::CompareOp_Less, .isDepthWriteEnabled = true });
+                indirectRenderer.Draw(cmd, assets->GetGeometry(), viewProj, CullPhase::Early);
+            } else {
+                cmd.cmdBindRenderPipeline(pipelines.GetRenderPipeline(pipeline));
                 cmd.cmdBindDepthState({ .compareOp = lvk::CompareOp_Less, .isDepthWriteEnabled = true });
                 
+                // All meshes live in the geometry arena: bind it once, rebinding only the index buffer when the width changes
+                const GeometryArena& geometry = assets->GetGeometry();
+                lvk::IndexFormat boundIndexFormat = lvk::IndexFormat_UI16;
+                geometry.Bind(cmd, boundIndexFormat);
+                auto drawMesh = [&](const MeshBuffers& mesh, uint32_t lod) {
+                    const GeometryRange range = mesh.GetLodRange(geometry.GetRange(mesh.geometry), lod);
+                    if (range.indexFormat != boundIndexFormat) {
+                        boundIndexFormat = range.indexFormat;
+                        cmd.cmdBindIndexBuffer(geometry.GetIndexBuffer(boundIndexFormat), boundIndexFormat);
+                    }
+                    cmd.cmdDrawIndexed(range.indexCount, 1, range.firstIndex, range.vertexOffset);
+                };
+                
                 struct PushConstants {
                     glm::mat4 mvp;
                     glm::mat4 model;
+                    glm::vec4 positionScale;  // packed position decode, per submesh
+                    glm::vec4 positionOffset;
                     uint32_t textureIndex;
-                    float _padding[3]; // Ensure 16-byte alignment
+                    uint32_t samplerIndex;
+                    uint32_t textureFlags; // TextureFlagBits
+                    float _padding[1]; // Ensure 16-byte alignment
                 };
                 
-                // Render first skull actor
-                const glm::mat4 m1 = skullActor->GetModelMatrix();
-                const glm::mat4 mvp1 = p * v * m1;
-                PushConstants pushConstants1 = { 
-                    mvp1, m1, skullColor.index(), {0.0f, 0.0f, 0.0f}
-                };
-                cmd.cmdPushConstants(pushConstants1);
+                const uint32_t nodeCount = static_cast<uint32_t>(worldMatrices.size());
+                mvps.resize(nodeCount);
+                MultiplyMatrices(viewProj, worldMatrices.data(), mvps.data(), nodeCount);
                 
-                for (const auto& mesh : meshes) {
-                    cmd.cmdBindVertexBuffer(0, mesh.vertexBuffer);
-                    cmd.cmdBindIndexBuffer(mesh.indexBuffer, lvk::IndexFormat_UI32);
-                    cmd.cmdDrawIndexed(mesh.indexCount);
+                // Per-draw fallback: one push constant block and draw per visible submesh
+                for (const SnapshotDraw& draw : frame->draws) {
+                    const PushConstants pushConstants = {
+                        mvps[draw.transformNode], worldMatrices[draw.transformNode], draw.mesh->positionScale,
+                        draw.mesh->positionOffset, draw.textureIndex, samplerMips.index(), draw.textureFlags, {0.0f}
+                    };
+                    cmd.cmdPushConstants(pushConstants);
+                    drawMesh(*draw.mesh, draw.lod);
                 }
+            }
+        });
+        
+        // Late phase: reduce the early depth into the Hi-Z pyramid, then draw whatever else passes
+        // against it on top of the early result
+        if (gpuDriven && indirectRenderer.IsGpuCulling()) {
+            const RenderGraphTexture hizPyramid = renderGraph.ImportTexture(hiz.GetTexture(), "Hi-Z pyramid");
+            if (occlusionCulling) {
+                renderGraph.AddPass({ .name = "Hi-Z build", .reads = { sceneDepth }, .writes = { hizPyramid } },
+                                    [&](const RenderGraphPassContext& pass) {
+                    hiz.Build(pass.cmd, renderGraph.GetTexture(sceneDepth));
+                });
+            }
+            renderGraph.AddPass({
+                .name        = "Cull (late)",
+                .reads       = occlusionCulling ? std::vector{ hizPyramid } : std::vector<RenderGraphTexture>{},
+                .sideEffects = true,
+            }, [&](const RenderGraphPassContext& pass) {
+                indirectRenderer.Cull(pass.cmd, CullPhase::Late);
+            });
+            renderGraph.AddPass({
+                .name         = "Scene (late)",
+                .reads        = { skullColorInput },
+                .color        = { .texture = sceneColor, .loadOp = lvk::LoadOp_Load },
+                .depth        = { .texture = sceneDepth, .loadOp = lvk::LoadOp_Load },
+                .dependencies = indirectRenderer.GetDrawDependencies(),
+            }, [&](const RenderGraphPassContext& pass) {
+                pass.cmd.cmdBindRenderPipeline(pipelines.GetRenderPipeline(pipelineIndirect));
+                pass.cmd.cmdBindDepthState({ .compareOp = lvk::CompareOp_Less, .isDepthWriteEnabled = true });
+                indirectRenderer.Draw(pass.cmd, assets->GetGeometry(), viewProj, CullPhase::Late);
+            });
+        }
+        
+        // Apply the post-processing chain: the effects are grouped into passes that each read the
+        // previous result once, the last one writes the swapchain. Intermediate results ping-pong
+        // between two pooled targets.
+        std::vector<PostEffectType> postChain;
+        for (const uint32_t effect : effectChain) postChain.push_back(postEffects[effect].type);
+        const std::vector<PostStack::Pass> postPasses = PostStack::Split(postChain, fusePostEffects);
+        // Effects work at the output resolution, so a scene rendered below it is scaled up first
+        RenderGraphTexture postInput = dynamicResolution.AddPasses(renderGraph, sceneColor, sampler, resolutionSettings);
+        for (size_t i = 0; i < postPasses.size(); ++i) {
+            const PostStack::Pass& postPass = postPasses[i];
+            const RenderGraphTexture postOutput = i + 1 == postPasses.size()
+                ? swapchain
+                : renderGraph.CreateTexture({ .format = outputFormat, .debugName = "Post-processing chain" });
+            std::vector<RenderGraphTexture> postReads = { postInput, noiseInput, noise2Input };
+            RenderGraphTexture bloomTexture;
+            if (postPass.UsesBloom()) {
+                bloomTexture = bloom.AddPasses(renderGraph, postInput, sampler, bloomSettings);
+                postReads.push_back(bloomTexture);
+            }
+            renderGraph.AddPass({
+                .name  = postPass.stages.size() == 1 ? getPostEffectName(postPass.stages[0]) : "Post-processing (fused)",
+                .reads = std::move(postReads),
+                .color = { .texture = postOutput, .clearColor = { 1.0f, 1.0f, 1.0f, 1.0f } },
+            }, [&, postInput, bloomTexture, pipeline = postStack.GetPipeline(postPass.stages)](const RenderGraphPassContext& pass) {
+                pass.cmd.cmdBindRenderPipeline(pipelines.GetRenderPipeline(pipeline));
+                pass.cmd.cmdBindDepthState({});
                 
-                // Render second skull actor
-                const glm::mat4 m2 = skullActor2->GetModelMatrix();
-                const glm::mat4 mvp2 = p * v * m2;
-                PushConstants pushConstants2 = { 
-                    mvp2, m2, skullColor.index(), {0.0f, 0.0f, 0.0f}
+                const PostPushConstants postPush = {
+                    renderGraph.GetTexture(postInput).index(),
+                    sampler.index(),
+                    static_cast<float>(currentTime),
+                    noiseTexture.index(),
+                    noise2Texture.index(),
+                    assets->ResolveFlags(noise) | (assets->ResolveFlags(noise2) << 8),
+                    renderGraph.GetTexture(bloomTexture).index(),
+                    // Every level is summed into the result at full weight
+                    bloomSettings.intensity / static_cast<float>(std::clamp(bloomSettings.levels, 1u, Bloom::kMaxLevels)),
                 };
-                cmd.cmdPushConstants(pushConstants2);
+                pass.cmd.cmdPushConstants(postPush);
                 
-                // Get meshes from second actor
-                MeshComponent* meshComp2 = skullActor2->GetComponent<MeshComponent>();
-                if (meshComp2) {
-                    const std::vector<MeshBuffers>& meshes2 = meshComp2->GetMeshes();
-                    for (const auto& mesh : meshes2) {
-                        cmd.cmdBindVertexBuffer(0, mesh.vertexBuffer);
-                        cmd.cmdBindIndexBuffer(mesh.indexBuffer, lvk::IndexFormat_UI32);
-                        cmd.cmdDrawIndexed(mesh.indexCount);
+                // Render fullscreen triangle
+                pass.cmd.cmdDraw(3);
+            });
+            postInput = postOutput;
+        }
+        
+        // Render ImGui on top
+        if (imgui) {
+            renderGraph.AddPass({
+                .name  = "ImGui",
+                .color = { .texture = swapchain, .loadOp = lvk::LoadOp_Load },
+            }, [&](const RenderGraphPassContext& pass) {
+                imgui->beginFrame(pass.framebuffer);
+                
+                // Post-processing control overlay
+                ImGui::Begin("Post-Processing Effects", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+                ImGui::Text("Post-processing chain, applied top to bottom:");
+                if (effectChain.empty()) {
+                    ImGui::TextDisabled("%s", noPostEffect.name);
+                }
+                for (size_t i = 0; i < effectChain.size(); ++i) {
+                    ImGui::PushID(static_cast<int>(i));
+                    ImGui::Text("%zu. %s", i + 1, postEffects[effectChain[i]].name);
+                    ImGui::SameLine();
+                    if (ImGui::SmallButton("Up") && i > 0) {
+                        std::swap(effectChain[i], effectChain[i - 1]);
+                    }
+                    ImGui::SameLine();
+                    const bool remove = ImGui::SmallButton("Remove");
+                    ImGui::PopID();
+                    if (remove) {
+                        effectChain.erase(effectChain.begin() + static_cast<ptrdiff_t>(i));
+                        break;
                     }
                 }
-            }
-            
-            cmd.cmdEndRendering();
-            
-            // Apply post-processing effects to final framebuffer
-            const lvk::RenderPass renderPassMain = {
-                .color = { { .loadOp = lvk::LoadOp_Clear, .clearColor = { 1.0f, 1.0f, 1.0f, 1.0f } } },
-            };
-            
-            const lvk::Framebuffer framebufferMain = {
-                .color = { { .texture = ctx->getCurrentSwapchainTexture() } },
-            };
-            
-            cmd.cmdBeginRendering(renderPassMain, framebufferMain, { 
-                .textures = { lvk::TextureHandle(intermediateTexture), noise, noise2 }
+                ImGui::Text("Add effect:");
+                for (uint32_t effect = 0; effect < postEffects.size(); ++effect) {
+                    if (effect % 3 != 0) ImGui::SameLine();
+                    if (ImGui::Button(postEffects[effect].name)) effectChain.push_back(effect);
+                }
+                ImGui::Checkbox("Fuse effects into one pass", &fusePostEffects);
+                ImGui::SameLine();
+                ImGui::Text("(%zu post passes, %u pipeline permutations)", postPasses.size(), postStack.GetPermutationCount());
+                if (std::any_of(effectChain.begin(), effectChain.end(), [&](uint32_t effect) { return postEffects[effect].type == PostEffectType::Bloom; })) {
+                    ImGui::Separator();
+                    ImGui::Text("Bloom:");
+                    ImGui::SliderFloat("Threshold", &bloomSettings.threshold, 0.0f, 1.5f, "%.2f");
+                    ImGui::SliderFloat("Knee", &bloomSettings.knee, 0.0f, 0.5f, "%.2f");
+                    ImGui::SliderFloat("Intensity", &bloomSettings.intensity, 0.0f, 8.0f, "%.2f");
+                    ImGui::SliderFloat("Radius", &bloomSettings.radius, 0.5f, 4.0f, "%.2f");
+                    int bloomLevels = static_cast<int>(bloomSettings.levels);
+                    if (ImGui::SliderInt("Levels", &bloomLevels, 1, static_cast<int>(Bloom::kMaxLevels))) {
+                        bloomSettings.levels = static_cast<uint32_t>(bloomLevels);
+                    }
+                    ImGui::Checkbox("Compute (shared-memory downsample)", &bloomSettings.useCompute);
+                }
+                ImGui::Separator();
+                ImGui::Checkbox("Dynamic resolution", &resolutionSettings.enabled);
+                ImGui::SameLine();
+                ImGui::Text("%.0f%% (%ux%u), GPU %.2f ms", renderScale * 100.0f, sceneSize.width, sceneSize.height,
+                            gpuProfiler.GetLastFrameMs());
+                if (resolutionSettings.enabled) {
+                    ImGui::SliderFloat("Target GPU time (ms)", &resolutionSettings.targetMs, 4.0f, 50.0f, "%.1f");
+                    ImGui::SliderFloat("Min scale", &resolutionSettings.minScale, 0.25f, 1.0f, "%.2f");
+                }
+                if (ImGui::RadioButton("Bilinear upscale", resolutionSettings.filter == UpscaleFilter::Bilinear)) {
+                    resolutionSettings.filter = UpscaleFilter::Bilinear;
+                }
+                ImGui::SameLine();
+                if (ImGui::RadioButton("Edge-adaptive (FSR 1)", resolutionSettings.filter == UpscaleFilter::EdgeAdaptive)) {
+                    resolutionSettings.filter = UpscaleFilter::EdgeAdaptive;
+                }
+                if (resolutionSettings.filter == UpscaleFilter::EdgeAdaptive) {
+                    ImGui::SliderFloat("Sharpness", &resolutionSettings.sharpness, 0.0f, 1.0f, "%.2f");
+                }
+                ImGui::Separator();
+                ImGui::Checkbox("GPU-driven draws (multi-draw indirect)", &gpuDriven);
+                ImGui::Checkbox("Frustum culling", &frustumCulling);
+                if (gpuDriven) {
+                    ImGui::Checkbox("GPU culling (two-phase)", &gpuCulling);
+                    if (gpuCulling) {
+                        ImGui::SameLine();
+                        ImGui::Checkbox("Hi-Z occlusion", &occlusionCulling);
+                    }
+                }
+                const CullingStats& cullingStats = frame->cullingStats;
+                ImGui::Text("Actors: %u visible, %u culled; submeshes: %u visible, %u culled", cullingStats.visibleActors,
+                            cullingStats.culledActors, cullingStats.visibleMeshes, cullingStats.culledMeshes);
+                ImGui::Text("BVH: height %u, %u nodes tested", frame->bvhHeight, cullingStats.nodesTested);
+                ImGui::Checkbox("LOD selection", &lodSelection);
+                if (lodSelection) {
+                    ImGui::SameLine();
+                    ImGui::SetNextItemWidth(120.0f);
+                    ImGui::SliderFloat("Max error (px)", &lodPixelError, 0.25f, 8.0f, "%.2f");
+                }
+                ImGui::Text("Submeshes per LOD:");
+                for (uint32_t lod = 0; lod < kMaxMeshLods; ++lod) {
+                    ImGui::SameLine();
+                    ImGui::Text("%u", cullingStats.lodMeshes[lod]);
+                }
+                if (gpuDriven) {
+                    const IndirectRendererStats& drawStats = indirectRenderer.GetStats();
+                    ImGui::Text("Instances: %u, draw commands: %u, indirect calls: %u", drawStats.instances,
+                                drawStats.drawCommands, drawStats.indirectCalls);
+                    ImGui::Text("Transforms: %u nodes, %u uploaded this frame", frame->transforms.nodeCount,
+                                drawStats.uploadedTransforms);
+                    if (indirectRenderer.IsGpuCulling()) {
+                        ImGui::Text("GPU culling: %u early + %u late of %u instances drawn, Hi-Z %ux%u", drawStats.gpuEarlyInstances,
+                                    drawStats.gpuLateInstances, drawStats.instances, hiz.GetWidth(), hiz.GetHeight());
+                    }
+                }
+                ImGui::Separator();
+                const RenderGraphStats& graphStats = renderGraph.GetStats();
+                ImGui::Text("Render graph: %u passes (%u culled), %u transient textures on %u pooled (%u in pool)",
+                            graphStats.passes, graphStats.culledPasses, graphStats.transientTextures, graphStats.allocatedTextures,
+                            graphStats.pooledTextures);
+                const PipelineLibraryStats& pipelineStats = pipelines.GetStats();
+                ImGui::Text("Pipelines: %u / %u built, %u on demand (last %.1f ms), %u pre-warmed (last %.1f ms)",
+                            pipelineStats.createdPipelines, pipelineStats.registeredPipelines, pipelineStats.onDemandCreations,
+                            pipelineStats.lastOnDemandMs, pipelineStats.prewarmedPipelines, pipelineStats.lastPrewarmMs);
+                ImGui::Text("Shaders: %u modules, SPIR-V %u prebuilt, %u cached, %u compiled", pipelineStats.shaderModules,
+                            pipelineStats.prebuiltShaders, pipelineStats.cachedShaders, pipelineStats.compiledShaders);
+                ImGui::Text("CPU: simulation %.2f ms, render %.2f ms (pipelined)", frame->simulationTime * 1000.0f,
+                            renderTime * 1000.0f);
+                const AssetRegistryStats& assetStats = assets->GetStats();
+                ImGui::Text("Assets: %u meshes, %u textures, %.1f MB", assetStats.residentMeshes, assetStats.residentTextures,
+                            assetStats.gpuMemoryUsage / (1024.0 * 1024.0));
+                ImGui::Text("Registry hits: %llu, misses: %llu, evictions: %llu",
+                            (unsigned long long)assetStats.hits, (unsigned long long)assetStats.misses,
+                            (unsigned long long)assetStats.evictions);
+                if (assetStats.pendingLoads > 0) {
+                    ImGui::Text("Loading %u assets...", assetStats.pendingLoads);
+                }
+                const GeometryArenaStats geometryStats = assets->GetGeometry().GetStats();
+                ImGui::Text("Geometry arena: %u meshes, %.1f / %.1f MB, fragmentation %.0f%%", geometryStats.allocations,
+                            geometryStats.usedBytes / (1024.0 * 1024.0), geometryStats.capacityBytes / (1024.0 * 1024.0),
+                            geometryStats.fragmentation * 100.0f);
+                if (skullMesh && skullMesh->IsReady()) {
+                    const MeshOptimizationStats& meshStats = skullMesh->optimizationStats;
+                    ImGui::Text("Skull: ACMR %.2f -> %.2f, overdraw %.2f -> %.2f", meshStats.acmrBefore, meshStats.acmrAfter,
+                                meshStats.overdrawBefore, meshStats.overdrawAfter);
+                }
+                ImGui::End();
+                
+                // Rolling per-zone times and trace export
+                ImGui::Begin("Profiler", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+                const std::vector<ProfileZoneStats> zoneStats = Profiler::Get().GetStats();
+                if (ImGui::BeginTable("Zones", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+                    ImGui::TableSetupColumn("Zone");
+                    ImGui::TableSetupColumn("Last (ms)");
+                    ImGui::TableSetupColumn("Avg (ms)");
+                    ImGui::TableSetupColumn("Max (ms)");
+                    ImGui::TableHeadersRow();
+                    for (const bool gpu : { false, true }) {
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn();
+                        ImGui::TextDisabled(gpu ? "GPU" : "CPU");
+                        for (const ProfileZoneStats& zone : zoneStats) {
+                            if (zone.gpu != gpu) continue;
+                            ImGui::TableNextRow();
+                            ImGui::TableNextColumn();
+                            ImGui::Text("  %s", zone.name);
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%.3f", zone.lastMs);
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%.3f", zone.averageMs);
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%.3f", zone.maxMs);
+                        }
+                    }
+                    ImGui::EndTable();
+                }
+                static int traceFrames = 120;
+                ImGui::SetNextItemWidth(160.0f);
+                ImGui::SliderInt("Frames", &traceFrames, 1, static_cast<int>(Profiler::kHistoryFrames));
+                ImGui::SameLine();
+                if (ImGui::Button("Export trace")) {
+                    // Frames before the current one are complete, GPU zones included up to a few frames back
+                    const uint64_t lastFrame = std::max<uint64_t>(Profiler::Get().GetFrame(), 2) - 1;
+                    const uint64_t frameCount = static_cast<uint64_t>(traceFrames);
+                    const uint64_t firstFrame = lastFrame >= frameCount ? lastFrame - frameCount + 1 : 1;
+                    const std::string tracePath = "traces/frames-" + std::to_string(firstFrame) + "-" + std::to_string(lastFrame) + ".json";
+                    if (Profiler::Get().ExportChromeTrace(tracePath, firstFrame, lastFrame)) {
+                        std::cout << "Trace written to " << tracePath << std::endl;
+                    }
+                }
+                ImGui::SameLine();
+                if (ImGui::Button("Export start-up")) {
+                    if (Profiler::Get().ExportChromeTrace("traces/startup.json", 0, 0)) {
+                        std::cout << "Trace written to traces/startup.json" << std::endl;
+                    }
+                }
+                ImGui::End();
+                
+                imgui->endFrame(pass.cmd);
             });
-            
-            // Select post-processing pipeline based on current effect
-            lvk::Holder<lvk::RenderPipelineHandle>* selectedPipeline;
-            switch (currentEffect) {
-                case 0: selectedPipeline = &pipelineToneMap; break;
-                case 1: selectedPipeline = &pipelineCRT; break;
-                case 2: selectedPipeline = &pipelineBloom; break;
-                case 3: selectedPipeline = &pipelineDream; break;
-                case 4: selectedPipeline = &pipelineGlitch; break;
-                case 5: selectedPipeline = &pipelinePixel; break;
-                case 6: selectedPipeline = &pipelineFog; break;
-                case 7: selectedPipeline = &pipelineUnderwater; break;
-                case 8: selectedPipeline = &pipelineDithering; break;
-                case 9: selectedPipeline = &pipelinePosterization; break;
-                default: selectedPipeline = &pipelineToneMap; break;
+        }
+        
+        renderGraph.Compile();
+        if (bench) {
+            ctx->wait(lastSubmit);
+        }
+        lvk::ICommandBuffer& cmd = ctx->acquireCommandBuffer();
+        // A frame finished a few frames ago picks the scale of the next one
+        gpuProfiler.BeginFrame(cmd);
+        if (gpuProfiler.HasNewResult()) {
+            dynamicResolution.Update(gpuProfiler.GetLastFrameMs(), resolutionSettings);
+        }
+        renderGraph.Execute(cmd, &gpuProfiler);
+        gpuProfiler.EndFrame(cmd);
+        recordZone.End();
+        
+        {
+            VKENGINE_PROFILE_ZONE("Submit");
+            lastSubmit = ctx->submit(cmd, bench ? lvk::TextureHandle{} : ctx->getCurrentSwapchainTexture());
+        }
+        assets->GetGeometry().RetireFrame();
+        // One not-yet-used pipeline per frame, so switching effects later rarely hitches
+        {
+            VKENGINE_PROFILE_ZONE("Prewarm pipelines");
+            pipelines.Prewarm(1);
+        }
+        renderTime = static_cast<float>(getTime() - currentTime);
+        
+        if (bench) {
+            if (benchFrame >= benchOptions.warmupFrames) {
+                const IndirectRendererStats& drawStats = indirectRenderer.GetStats();
+                const uint32_t drawCount = static_cast<uint32_t>(frame->draws.size());
+                benchRecorder.AddFrame({
+                    .cpuMs         = static_cast<float>((currentTime - lastFrameStart) * 1000.0),
+                    .renderMs      = renderTime * 1000.0f,
+                    .simulationMs  = frame->simulationTime * 1000.0f,
+                    .visibleMeshes = frame->cullingStats.visibleMeshes,
+                    .instances     = gpuDriven ? drawStats.instances : drawCount,
+                    .drawCommands  = gpuDriven ? drawStats.drawCommands : drawCount,
+                    .drawCalls     = gpuDriven ? drawStats.indirectCalls : drawCount,
+                });
+                if (gpuProfiler.HasNewResult()) {
+                    benchRecorder.AddGpuFrame(gpuProfiler.GetLastFrameMs());
+                }
             }
-            
-            cmd.cmdBindRenderPipeline(*selectedPipeline);
-            cmd.cmdBindDepthState({});
-            
-            // Push constants for post-processing
-            struct PostPushConstants {
-                uint32_t texColor;
-                uint32_t smpl;
-                float time;
-                uint32_t noise;
-                uint32_t noise2;
-            };
-            
-            PostPushConstants postPush = { 
-                intermediateTexture.index(), 
-                sampler.index(), 
-                static_cast<float>(currentTime),
-                noise.index(),
-                noise2.index()
-            };
-            cmd.cmdPushConstants(postPush);
-            
-            // Render fullscreen triangle
-            cmd.cmdDraw(3);
-            
-            // Render ImGui on top
-            imgui->beginFrame(framebufferMain);
-            
-            // Post-processing control overlay
-            ImGui::Begin("Post-Processing Effects", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
-            ImGui::Text("Select Post-Processing Effect:");
-            if (ImGui::Button("No Post-Processing")) currentEffect = 0;
-            if (ImGui::Button("CRT Dynamic")) currentEffect = 1;
-            if (ImGui::Button("Bloom")) currentEffect = 2;
-            if (ImGui::Button("Dream")) currentEffect = 3;
-            if (ImGui::Button("Glitch")) currentEffect = 4;
-            if (ImGui::Button("Pixelation")) currentEffect = 5;
-            if (ImGui::Button("Fog")) currentEffect = 6;
-            if (ImGui::Button("Underwater")) currentEffect = 7;
-            if (ImGui::Button("Dithering")) currentEffect = 8;
-            if (ImGui::Button("Posterization")) currentEffect = 9;
-            ImGui::End();
-            
-            imgui->endFrame(cmd);
-            
-            cmd.cmdEndRendering();
+            lastFrameStart = currentTime;
+            benchFrame++;
         }
         
-        ctx->submit(cmd, ctx->getCurrentSwapchainTexture());
+        // UI changes reach the simulation with the snapshot; it is simulated again while the next one is recorded
+        frameInput.frustumCulling = frustumCulling;
+        frameInput.lodSelection = lodSelection;
+        frameInput.lodPixelError = lodPixelError;
+        frameInput.renderScale = dynamicResolution.GetScale();
+        framePipeline.EndRender(frame, frameInput);
+        Profiler::Get().EndFrame();
     }
     
-    // Cleanup component system
-    if (skullActor) {
-        skullActor->OnDestroy();
-        delete skullActor;
-    }
+    // Actors, the hierarchy and culling belong to the game thread until it has stopped
+    framePipeline.Stop();
+    gameThread.join();
     
-    if (skullActor2) {
-        skullActor2->OnDestroy();
-        delete skullActor2;
-    }
+    // Everything compiled this run, for the next start
+    SavePipelineCache(ctx.get(), kPipelineCachePath);
     
-    if (cameraActor) {
-        cameraActor->OnDestroy();
-        delete cameraActor;
+    int result = 0;
+    if (bench) {
+        ctx->wait({});
+        const BenchmarkMemory memory = {
+            .assetGpuBytes      = assets->GetStats().gpuMemoryUsage,
+            .geometryArenaBytes = assets->GetGeometry().GetStats().capacityBytes,
+            .peakResidentBytes  = GetPeakResidentBytes(),
+        };
+        benchRecorder.PrintSummary(std::cout);
+        if (benchRecorder.WriteJson(benchOptions.output, benchOptions, deviceName, memory)) {
+            std::cout << "Benchmark results written to " << benchOptions.output << std::endl;
+        } else {
+            result = -1;
+        }
+        actors.DestroyMany(stressScene.actors);
     }
     
-    return 0;
+    // Cleanup component system (~Actor runs OnDestroy and releases the entity)
+    actors.DestroyMany(std::array{ skullHandle, skullHandle2, cameraHandle });
+    
+    return result;
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <renderer/Bloom.h>
+#include <algorithm>
+#include <array>
+
+namespace {
+constexpr uint32_t kGroupSize = 8; // local_size_x/y in bloom_downsample.comp and bloom_upsample.comp
+constexpr lvk::Format kLevelFormat = lvk::Format_RGBA_F16;
+
+/// Matches the push constants in bloom_downsample.frag/.comp
+struct DownsamplePushConstants {
+    uint32_t source;
+    uint32_t destination;
+    uint32_t sampler;
+    uint32_t prefilter; // 1 for the first pass, which thresholds the source
+    uint32_t sourceWidth;
+    uint32_t sourceHeight;
+    uint32_t destinationWidth;
+    uint32_t destinationHeight;
+    float threshold;
+    float knee;
+};
+
+/// Matches the push constants in bloom_upsample.frag/.comp
+struct UpsamplePushConstants {
+    uint32_t source;
+    uint32_t current;
+    uint32_t destination;
+    uint32_t sampler;
+    uint32_t sourceWidth;
+    uint32_t sourceHeight;
+    uint32_t destinationWidth;
+    uint32_t destinationHeight;
+    float radius;
+};
+
+lvk::Dimensions GetGroupCount(const lvk::Dimensions& size_) {
+    return { (size_.width + kGroupSize - 1) / kGroupSize, (size_.height + kGroupSize - 1) / kGroupSize, 1 };
+}
+}
+
+Bloom::Bloom(lvk::IContext* ctx_, PipelineLibrary& pipelines_) : ctx(ctx_), pipelines(pipelines_) {
+    downsamplePipeline = pipelines.AddRenderPipeline({
+        .vertexShader      = "shaders/post.vert",
+        .fragmentShader    = "shaders/bloom_downsample.frag",
+        .colorFormat       = kLevelFormat,
+        .debugName         = "Bloom: downsample",
+        .pushConstantsSize = sizeof(DownsamplePushConstants),
+    });
+    upsamplePipeline = pipelines.AddRenderPipeline({
+        .vertexShader      = "shaders/post.vert",
+        .fragmentShader    = "shaders/bloom_upsample.frag",
+        .colorFormat       = kLevelFormat,
+        .debugName         = "Bloom: upsample",
+        .pushConstantsSize = sizeof(UpsamplePushConstants),
+    });
+}
+
+bool Bloom::CreateComputePipelines() {
+    if (downsampleCompute.valid()) return true;
+    if (computeFailed) return false;
+
+    const lvk::ShaderModuleHandle downsample = pipelines.GetShaderModule("shaders/bloom_downsample.comp");
+    const lvk::ShaderModuleHandle upsample = pipelines.GetShaderModule("shaders/bloom_upsample.comp");
+    computeFailed = !downsample.valid() || !upsample.valid();
+    if (computeFailed) return false;
+
+    downsampleCompute = ctx->createComputePipeline({ .smComp = downsample, .debugName = "Pipeline: bloom downsample" });
+    upsampleCompute = ctx->createComputePipeline({ .smComp = upsample, .debugName = "Pipeline: bloom upsample" });
+    return true;
+}
+
+RenderGraphTexture Bloom::AddPasses(RenderGraph& graph_, RenderGraphTexture source_, lvk::SamplerHandle sampler_,
+                                    const BloomSettings& settings_) {
+    // Falls back to the fragment passes if the compute shaders did not compile
+    const bool compute = settings_.useCompute && CreateComputePipelines();
+    const uint8_t usage = compute ? lvk::TextureUsageBits_Sampled | lvk::TextureUsageBits_Storage
+                                  : lvk::TextureUsageBits_Sampled | lvk::TextureUsageBits_Attachment;
+    const uint32_t levelCount = std::clamp(settings_.levels, 1u, kMaxLevels);
+
+    // Adds one pass writing destination_, as a dispatch or as a fullscreen triangle. push_ builds
+    // the push constants once the graph has assigned the textures.
+    auto addPass = [&](const char* name_, std::vector<RenderGraphTexture> reads_, RenderGraphTexture destination_,
+                       lvk::ComputePipelineHandle computePipeline_, PipelineId renderPipeline_, auto push_) {
+        RenderGraphPassDesc desc = { .name = name_, .reads = std::move(reads_) };
+        if (compute) {
+            desc.writes = { destination_ };
+        } else {
+            desc.color = { .texture = destination_, .loadOp = lvk::LoadOp_DontCare };
+        }
+        graph_.AddPass(desc, [=, this, &graph_](const RenderGraphPassContext& pass) {
+            if (compute) {
+                pass.cmd.cmdBindComputePipeline(computePipeline_);
+                pass.cmd.cmdPushConstants(push_(graph_));
+                pass.cmd.cmdDispatchThreadGroups(GetGroupCount(graph_.GetDimensions(destination_)), pass.dependencies);
+            } else {
+                pass.cmd.cmdBindRenderPipeline(pipelines.GetRenderPipeline(renderPipeline_));
+                pass.cmd.cmdBindDepthState({});
+                pass.cmd.cmdPushConstants(push_(graph_));
+                pass.cmd.cmdDraw(3);
+            }
+        });
+    };
+
+    std::array<RenderGraphTexture, kMaxLevels> down;
+    float scale = 0.5f;
+    for (uint32_t level = 0; level < levelCount; ++level, scale *= 0.5f) {
+        const RenderGraphTexture source = level == 0 ? source_ : down[level - 1];
+        down[level] = graph_.CreateTexture({ .format = kLevelFormat, .usage = usage, .scale = scale, .debugName = "Bloom downsample" });
+        const lvk::Dimensions sourceSize = graph_.GetDimensions(source);
+        const lvk::Dimensions destinationSize = graph_.GetDimensions(down[level]);
+        addPass(level == 0 ? "Bloom prefilter" : "Bloom downsample", { source }, down[level], downsampleCompute,
+                downsamplePipeline, [=](const RenderGraph& graph) {
+            return DownsamplePushConstants{
+                .source            = graph.GetTexture(source).index(),
+                .destination       = graph.GetTexture(down[level]).index(),
+                .sampler           = sampler_.index(),
+                .prefilter         = level == 0 ? 1u : 0u,
+                .sourceWidth       = sourceSize.width,
+                .sourceHeight      = sourceSize.height,
+                .destinationWidth  = destinationSize.width,
+                .destinationHeight = destinationSize.height,
+                .threshold         = settings_.threshold,
+                .knee              = std::max(settings_.knee, 1e-4f),
+            };
+        });
+    }
+
+    // The smallest level is its own upsampled result
+    RenderGraphTexture up = down[levelCount - 1];
+    scale *= 2.0f;
+    for (uint32_t level = levelCount - 1; level-- > 0;) {
+        scale *= 2.0f;
+        const RenderGraphTexture source = up;
+        const RenderGraphTexture current = down[level];
+        up = graph_.CreateTexture({ .format = kLevelFormat, .usage = usage, .scale = scale, .debugName = "Bloom upsample" });
+        const RenderGraphTexture destination = up;
+        const lvk::Dimensions sourceSize = graph_.GetDimensions(source);
+        const lvk::Dimensions destinationSize = graph_.GetDimensions(destination);
+        addPass("Bloom upsample", { source, current }, destination, upsampleCompute, upsamplePipeline,
+                [=](const RenderGraph& graph) {
+            return UpsamplePushConstants{
+                .source            = graph.GetTexture(source).index(),
+                .current           = graph.GetTexture(current).index(),
+                .destination       = graph.GetTexture(destination).index(),
+                .sampler           = sampler_.index(),
+                .sourceWidth       = sourceSize.width,
+                .sourceHeight      = sourceSize.height,
+                .destinationWidth  = destinationSize.width,
+                .destinationHeight = destinationSize.height,
+                .radius            = settings_.radius,
+            };
+        });
+    }
+    return up;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <renderer/PipelineLibrary.h>
+#include <renderer/RenderGraph.h>
+#include <lvk/LVK.h>
+#include <cstdint>
+
+/// Runtime bloom parameters, edited from the UI
+struct BloomSettings {
+    /// Brightness above which a pixel blooms, with a soft ramp of knee on either side
+    float threshold = 0.8f;
+    float knee = 0.1f;
+    float intensity = 2.0f;
+    /// Width of the upsample tent in texels of the smaller level; larger is softer and wider
+    float radius = 1.0f;
+    /// Downsampled levels, the first at half resolution; each one doubles the reach
+    uint32_t levels = 6;
+    /// Compute passes with a shared-memory downsample instead of fullscreen fragment passes
+    bool useCompute = true;
+};
+
+/// Dual-filter bloom over a chain of half-resolution render graph textures.
+///
+/// The first pass thresholds the source while downsampling it to half resolution; each further
+/// pass halves the previous level with a 13-tap filter. The way back up adds every level to the
+/// tent-filtered level below it, so the half-resolution result holds all levels at once. Each
+/// level has a quarter of the pixels of the one above, so the chain costs little more than its
+/// first pass, whatever the radius.
+///
+/// Both variants write RGBA16F levels; the compute variant loads each group's footprint into
+/// shared memory instead of sampling it per tap.
+class Bloom {
+public:
+    static constexpr uint32_t kMaxLevels = 8;
+
+    Bloom(lvk::IContext* ctx_, PipelineLibrary& pipelines_);
+
+    Bloom(const Bloom&) = delete;
+    Bloom& operator=(const Bloom&) = delete;
+
+    /// Adds the bloom passes reading source_ to graph_; returns the half-resolution result
+    RenderGraphTexture AddPasses(RenderGraph& graph_, RenderGraphTexture source_, lvk::SamplerHandle sampler_,
+                                 const BloomSettings& settings_);
+
+private:
+    /// Creates the compute pipelines on first use; false if their shaders failed
+    bool CreateComputePipelines();
+
+    lvk::IContext* ctx;
+    PipelineLibrary& pipelines;
+    PipelineId downsamplePipeline;
+    PipelineId upsamplePipeline;
+    lvk::Holder<lvk::ComputePipelineHandle> downsampleCompute;
+    lvk::Holder<lvk::ComputePipelineHandle> upsampleCompute;
+    bool computeFailed = false;
+};
@@ -0,0 +1,103 @@
+#include <renderer/DynamicResolution.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/// Matches the push constants in upscale_bilinear.frag, upscale_easu.frag and sharpen_rcas.frag
+struct UpscalePushConstants {
+    uint32_t source;
+    uint32_t sampler;
+    uint32_t sourceWidth;
+    uint32_t sourceHeight;
+    uint32_t destinationWidth;
+    uint32_t destinationHeight;
+    float sharpness;
+};
+
+constexpr float kSmoothing = 0.1f;
+
+float QuantizeScale(float scale_) {
+    return std::floor(scale_ / DynamicResolution::kScaleStep + 1e-3f) * DynamicResolution::kScaleStep;
+}
+}
+
+DynamicResolution::DynamicResolution(PipelineLibrary& pipelines_, lvk::Format colorFormat_)
+    : pipelines(pipelines_), colorFormat(colorFormat_) {
+    auto addPipeline = [&](const char* fragmentShader_, const char* debugName_) {
+        return pipelines.AddRenderPipeline({
+            .vertexShader      = "shaders/post.vert",
+            .fragmentShader    = fragmentShader_,
+            .colorFormat       = colorFormat_,
+            .debugName         = debugName_,
+            .pushConstantsSize = sizeof(UpscalePushConstants),
+        });
+    };
+    bilinearPipeline = addPipeline("shaders/upscale_bilinear.frag", "Upscale: bilinear");
+    easuPipeline = addPipeline("shaders/upscale_easu.frag", "Upscale: edge-adaptive");
+    rcasPipeline = addPipeline("shaders/sharpen_rcas.frag", "Upscale: sharpen");
+}
+
+void DynamicResolution::Update(float gpuMs_, const DynamicResolutionSettings& settings_) {
+    const float minScale = std::clamp(QuantizeScale(settings_.minScale), kScaleStep, 1.0f);
+    const float maxScale = std::clamp(QuantizeScale(settings_.maxScale), minScale, 1.0f);
+    float target = settings_.enabled ? scale : maxScale;
+    target = std::clamp(target, minScale, maxScale);
+
+    framesSinceChange++;
+    if (settings_.enabled && framesSinceChange > kSettleFrames) {
+        smoothedMs = smoothedMs == 0.0f ? gpuMs_ : smoothedMs + (gpuMs_ - smoothedMs) * kSmoothing;
+        // A few frames at the new scale before trusting the average
+        if (framesSinceChange > 2 * kSettleFrames && smoothedMs > 0.0f) {
+            const float ideal = scale * std::sqrt(settings_.targetMs / smoothedMs);
+            if (smoothedMs > settings_.targetMs) {
+                target = std::clamp(QuantizeScale(ideal), minScale, scale);
+            } else if (smoothedMs < settings_.targetMs * kRaiseThreshold && ideal >= scale + kScaleStep) {
+                target = std::min(scale + kScaleStep, maxScale);
+            }
+        }
+    }
+
+    if (std::abs(target - scale) > kScaleStep * 0.5f) {
+        scale = target;
+        smoothedMs = 0.0f;
+        framesSinceChange = 0;
+    }
+}
+
+RenderGraphTexture DynamicResolution::AddPasses(RenderGraph& graph_, RenderGraphTexture source_,
+                                                lvk::SamplerHandle sampler_, const DynamicResolutionSettings& settings_) {
+    if (scale >= 1.0f) return source_;
+
+    // Adds a fullscreen pass reading input_ into a new full-size texture
+    auto addPass = [&](const char* name_, RenderGraphTexture input_, PipelineId pipeline_) {
+        const RenderGraphTexture output = graph_.CreateTexture({ .format = colorFormat, .debugName = name_ });
+        const lvk::Dimensions inputSize = graph_.GetDimensions(input_);
+        const lvk::Dimensions outputSize = graph_.GetDimensions(output);
+        const float sharpness = std::clamp(settings_.sharpness, 0.0f, 1.0f);
+        graph_.AddPass({
+            .name  = name_,
+            .reads = { input_ },
+            .color = { .texture = output, .loadOp = lvk::LoadOp_DontCare },
+        }, [=, this, &graph_](const RenderGraphPassContext& pass) {
+            pass.cmd.cmdBindRenderPipeline(pipelines.GetRenderPipeline(pipeline_));
+            pass.cmd.cmdBindDepthState({});
+            pass.cmd.cmdPushConstants(UpscalePushConstants{
+                .source            = graph_.GetTexture(input_).index(),
+                .sampler           = sampler_.index(),
+                .sourceWidth       = inputSize.width,
+                .sourceHeight      = inputSize.height,
+                .destinationWidth  = outputSize.width,
+                .destinationHeight = outputSize.height,
+                .sharpness         = sharpness,
+            });
+            pass.cmd.cmdDraw(3);
+        });
+        return output;
+    };
+
+    if (settings_.filter == UpscaleFilter::Bilinear) {
+        return addPass("Upscale (bilinear)", source_, bilinearPipeline);
+    }
+    const RenderGraphTexture upscaled = addPass("Upscale (edge-adaptive)", source_, easuPipeline);
+    return addPass("Sharpen", upscaled, rcasPipeline);
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <renderer/PipelineLibrary.h>
+#include <renderer/RenderGraph.h>
+#include <lvk/LVK.h>
+#include <cstdint>
+
+enum class UpscaleFilter : uint32_t {
+    Bilinear,
+    /// Edge-adaptive upscale followed by contrast-adaptive sharpening, after FSR 1.0
+    EdgeAdaptive,
+};
+
+/// Runtime dynamic resolution parameters, edited from the UI
+struct DynamicResolutionSettings {
+    bool enabled = true;
+    /// GPU frame time to hold, in milliseconds
+    float targetMs = 1000.0f / 60.0f;
+    /// Range of the scene resolution, as a fraction of the output size on each axis
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+    UpscaleFilter filter = UpscaleFilter::EdgeAdaptive;
+    /// Sharpening after the edge-adaptive upscale, 0 to 1
+    float sharpness = 0.5f;
+};
+
+/// Renders the scene at a fraction of the output resolution chosen from the GPU frame time, and
+/// scales it back up before post-processing.
+///
+/// The controller assumes the frame cost follows the pixel count, so the scale moves by the square
+/// root of the ratio between budget and smoothed frame time. It lowers the scale as soon as the
+/// budget is missed but raises it only below kRaiseThreshold of it, one kScaleStep at a time, so it
+/// does not oscillate around the budget. Scales are quantized to kScaleStep, which keeps the
+/// number of target sizes the render graph pools small, and after every change it ignores the
+/// frame times still measured at the old scale.
+class DynamicResolution {
+public:
+    static constexpr float kScaleStep = 0.05f;
+    static constexpr float kRaiseThreshold = 0.85f;
+    /// Frames after a change before frame times count again; more than the timer's latency
+    static constexpr uint32_t kSettleFrames = 8;
+
+    DynamicResolution(PipelineLibrary& pipelines_, lvk::Format colorFormat_);
+
+    DynamicResolution(const DynamicResolution&) = delete;
+    DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+    /// Feeds the GPU time of a finished frame; may change the scale of the next frames
+    void Update(float gpuMs_, const DynamicResolutionSettings& settings_);
+
+    /// Adds the passes upscaling source_ to the graph size and returns the result; source_ itself
+    /// if it is already full size
+    RenderGraphTexture AddPasses(RenderGraph& graph_, RenderGraphTexture source_, lvk::SamplerHandle sampler_,
+                                 const DynamicResolutionSettings& settings_);
+
+    /// Fraction of the output size to render the scene at
+    [[nodiscard]] float GetScale() const { return scale; }
+    [[nodiscard]] float GetSmoothedMs() const { return smoothedMs; }
+
+private:
+    PipelineLibrary& pipelines;
+    lvk::Format colorFormat;
+    PipelineId bilinearPipeline;
+    PipelineId easuPipeline;
+    PipelineId rcasPipeline;
+    float scale = 1.0f;
+    /// Exponential average of the frame times measured since the last change, 0 if there are none
+    float smoothedMs = 0.0f;
+    uint32_t framesSinceChange = 0;
+};
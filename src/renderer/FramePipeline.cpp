@@ -0,0 +1,39 @@
+#include <renderer/FramePipeline.h>
+
+FramePipeline::FramePipeline(const FrameInput& input_) {
+    for (FrameSnapshot& snapshot : snapshots) {
+        snapshot.input = input_;
+        freeSnapshots.Push(&snapshot);
+    }
+}
+
+FrameSnapshot* FramePipeline::BeginSimulation() {
+    if (stopping.load(std::memory_order_acquire)) return nullptr;
+    FrameSnapshot* snapshot = freeSnapshots.Pop();
+    return stopping.load(std::memory_order_acquire) ? nullptr : snapshot;
+}
+
+void FramePipeline::EndSimulation(FrameSnapshot* snapshot_) {
+    readySnapshots.Push(snapshot_);
+}
+
+FrameSnapshot* FramePipeline::BeginRender() {
+    return readySnapshots.Pop();
+}
+
+void FramePipeline::EndRender(FrameSnapshot* snapshot_, const FrameInput& input_) {
+    snapshot_->input = input_;
+    // Recording is done; the registry may evict what only this snapshot still held
+    snapshot_->pinnedMeshes.clear();
+    snapshot_->pinnedTextures.clear();
+    freeSnapshots.Push(snapshot_);
+}
+
+void FramePipeline::Stop() {
+    stopping.store(true, std::memory_order_release);
+    // A game thread waiting for a free snapshot only does so while both sit in the ready queue;
+    // handing them back wakes it up to see the flag
+    while (std::optional<FrameSnapshot*> snapshot = readySnapshots.TryPop()) {
+        freeSnapshots.Push(*snapshot);
+    }
+}
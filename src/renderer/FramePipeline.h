@@ -0,0 +1,89 @@
+#pragma once
+#include <assets/AssetRegistry.h>
+#include <components/TransformHierarchy.h>
+#include <core/SpscQueue.h>
+#include <renderer/SceneCulling.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+struct MeshBuffers;
+
+/// Settings the render thread owns (window size, UI toggles) that the next simulation step needs
+struct FrameInput {
+    uint32_t framebufferWidth = 1;
+    uint32_t framebufferHeight = 1;
+    bool frustumCulling = true;
+    bool lodSelection = true;
+    float lodPixelError = 1.0f;
+    /// Fraction of the framebuffer the scene renders at, so LOD errors are in rendered pixels
+    float renderScale = 1.0f;
+};
+
+/// One submesh to draw, resolved on the game thread so recording never reads components
+struct SnapshotDraw {
+    const MeshBuffers* mesh;
+    uint32_t lod;
+    uint32_t transformNode;
+    uint32_t textureIndex;
+    uint32_t textureFlags; // TextureFlagBits
+};
+
+/// Everything the render thread needs to record one frame. Written only by the game thread
+/// between BeginSimulation() and EndSimulation(), read only by the render thread between
+/// BeginRender() and EndRender().
+struct FrameSnapshot {
+    /// Filled in by the render thread when it hands the snapshot back; read by the next simulation
+    FrameInput input;
+    uint64_t frameIndex = 0;
+    /// Seconds the game thread spent producing the snapshot
+    float simulationTime = 0.0f;
+    glm::mat4 viewProj = glm::mat4(1.0f);
+    /// World matrices that moved since the previous snapshot
+    TransformDelta transforms;
+    std::vector<SnapshotDraw> draws;
+    /// Assets the draws point into, held until EndRender() so a despawn on the game thread cannot
+    /// let the registry evict them while the snapshot is recorded
+    std::vector<MeshRef> pinnedMeshes;
+    std::vector<TextureRef> pinnedTextures;
+    CullingStats cullingStats;
+    uint32_t bvhHeight = 0;
+};
+
+/// Two-stage frame pipeline: the game thread simulates frame N+1 while the render thread records
+/// and submits frame N. Two snapshots cycle between the threads through a pair of lock-free
+/// single-producer/single-consumer queues (free: render -> game, ready: game -> render), so
+/// neither thread ever sees a snapshot the other is writing and CPU frame time becomes the
+/// slower of the two stages instead of their sum.
+///
+/// Every simulated snapshot is rendered, in order, so TransformDelta chains stay intact.
+class FramePipeline {
+public:
+    static constexpr uint32_t kSnapshotCount = 2;
+
+    explicit FramePipeline(const FrameInput& input_);
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    /// Game thread: waits for a snapshot to fill; nullptr once Stop() was called
+    FrameSnapshot* BeginSimulation();
+    void EndSimulation(FrameSnapshot* snapshot_);
+
+    /// Render thread: waits for the next simulated frame
+    FrameSnapshot* BeginRender();
+    /// Render thread: returns the snapshot with the input for a later simulation step
+    void EndRender(FrameSnapshot* snapshot_, const FrameInput& input_);
+
+    /// Render thread, while it holds no snapshot: makes the game thread's current or next
+    /// BeginSimulation() return nullptr. Join the game thread afterwards.
+    void Stop();
+
+private:
+    std::array<FrameSnapshot, kSnapshotCount> snapshots;
+    SpscQueue<FrameSnapshot*, kSnapshotCount> freeSnapshots;
+    SpscQueue<FrameSnapshot*, kSnapshotCount> readySnapshots;
+    std::atomic<bool> stopping{false};
+};
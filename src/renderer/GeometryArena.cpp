@@ -0,0 +1,194 @@
+#include <renderer/GeometryArena.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+
+GeometryAllocation::~GeometryAllocation() {
+    Reset();
+}
+
+GeometryAllocation::GeometryAllocation(GeometryAllocation&& other_) noexcept
+    : arena(other_.arena), id(other_.id) {
+    other_.arena = nullptr;
+}
+
+GeometryAllocation& GeometryAllocation::operator=(GeometryAllocation&& other_) noexcept {
+    if (this != &other_) {
+        Reset();
+        arena = other_.arena;
+        id = other_.id;
+        other_.arena = nullptr;
+    }
+    return *this;
+}
+
+void GeometryAllocation::Reset() {
+    if (arena) {
+        arena->Release(id);
+        arena = nullptr;
+    }
+}
+
+GeometryArena::GeometryArena(lvk::IContext* ctx_, uint32_t vertexStride_, uint32_t vertexCapacity_, uint32_t indexCapacity_)
+    : ctx(ctx_) {
+    InitPool(vertexPool, vertexStride_, vertexCapacity_, lvk::BufferUsageBits_Vertex | lvk::BufferUsageBits_Storage, "Buffer: arena vertices");
+    InitPool(indexPools[0], sizeof(uint16_t), indexCapacity_, lvk::BufferUsageBits_Index | lvk::BufferUsageBits_Storage, "Buffer: arena indices 16");
+    InitPool(indexPools[1], sizeof(uint32_t), indexCapacity_, lvk::BufferUsageBits_Index | lvk::BufferUsageBits_Storage, "Buffer: arena indices 32");
+}
+
+GeometryArena::~GeometryArena() {
+    if (allocationCount > pendingFrees.size()) {
+        std::cerr << "GeometryArena destroyed with " << allocationCount - pendingFrees.size() << " live allocations" << std::endl;
+    }
+}
+
+void GeometryArena::InitPool(Pool& pool_, uint32_t elementSize_, uint32_t capacity_, uint8_t usage_, const char* debugName_) {
+    pool_.elementSize = elementSize_;
+    pool_.usage = usage_;
+    pool_.debugName = debugName_;
+    pool_.allocator = RangeAllocator(capacity_);
+    pool_.shadow.assign(size_t(capacity_) * elementSize_, 0);
+    RecreateBuffer(pool_);
+}
+
+void GeometryArena::RecreateBuffer(Pool& pool_) {
+    // The previous buffer (if any) stays alive until the frames using it have completed
+    pool_.buffer = ctx->createBuffer({
+        .usage = pool_.usage,
+        .storage = lvk::StorageType_Device,
+        .size = pool_.shadow.size(),
+        .data = pool_.shadow.data(),
+        .debugName = pool_.debugName
+    });
+}
+
+uint32_t GeometryArena::AllocateInPool(Pool& pool_, const void* data_, uint32_t count_) {
+    uint32_t offset = pool_.allocator.Allocate(count_);
+    if (offset == RangeAllocator::kInvalidOffset) {
+        const uint32_t capacity = pool_.allocator.GetCapacity();
+        const uint32_t newCapacity = std::max(capacity * 2, capacity + count_);
+        std::cout << "Growing " << pool_.debugName << " to " << size_t(newCapacity) * pool_.elementSize / (1024 * 1024) << " MB" << std::endl;
+        pool_.allocator.Grow(newCapacity);
+        pool_.shadow.resize(size_t(newCapacity) * pool_.elementSize, 0);
+        offset = pool_.allocator.Allocate(count_);
+        std::memcpy(pool_.shadow.data() + size_t(offset) * pool_.elementSize, data_, size_t(count_) * pool_.elementSize);
+        RecreateBuffer(pool_);
+        growths++;
+        return offset;
+    }
+
+    const size_t byteOffset = size_t(offset) * pool_.elementSize;
+    const size_t byteSize = size_t(count_) * pool_.elementSize;
+    std::memcpy(pool_.shadow.data() + byteOffset, data_, byteSize);
+    ctx->upload(pool_.buffer, pool_.shadow.data() + byteOffset, byteSize, byteOffset);
+    return offset;
+}
+
+GeometryAllocation GeometryArena::Allocate(const void* vertexData_, uint32_t vertexCount_,
+                                           const void* indexData_, uint32_t indexCount_, lvk::IndexFormat indexFormat_) {
+    if (vertexCount_ == 0 || indexCount_ == 0) {
+        return {};
+    }
+
+    GeometryRange range;
+    range.vertexCount = vertexCount_;
+    range.indexCount = indexCount_;
+    range.indexFormat = indexFormat_;
+    range.vertexOffset = static_cast<int32_t>(AllocateInPool(vertexPool, vertexData_, vertexCount_));
+    range.firstIndex = AllocateInPool(GetIndexPool(indexFormat_), indexData_, indexCount_);
+
+    uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+        ranges[id] = range;
+        live[id] = true;
+    } else {
+        id = static_cast<uint32_t>(ranges.size());
+        ranges.push_back(range);
+        live.push_back(true);
+    }
+    allocationCount++;
+    return GeometryAllocation(this, id);
+}
+
+void GeometryArena::Bind(lvk::ICommandBuffer& cmd_, lvk::IndexFormat indexFormat_) const {
+    cmd_.cmdBindVertexBuffer(0, vertexPool.buffer);
+    cmd_.cmdBindIndexBuffer(GetIndexPool(indexFormat_).buffer, indexFormat_);
+}
+
+void GeometryArena::Release(uint32_t id_) {
+    // The range may still be read by frames in flight; reuse it once they are done
+    pendingFrees.push_back({frameIndex, id_});
+}
+
+void GeometryArena::FreeNow(uint32_t id_) {
+    const GeometryRange& range = ranges[id_];
+    vertexPool.allocator.Free(static_cast<uint32_t>(range.vertexOffset), range.vertexCount);
+    GetIndexPool(range.indexFormat).allocator.Free(range.firstIndex, range.indexCount);
+    live[id_] = false;
+    freeIds.push_back(id_);
+    allocationCount--;
+}
+
+void GeometryArena::RetireFrame() {
+    frameIndex++;
+    const uint64_t framesInFlight = ctx->getNumSwapchainImages();
+    while (!pendingFrees.empty() && pendingFrees.front().frame + framesInFlight < frameIndex) {
+        FreeNow(pendingFrees.front().id);
+        pendingFrees.pop_front();
+    }
+}
+
+void GeometryArena::Defragment() {
+    // Compaction writes fresh buffers, so ranges pending release can go right away
+    while (!pendingFrees.empty()) {
+        FreeNow(pendingFrees.front().id);
+        pendingFrees.pop_front();
+    }
+
+    auto compact = [&](Pool& pool, auto&& getOffset, auto&& getCount, auto&& belongs) {
+        std::vector<uint32_t> ids;
+        for (uint32_t id = 0; id < ranges.size(); ++id) {
+            if (live[id] && belongs(ranges[id])) ids.push_back(id);
+        }
+        std::sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) { return getOffset(ranges[a]) < getOffset(ranges[b]); });
+
+        // Sorted by offset, so moving each range down never overwrites one not yet moved
+        uint32_t cursor = 0;
+        for (uint32_t id : ids) {
+            auto& offset = getOffset(ranges[id]);
+            const uint32_t count = getCount(ranges[id]);
+            if (uint32_t(offset) != cursor) {
+                std::memmove(pool.shadow.data() + size_t(cursor) * pool.elementSize,
+                             pool.shadow.data() + size_t(offset) * pool.elementSize, size_t(count) * pool.elementSize);
+                offset = static_cast<std::remove_reference_t<decltype(offset)>>(cursor);
+            }
+            cursor += count;
+        }
+        pool.allocator.Reset(cursor);
+        RecreateBuffer(pool);
+    };
+
+    compact(vertexPool, [](GeometryRange& r) -> int32_t& { return r.vertexOffset; },
+            [](const GeometryRange& r) { return r.vertexCount; }, [](const GeometryRange&) { return true; });
+    for (lvk::IndexFormat format : {lvk::IndexFormat_UI16, lvk::IndexFormat_UI32}) {
+        compact(GetIndexPool(format), [](GeometryRange& r) -> uint32_t& { return r.firstIndex; },
+                [](const GeometryRange& r) { return r.indexCount; }, [format](const GeometryRange& r) { return r.indexFormat == format; });
+    }
+    defragmentations++;
+}
+
+GeometryArenaStats GeometryArena::GetStats() const {
+    GeometryArenaStats stats;
+    stats.allocations = allocationCount;
+    stats.growths = growths;
+    stats.defragmentations = defragmentations;
+    for (const Pool* pool : {&vertexPool, &indexPools[0], &indexPools[1]}) {
+        stats.capacityBytes += pool->shadow.size();
+        stats.usedBytes += size_t(pool->allocator.GetUsedSize()) * pool->elementSize;
+        stats.fragmentation = std::max(stats.fragmentation, pool->allocator.GetFragmentation());
+    }
+    return stats;
+}
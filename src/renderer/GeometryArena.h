@@ -0,0 +1,129 @@
+#pragma once
+#include <core/RangeAllocator.h>
+#include <lvk/LVK.h>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class GeometryArena;
+
+/// Location of one mesh inside the arena, in elements, ready for cmdDrawIndexed(indexCount, 1, firstIndex, vertexOffset)
+struct GeometryRange {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    int32_t vertexOffset = 0;
+    uint32_t vertexCount = 0;
+    lvk::IndexFormat indexFormat = lvk::IndexFormat_UI32;
+};
+
+/// Owning handle to a sub-allocation. Offsets can move on GeometryArena::Defragment(),
+/// so always look them up through GeometryArena::GetRange() when recording draws.
+class GeometryAllocation {
+public:
+    GeometryAllocation() = default;
+    ~GeometryAllocation();
+
+    GeometryAllocation(const GeometryAllocation&) = delete;
+    GeometryAllocation& operator=(const GeometryAllocation&) = delete;
+    GeometryAllocation(GeometryAllocation&& other_) noexcept;
+    GeometryAllocation& operator=(GeometryAllocation&& other_) noexcept;
+
+    [[nodiscard]] bool IsValid() const { return arena != nullptr; }
+    /// Unique among live allocations of the arena; usable as a key for batching draws of the same mesh
+    [[nodiscard]] uint32_t GetId() const { return id; }
+    void Reset();
+
+private:
+    friend class GeometryArena;
+    GeometryAllocation(GeometryArena* arena_, uint32_t id_) : arena(arena_), id(id_) {}
+
+    GeometryArena* arena = nullptr;
+    uint32_t id = 0;
+};
+
+struct GeometryArenaStats {
+    uint32_t allocations = 0;
+    size_t capacityBytes = 0;
+    size_t usedBytes = 0;
+    /// Worst fragmentation over the vertex and index pools (see RangeAllocator::GetFragmentation)
+    float fragmentation = 0.0f;
+    uint32_t growths = 0;
+    uint32_t defragmentations = 0;
+};
+
+/// All mesh geometry in one vertex buffer and one index buffer per index width, so a frame
+/// binds them once and every draw is just offsets. Meshes are sub-allocated with a first-fit
+/// free list; a full pool grows into a larger buffer, and Defragment() compacts live ranges.
+///
+/// A CPU copy of each pool is kept so growing or compacting re-uploads into a fresh buffer
+/// instead of touching one the GPU may still be reading; the old buffer is released by LVK's
+/// deferred destruction. Freed ranges are only reused after the frames in flight have retired.
+class GeometryArena {
+public:
+    static constexpr uint32_t kDefaultVertexCapacity = 1u << 18; // vertices
+    static constexpr uint32_t kDefaultIndexCapacity = 1u << 20;  // indices per index width
+
+    GeometryArena(lvk::IContext* ctx_, uint32_t vertexStride_,
+                  uint32_t vertexCapacity_ = kDefaultVertexCapacity, uint32_t indexCapacity_ = kDefaultIndexCapacity);
+    ~GeometryArena();
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    /// Copies a mesh into the arena and uploads it. Returns an invalid allocation for empty input.
+    GeometryAllocation Allocate(const void* vertexData_, uint32_t vertexCount_,
+                                const void* indexData_, uint32_t indexCount_, lvk::IndexFormat indexFormat_);
+    [[nodiscard]] const GeometryRange& GetRange(const GeometryAllocation& allocation_) const { return ranges[allocation_.id]; }
+
+    /// Buffers can be replaced by growth or defragmentation; query them every frame
+    [[nodiscard]] lvk::BufferHandle GetVertexBuffer() const { return vertexPool.buffer; }
+    [[nodiscard]] lvk::BufferHandle GetIndexBuffer(lvk::IndexFormat indexFormat_) const { return GetIndexPool(indexFormat_).buffer; }
+    [[nodiscard]] uint32_t GetVertexStride() const { return vertexPool.elementSize; }
+    void Bind(lvk::ICommandBuffer& cmd_, lvk::IndexFormat indexFormat_) const;
+
+    /// Packs all live ranges to the front of fresh buffers; offsets returned by GetRange() change
+    void Defragment();
+    /// Call once per frame; releases ranges freed more than a swapchain's worth of frames ago
+    void RetireFrame();
+
+    [[nodiscard]] GeometryArenaStats GetStats() const;
+
+private:
+    friend class GeometryAllocation;
+
+    struct Pool {
+        lvk::Holder<lvk::BufferHandle> buffer;
+        std::vector<uint8_t> shadow;
+        RangeAllocator allocator;
+        uint32_t elementSize = 0;
+        uint8_t usage = 0;
+        const char* debugName = "";
+    };
+
+    struct PendingFree {
+        uint64_t frame;
+        uint32_t id;
+    };
+
+    Pool& GetIndexPool(lvk::IndexFormat indexFormat_) { return indexPools[indexFormat_ == lvk::IndexFormat_UI16 ? 0 : 1]; }
+    const Pool& GetIndexPool(lvk::IndexFormat indexFormat_) const { return indexPools[indexFormat_ == lvk::IndexFormat_UI16 ? 0 : 1]; }
+
+    void InitPool(Pool& pool_, uint32_t elementSize_, uint32_t capacity_, uint8_t usage_, const char* debugName_);
+    uint32_t AllocateInPool(Pool& pool_, const void* data_, uint32_t count_);
+    void RecreateBuffer(Pool& pool_);
+    void Release(uint32_t id_);
+    void FreeNow(uint32_t id_);
+
+    lvk::IContext* ctx;
+    Pool vertexPool;
+    Pool indexPools[2]; // 16-bit, 32-bit
+
+    std::vector<GeometryRange> ranges;
+    std::vector<bool> live;
+    std::vector<uint32_t> freeIds;
+    std::deque<PendingFree> pendingFrees;
+    uint64_t frameIndex = 0;
+    uint32_t allocationCount = 0;
+    uint32_t growths = 0;
+    uint32_t defragmentations = 0;
+};
@@ -0,0 +1,75 @@
+#include <renderer/GpuProfiler.h>
+#include <core/Profiler.h>
+
+GpuProfiler::GpuProfiler(lvk::IContext* ctx_) : ctx(ctx_) {
+    // One more slot than frames in flight, as GeometryArena waits before reusing a range
+    slots.resize(ctx->getNumSwapchainImages() + 1);
+    queries = ctx->createQueryPool(kQueriesPerSlot * static_cast<uint32_t>(slots.size()), "Query pool: GPU profiler");
+    timestamps.resize(kQueriesPerSlot);
+}
+
+void GpuProfiler::ReadBack(Slot& slot_, uint32_t firstQuery_) {
+    const uint32_t queryCount = 2 + 2 * static_cast<uint32_t>(slot_.zoneNames.size());
+    if (!ctx->getQueryPoolResults(queries, firstQuery_, queryCount, queryCount * sizeof(uint64_t), timestamps.data(),
+                                  sizeof(uint64_t))) {
+        return;
+    }
+
+    const double ticksToUs = ctx->getTimestampPeriodToMs() * 1000.0;
+    auto toUs = [&](uint64_t begin_, uint64_t end_) { return static_cast<double>(end_ - begin_) * ticksToUs; };
+    const uint64_t frameStart = timestamps[0];
+    Profiler& profiler = Profiler::Get();
+    profiler.AddGpuEvent("GPU frame", slot_.cpuStartUs, toUs(frameStart, timestamps[1]));
+    for (uint32_t i = 0; i < slot_.zoneNames.size(); ++i) {
+        const uint64_t begin = timestamps[2 + 2 * i];
+        profiler.AddGpuEvent(slot_.zoneNames[i], slot_.cpuStartUs + toUs(frameStart, begin), toUs(begin, timestamps[3 + 2 * i]));
+    }
+    lastFrameMs = static_cast<float>(toUs(frameStart, timestamps[1]) / 1000.0);
+    newResult = true;
+}
+
+void GpuProfiler::BeginFrame(lvk::ICommandBuffer& cmd_) {
+    const uint32_t slotIndex = static_cast<uint32_t>(frame % slots.size());
+    const uint32_t firstQuery = slotIndex * kQueriesPerSlot;
+    Slot& slot = slots[slotIndex];
+    newResult = false;
+    if (slot.pending) {
+        ReadBack(slot, firstQuery);
+        slot.pending = false;
+    }
+
+    slot.cpuStartUs = Profiler::Get().Now();
+    slot.zoneNames.clear();
+    openZones.clear();
+    cmd_.cmdResetQueryPool(queries, firstQuery, kQueriesPerSlot);
+    cmd_.cmdWriteTimestamp(queries, firstQuery);
+}
+
+void GpuProfiler::EndFrame(lvk::ICommandBuffer& cmd_) {
+    const uint32_t slotIndex = static_cast<uint32_t>(frame % slots.size());
+    cmd_.cmdWriteTimestamp(queries, slotIndex * kQueriesPerSlot + 1);
+    slots[slotIndex].pending = true;
+    frame++;
+}
+
+void GpuProfiler::BeginZone(lvk::ICommandBuffer& cmd_, const char* name_) {
+    const uint32_t slotIndex = static_cast<uint32_t>(frame % slots.size());
+    Slot& slot = slots[slotIndex];
+    if (slot.zoneNames.size() == kMaxZones) {
+        openZones.push_back(UINT32_MAX);
+        return;
+    }
+    const uint32_t zone = static_cast<uint32_t>(slot.zoneNames.size());
+    slot.zoneNames.push_back(name_);
+    openZones.push_back(zone);
+    cmd_.cmdWriteTimestamp(queries, slotIndex * kQueriesPerSlot + 2 + 2 * zone);
+}
+
+void GpuProfiler::EndZone(lvk::ICommandBuffer& cmd_) {
+    if (openZones.empty()) return;
+    const uint32_t zone = openZones.back();
+    openZones.pop_back();
+    if (zone == UINT32_MAX) return;
+    const uint32_t slotIndex = static_cast<uint32_t>(frame % slots.size());
+    cmd_.cmdWriteTimestamp(queries, slotIndex * kQueriesPerSlot + 3 + 2 * zone);
+}
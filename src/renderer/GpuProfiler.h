@@ -0,0 +1,60 @@
+#pragma once
+#include <lvk/LVK.h>
+#include <cstdint>
+#include <vector>
+
+/// GPU time of whole frames and of zones within them, from timestamp queries.
+///
+/// Every frame in flight has its own range of queries. A range is read back when its slot comes
+/// around again, more frames later than the swapchain lets the CPU run ahead, so the GPU is done
+/// with it and reading never stalls. Results are therefore a few frames old. Zones go to the
+/// Profiler, as GPU events of the frame they are read back in.
+class GpuProfiler {
+public:
+    /// Zones per frame; further ones are not timed
+    static constexpr uint32_t kMaxZones = 64;
+
+    explicit GpuProfiler(lvk::IContext* ctx_);
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    /// Reads back the slot's previous frame, then starts timing this one; record before any
+    /// other command of the frame, outside a render pass
+    void BeginFrame(lvk::ICommandBuffer& cmd_);
+    /// Stops timing the frame; record after its last command
+    void EndFrame(lvk::ICommandBuffer& cmd_);
+
+    /// Zones may nest; name_ must outlive the profiler (string literals, pass names)
+    void BeginZone(lvk::ICommandBuffer& cmd_, const char* name_);
+    void EndZone(lvk::ICommandBuffer& cmd_);
+
+    /// True when the last BeginFrame() read back a finished frame
+    [[nodiscard]] bool HasNewResult() const { return newResult; }
+    /// GPU milliseconds of the latest finished frame, 0 until one finished
+    [[nodiscard]] float GetLastFrameMs() const { return lastFrameMs; }
+
+private:
+    /// Queries of a slot: frame start and end, then a begin/end pair per zone
+    static constexpr uint32_t kQueriesPerSlot = 2 + 2 * kMaxZones;
+
+    struct Slot {
+        /// Holds a submitted frame not read back yet
+        bool pending = false;
+        /// Profiler time the frame started recording, where its GPU events are placed
+        double cpuStartUs = 0.0;
+        std::vector<const char*> zoneNames;
+    };
+
+    void ReadBack(Slot& slot_, uint32_t firstQuery_);
+
+    lvk::IContext* ctx;
+    lvk::Holder<lvk::QueryPoolHandle> queries;
+    std::vector<Slot> slots;
+    uint64_t frame = 0;
+    /// Zones begun but not ended this frame, UINT32_MAX for ones past kMaxZones
+    std::vector<uint32_t> openZones;
+    std::vector<uint64_t> timestamps;
+    float lastFrameMs = 0.0f;
+    bool newResult = false;
+};
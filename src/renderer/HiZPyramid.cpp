@@ -0,0 +1,75 @@
+#include <renderer/HiZPyramid.h>
+#include <algorithm>
+#include <bit>
+
+namespace {
+constexpr uint32_t kGroupSize = 8; // local_size_x/y in hiz_build.comp
+
+/// Matches the push constants in hiz_build.comp
+struct BuildPushConstants {
+    uint32_t source;
+    uint32_t destination;
+    uint32_t sourceWidth;
+    uint32_t sourceHeight;
+    uint32_t destinationWidth;
+    uint32_t destinationHeight;
+    uint32_t fromDepth; // 1 when source is the depth buffer, 0 for the previous pyramid level
+    uint32_t _padding;
+};
+}
+
+HiZPyramid::HiZPyramid(lvk::IContext* ctx_, lvk::ShaderModuleHandle buildShader_) : ctx(ctx_) {
+    pipeline = ctx->createComputePipeline({
+        .smComp = buildShader_,
+        .debugName = "Pipeline: Hi-Z build",
+    });
+}
+
+void HiZPyramid::Resize(const lvk::Dimensions& depthSize_) {
+    if (texture.valid() && depthSize_.width == depthSize.width && depthSize_.height == depthSize.height) return;
+    depthSize = depthSize_;
+
+    size = { std::bit_floor(std::max(depthSize_.width, 1u)), std::bit_floor(std::max(depthSize_.height, 1u)), 1 };
+    const uint32_t mipCount = static_cast<uint32_t>(std::bit_width(std::max(size.width, size.height)));
+
+    mipViews.clear();
+    texture = ctx->createTexture({
+        .format       = lvk::Format_R_F32,
+        .dimensions   = size,
+        .usage        = lvk::TextureUsageBits_Sampled | lvk::TextureUsageBits_Storage,
+        .numMipLevels = mipCount,
+        .debugName    = "Texture: Hi-Z pyramid",
+    });
+    mipViews.reserve(mipCount);
+    for (uint32_t level = 0; level < mipCount; ++level) {
+        mipViews.push_back(ctx->createTextureView(texture, { .mipLevel = level, .numMipLevels = 1 }, "Texture: Hi-Z level"));
+    }
+}
+
+void HiZPyramid::Build(lvk::ICommandBuffer& cmd_, lvk::TextureHandle depth_) const {
+    if (!texture.valid()) return;
+
+    cmd_.cmdBindComputePipeline(pipeline);
+    uint32_t sourceWidth = depthSize.width;
+    uint32_t sourceHeight = depthSize.height;
+    for (uint32_t level = 0; level < GetMipCount(); ++level) {
+        const uint32_t width = std::max(size.width >> level, 1u);
+        const uint32_t height = std::max(size.height >> level, 1u);
+        const BuildPushConstants pushConstants = {
+            .source = level == 0 ? depth_.index() : mipViews[level - 1].index(),
+            .destination = mipViews[level].index(),
+            .sourceWidth = sourceWidth,
+            .sourceHeight = sourceHeight,
+            .destinationWidth = width,
+            .destinationHeight = height,
+            .fromDepth = level == 0 ? 1u : 0u,
+        };
+        cmd_.cmdPushConstants(pushConstants);
+        // Listing the pyramid makes each level wait for the writes of the one before it
+        cmd_.cmdDispatchThreadGroups({ (width + kGroupSize - 1) / kGroupSize, (height + kGroupSize - 1) / kGroupSize, 1 }, {
+            .textures = { level == 0 ? depth_ : lvk::TextureHandle(texture), texture },
+        });
+        sourceWidth = width;
+        sourceHeight = height;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <lvk/LVK.h>
+#include <cstdint>
+#include <vector>
+
+/// Hierarchical-Z pyramid of a depth buffer for occlusion tests. Every texel of the R32F mip chain
+/// holds the farthest depth of the area it covers, so an object whose nearest depth lies behind
+/// the texels under its screen rectangle is hidden. Level 0 is the depth buffer rounded down to
+/// powers of two, so each coarser level halves exactly and a rectangle never needs more than
+/// 2x2 texels of the right level.
+///
+/// Built on the GPU by hiz_build.comp, one dispatch per level.
+class HiZPyramid {
+public:
+    HiZPyramid(lvk::IContext* ctx_, lvk::ShaderModuleHandle buildShader_);
+
+    HiZPyramid(const HiZPyramid&) = delete;
+    HiZPyramid& operator=(const HiZPyramid&) = delete;
+
+    /// (Re)creates the mip chain for a depth buffer of the given size; does nothing if it already matches
+    void Resize(const lvk::Dimensions& depthSize_);
+    /// Reduces depth_ into every level; must be recorded outside a render pass. depth_ needs
+    /// TextureUsageBits_Sampled.
+    void Build(lvk::ICommandBuffer& cmd_, lvk::TextureHandle depth_) const;
+
+    [[nodiscard]] lvk::TextureHandle GetTexture() const { return texture; }
+    [[nodiscard]] uint32_t GetWidth() const { return size.width; }
+    [[nodiscard]] uint32_t GetHeight() const { return size.height; }
+    [[nodiscard]] uint32_t GetMipCount() const { return static_cast<uint32_t>(mipViews.size()); }
+
+private:
+    lvk::IContext* ctx;
+    lvk::Holder<lvk::ComputePipelineHandle> pipeline;
+    lvk::Holder<lvk::TextureHandle> texture;
+    /// Single-level views, bound as storage images while their level is written
+    std::vector<lvk::Holder<lvk::TextureHandle>> mipViews;
+    lvk::Dimensions depthSize = {};
+    lvk::Dimensions size = {};
+};
@@ -0,0 +1,317 @@
+#include <renderer/IndirectRenderer.h>
+#include <assets/AssetRegistry.h>
+#include <components/TransformHierarchy.h>
+#include <core/Frustum.h>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+constexpr uint32_t kCullGroupSize = 64; // local_size_x in cull_instances.comp
+}
+
+IndirectRenderer::IndirectRenderer(lvk::IContext* ctx_) : ctx(ctx_) {
+    // One slot more than the swapchain so the slot being written is never one the GPU may still read
+    frames.resize(ctx->getNumSwapchainImages() + 1);
+}
+
+void IndirectRenderer::UpdateTransforms(const std::vector<glm::mat4>& worldMatrices_, const std::vector<TransformRange>& changedRanges_) {
+    stats.uploadedTransforms = 0;
+    const uint32_t nodeCount = static_cast<uint32_t>(worldMatrices_.size());
+    if (nodeCount == 0) return;
+
+    // A regrown buffer starts empty, so it needs every node regardless of what changed
+    const bool regrown = nodeCount > transformCapacity;
+    if (regrown) {
+        transformCapacity = std::max(nodeCount, transformCapacity * 2);
+        transformBuffer = ctx->createBuffer({
+            .usage = lvk::BufferUsageBits_Storage,
+            .storage = lvk::StorageType_Device,
+            .size = sizeof(GpuTransform) * transformCapacity,
+            .debugName = "Buffer: transforms"
+        });
+        // Zeroed history reads as "visible last frame" for the first culled frame; after a regrow
+        // the late phase simply catches everything once
+        const std::vector<uint32_t> history(transformCapacity, 0);
+        visibilityHistory = ctx->createBuffer({
+            .usage = lvk::BufferUsageBits_Storage,
+            .storage = lvk::StorageType_Device,
+            .size = sizeof(uint32_t) * transformCapacity,
+            .data = history.data(),
+            .debugName = "Buffer: visibility history"
+        });
+    }
+    transforms.resize(nodeCount);
+
+    auto uploadRange = [&](uint32_t first_, uint32_t count_) {
+        for (uint32_t node = first_; node < first_ + count_; ++node) {
+            const glm::mat4& model = worldMatrices_[node];
+            const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+            GpuTransform& transform = transforms[node];
+            transform.model = model;
+            transform.normalMatrix = glm::mat3x4(glm::vec4(normalMatrix[0], 0.0f), glm::vec4(normalMatrix[1], 0.0f), glm::vec4(normalMatrix[2], 0.0f));
+        }
+        ctx->upload(transformBuffer, transforms.data() + first_, sizeof(GpuTransform) * count_, sizeof(GpuTransform) * first_);
+        stats.uploadedTransforms += count_;
+    };
+
+    if (regrown) {
+        uploadRange(0, nodeCount);
+        return;
+    }
+    for (const TransformRange& range : changedRanges_) {
+        uploadRange(range.first, range.count);
+    }
+}
+
+void IndirectRenderer::SetCullShader(lvk::ShaderModuleHandle shader_) {
+    cullPipeline = ctx->createComputePipeline({
+        .smComp = shader_,
+        .debugName = "Pipeline: instance culling",
+    });
+}
+
+void IndirectRenderer::BeginFrame() {
+    batches.clear();
+    batchLookup.clear();
+    pending.clear();
+}
+
+void IndirectRenderer::AddInstance(const GeometryArena& geometry_, const MeshBuffers& mesh_, uint32_t lod_, uint32_t transformIndex_,
+                                   uint32_t textureIndex_, uint32_t samplerIndex_, uint32_t textureFlags_) {
+    if (!mesh_.geometry.IsValid() || transformIndex_ >= transforms.size()) return;
+
+    lod_ = std::min(lod_, mesh_.lodCount - 1);
+    const uint64_t key = (uint64_t(mesh_.geometry.GetId()) << 32) | lod_;
+    auto [it, inserted] = batchLookup.try_emplace(key, static_cast<uint32_t>(batches.size()));
+    if (inserted) {
+        batches.push_back({ .range = mesh_.GetLodRange(geometry_.GetRange(mesh_.geometry), lod_) });
+    }
+    batches[it->second].instanceCount++;
+
+    PendingInstance& entry = pending.emplace_back();
+    entry.batch = it->second;
+    InstanceData& instance = entry.data;
+    instance.transformIndex = transformIndex_;
+    instance.positionScale = mesh_.positionScale;
+    instance.positionOffset = mesh_.positionOffset;
+    instance.textureIndex = textureIndex_;
+    instance.samplerIndex = samplerIndex_;
+    instance.textureFlags = textureFlags_;
+    entry.sphere = glm::vec4(mesh_.sphereCenter, mesh_.sphereRadius);
+}
+
+void IndirectRenderer::Upload(const GpuCullingDesc* culling_) {
+    // Lay each batch's instances out contiguously (counting sort) and emit one instanced command per batch
+    commands[0].clear();
+    commands[1].clear();
+    uint32_t firstInstance = 0;
+    for (Batch& batch : batches) {
+        batch.firstInstance = firstInstance;
+        firstInstance += batch.instanceCount;
+        std::vector<DrawIndexedIndirectCommand>& group = commands[batch.range.indexFormat == lvk::IndexFormat_UI16 ? 0 : 1];
+        batch.drawIndex = static_cast<uint32_t>(group.size());
+        group.push_back({
+            .indexCount = batch.range.indexCount,
+            .instanceCount = batch.instanceCount,
+            .firstIndex = batch.range.firstIndex,
+            .vertexOffset = batch.range.vertexOffset,
+            .firstInstance = batch.firstInstance,
+        });
+        batch.instanceCount = 0; // reused as the fill cursor below
+    }
+    for (Batch& batch : batches) {
+        if (batch.range.indexFormat != lvk::IndexFormat_UI16) {
+            batch.drawIndex += static_cast<uint32_t>(commands[0].size());
+        }
+    }
+
+    gpuCulling = culling_ && cullPipeline.valid();
+    instances.resize(pending.size());
+    bounds.resize(gpuCulling ? pending.size() : 0);
+    for (const PendingInstance& entry : pending) {
+        Batch& batch = batches[entry.batch];
+        const uint32_t index = batch.firstInstance + batch.instanceCount++;
+        instances[index] = entry.data;
+        if (gpuCulling) {
+            bounds[index] = { .sphere = entry.sphere, .drawIndex = batch.drawIndex };
+        }
+    }
+
+    currentFrame = (currentFrame + 1) % static_cast<uint32_t>(frames.size());
+    FrameBuffers& frame = frames[currentFrame];
+    ReadBackCullingStats(frame);
+
+    const uint32_t instanceCount = static_cast<uint32_t>(instances.size());
+    const uint32_t commandCount = static_cast<uint32_t>(commands[0].size() + commands[1].size());
+    stats.instances = instanceCount;
+    stats.drawCommands = commandCount;
+    stats.indirectCalls = uint32_t(!commands[0].empty()) + uint32_t(!commands[1].empty());
+    if (commandCount == 0) {
+        gpuCulling = false;
+        return;
+    }
+
+    // Culling keeps one copy of the commands per phase
+    const uint32_t uploadedCommands = gpuCulling ? commandCount * 2 : commandCount;
+
+    // Grow geometrically; the replaced buffers are released by LVK's deferred destruction
+    if (instanceCount > frame.instanceCapacity) {
+        frame.instanceCapacity = std::max(instanceCount, frame.instanceCapacity * 2);
+        frame.instances = ctx->createBuffer({
+            .usage = lvk::BufferUsageBits_Storage,
+            .storage = lvk::StorageType_HostVisible,
+            .size = sizeof(InstanceData) * frame.instanceCapacity,
+            .debugName = "Buffer: instances"
+        });
+    }
+    if (uploadedCommands > frame.commandCapacity) {
+        frame.commandCapacity = std::max(uploadedCommands, frame.commandCapacity * 2);
+        frame.commands = ctx->createBuffer({
+            .usage = lvk::BufferUsageBits_Indirect | lvk::BufferUsageBits_Storage,
+            .storage = lvk::StorageType_HostVisible,
+            .size = sizeof(DrawIndexedIndirectCommand) * frame.commandCapacity,
+            .debugName = "Buffer: indirect commands"
+        });
+    }
+
+    ctx->upload(frame.instances, instances.data(), sizeof(InstanceData) * instanceCount);
+    // The cull pass counts the instances back up from 0
+    if (gpuCulling) {
+        for (std::vector<DrawIndexedIndirectCommand>& group : commands) {
+            for (DrawIndexedIndirectCommand& command : group) {
+                command.instanceCount = 0;
+            }
+        }
+    }
+    // 16-bit draws first, then 32-bit ones; when culling, again for the late phase, which
+    // compacts into the second half of the culled instances
+    size_t offset = 0;
+    for (uint32_t phase = 0; phase < (gpuCulling ? 2u : 1u); ++phase) {
+        for (std::vector<DrawIndexedIndirectCommand>& group : commands) {
+            if (group.empty()) continue;
+            if (phase == 1) {
+                for (DrawIndexedIndirectCommand& command : group) {
+                    command.firstInstance += instanceCount;
+                }
+            }
+            ctx->upload(frame.commands, group.data(), sizeof(DrawIndexedIndirectCommand) * group.size(), offset);
+            offset += sizeof(DrawIndexedIndirectCommand) * group.size();
+        }
+    }
+    frame.culledCommandCount = gpuCulling ? commandCount : 0;
+    if (!gpuCulling) return;
+
+    if (instanceCount > frame.boundsCapacity) {
+        frame.boundsCapacity = std::max(instanceCount, frame.boundsCapacity * 2);
+        frame.bounds = ctx->createBuffer({
+            .usage = lvk::BufferUsageBits_Storage,
+            .storage = lvk::StorageType_HostVisible,
+            .size = sizeof(InstanceBounds) * frame.boundsCapacity,
+            .debugName = "Buffer: instance bounds"
+        });
+        frame.culledInstances = ctx->createBuffer({
+            .usage = lvk::BufferUsageBits_Storage,
+            .storage = lvk::StorageType_Device,
+            .size = sizeof(InstanceData) * frame.boundsCapacity * 2,
+            .debugName = "Buffer: culled instances"
+        });
+    }
+    if (!frame.cullParams.valid()) {
+        frame.cullParams = ctx->createBuffer({
+            .usage = lvk::BufferUsageBits_Storage,
+            .storage = lvk::StorageType_HostVisible,
+            .size = sizeof(GpuCullParams),
+            .debugName = "Buffer: cull params"
+        });
+    }
+    ctx->upload(frame.bounds, bounds.data(), sizeof(InstanceBounds) * instanceCount);
+
+    hiz = culling_->hiz;
+    GpuCullParams params = {
+        .viewProj = culling_->viewProj,
+        .instances = ctx->gpuAddress(frame.instances),
+        .bounds = ctx->gpuAddress(frame.bounds),
+        .transforms = ctx->gpuAddress(transformBuffer),
+        .commands = ctx->gpuAddress(frame.commands),
+        .culledInstances = ctx->gpuAddress(frame.culledInstances),
+        .history = ctx->gpuAddress(visibilityHistory),
+        .instanceCount = instanceCount,
+        .commandCount = commandCount,
+        .frameIndex = ++cullFrame,
+        .hizTexture = hiz.index(),
+        .hizSize = glm::vec2(culling_->hizWidth, culling_->hizHeight),
+        .hizMipCount = culling_->hizMipCount,
+        .occlusion = hiz.valid() && culling_->hizMipCount > 0 ? 1u : 0u,
+    };
+    const Frustum frustum = Frustum::FromViewProjection(culling_->viewProj);
+    std::copy(std::begin(frustum.planes), std::end(frustum.planes), params.frustumPlanes);
+    ctx->upload(frame.cullParams, &params, sizeof(params));
+}
+
+void IndirectRenderer::ReadBackCullingStats(const FrameBuffers& frame_) {
+    stats.gpuEarlyInstances = 0;
+    stats.gpuLateInstances = 0;
+    if (frame_.culledCommandCount == 0) return;
+
+    // The slot is only rewritten once the GPU is done with it, so its counts are final
+    const auto* gpuCommands = reinterpret_cast<const DrawIndexedIndirectCommand*>(ctx->getMappedPtr(frame_.commands));
+    if (!gpuCommands) return;
+    for (uint32_t i = 0; i < frame_.culledCommandCount; ++i) {
+        stats.gpuEarlyInstances += gpuCommands[i].instanceCount;
+        stats.gpuLateInstances += gpuCommands[frame_.culledCommandCount + i].instanceCount;
+    }
+}
+
+void IndirectRenderer::Cull(lvk::ICommandBuffer& cmd_, CullPhase phase_) const {
+    if (!gpuCulling) return;
+    const FrameBuffers& frame = frames[currentFrame];
+
+    struct PushConstants {
+        uint64_t params;
+        uint32_t phase;
+        uint32_t _padding;
+    } pushConstants = { ctx->gpuAddress(frame.cullParams), static_cast<uint32_t>(phase_), 0 };
+
+    cmd_.cmdBindComputePipeline(cullPipeline);
+    cmd_.cmdPushConstants(pushConstants);
+    // The late phase reads the pyramid and the early phase's flags, and the history is read
+    // across frames
+    const bool late = phase_ == CullPhase::Late;
+    cmd_.cmdDispatchThreadGroups({ (stats.instances + kCullGroupSize - 1) / kCullGroupSize, 1, 1 }, {
+        .textures = { late ? hiz : lvk::TextureHandle{} },
+        .buffers = { frame.bounds, visibilityHistory },
+    });
+}
+
+lvk::Dependencies IndirectRenderer::GetDrawDependencies() const {
+    if (!gpuCulling) return {};
+    const FrameBuffers& frame = frames[currentFrame];
+    // Commands and instances for the draws; bounds and history so the next culling phase is
+    // ordered after the one that wrote them
+    return { .buffers = { frame.commands, frame.culledInstances, frame.bounds, visibilityHistory } };
+}
+
+void IndirectRenderer::Draw(lvk::ICommandBuffer& cmd_, const GeometryArena& geometry_, const glm::mat4& viewProj_,
+                            CullPhase phase_) const {
+    if (stats.drawCommands == 0) return;
+    if (!gpuCulling && phase_ == CullPhase::Late) return;
+    const FrameBuffers& frame = frames[currentFrame];
+
+    struct PushConstants {
+        glm::mat4 viewProj;
+        uint64_t instances;
+        uint64_t transforms;
+    } pushConstants = { viewProj_, ctx->gpuAddress(gpuCulling ? frame.culledInstances : frame.instances),
+                        ctx->gpuAddress(transformBuffer) };
+    cmd_.cmdPushConstants(pushConstants);
+
+    cmd_.cmdBindVertexBuffer(0, geometry_.GetVertexBuffer());
+    size_t offset = phase_ == CullPhase::Late ? sizeof(DrawIndexedIndirectCommand) * stats.drawCommands : 0;
+    for (lvk::IndexFormat format : {lvk::IndexFormat_UI16, lvk::IndexFormat_UI32}) {
+        const std::vector<DrawIndexedIndirectCommand>& group = commands[format == lvk::IndexFormat_UI16 ? 0 : 1];
+        if (group.empty()) continue;
+        cmd_.cmdBindIndexBuffer(geometry_.GetIndexBuffer(format), format);
+        cmd_.cmdDrawIndexedIndirect(frame.commands, offset, static_cast<uint32_t>(group.size()), sizeof(DrawIndexedIndirectCommand));
+        offset += sizeof(DrawIndexedIndirectCommand) * group.size();
+    }
+}
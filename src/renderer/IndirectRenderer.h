@@ -0,0 +1,219 @@
+#pragma once
+#include <renderer/GeometryArena.h>
+#include <glm/glm.hpp>
+#include <lvk/LVK.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct MeshBuffers;
+struct TransformRange;
+
+/// World transform of one TransformHierarchy node as read by blinn_phong_indirect.vert (std430 layout)
+struct GpuTransform {
+    glm::mat4 model;
+    /// Inverse transpose of the model's upper 3x3; std430 stores mat3 columns 16 bytes apart
+    glm::mat3x4 normalMatrix;
+};
+static_assert(sizeof(GpuTransform) == 112, "GpuTransform must match the std430 layout in blinn_phong_indirect.vert");
+
+/// Per-instance data read by blinn_phong_indirect.vert through a buffer reference (std430 layout)
+struct InstanceData {
+    uint32_t transformIndex; // TransformHierarchy node
+    uint32_t textureIndex;
+    uint32_t samplerIndex;
+    uint32_t textureFlags; // TextureFlagBits
+    glm::vec4 positionScale;  // packed position decode, per submesh
+    glm::vec4 positionOffset;
+};
+static_assert(sizeof(InstanceData) == 48, "InstanceData must match the std430 layout in blinn_phong_indirect.vert");
+
+/// Culling inputs of one instance, parallel to InstanceData; read by cull_instances.comp (std430 layout)
+struct InstanceBounds {
+    glm::vec4 sphere; // mesh-space center and radius of the submesh
+    uint32_t drawIndex; // command of the instance's batch within one phase
+    uint32_t drawnEarly; // written by the early phase for the late one
+    uint32_t _padding[2];
+};
+static_assert(sizeof(InstanceBounds) == 32, "InstanceBounds must match the std430 layout in cull_instances.comp");
+
+/// Matches VkDrawIndexedIndirectCommand
+struct DrawIndexedIndirectCommand {
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t firstInstance;
+};
+
+/// Per-frame parameters of cull_instances.comp (std430 layout)
+struct GpuCullParams {
+    glm::mat4 viewProj;
+    glm::vec4 frustumPlanes[6];
+    uint64_t instances;
+    uint64_t bounds;
+    uint64_t transforms;
+    uint64_t commands;
+    uint64_t culledInstances;
+    uint64_t history;
+    uint32_t instanceCount;
+    uint32_t commandCount; // per phase
+    uint32_t frameIndex;
+    uint32_t hizTexture;
+    glm::vec2 hizSize;
+    uint32_t hizMipCount;
+    uint32_t occlusion; // 0 skips the Hi-Z test
+};
+static_assert(sizeof(GpuCullParams) == 240, "GpuCullParams must match the std430 layout in cull_instances.comp");
+
+/// Two-phase occlusion culling. The early phase draws the instances that were visible last frame,
+/// building a depth buffer that already holds most occluders; the late phase tests every other
+/// instance against a Hi-Z pyramid of that depth and draws the ones it reveals. Newly visible
+/// objects therefore appear the frame they become visible instead of one frame late.
+enum class CullPhase : uint32_t {
+    Early = 0,
+    Late = 1,
+};
+
+/// Inputs of GPU culling for one frame
+struct GpuCullingDesc {
+    glm::mat4 viewProj = glm::mat4(1.0f);
+    /// Pyramid the late phase tests against; occlusion culling is skipped when empty
+    lvk::TextureHandle hiz;
+    uint32_t hizWidth = 0;
+    uint32_t hizHeight = 0;
+    uint32_t hizMipCount = 0;
+};
+
+struct IndirectRendererStats {
+    uint32_t instances = 0;
+    /// One per distinct mesh drawn this frame, each instanced over every actor using it
+    uint32_t drawCommands = 0;
+    /// cmdDrawIndexedIndirect calls, one per index width in use
+    uint32_t indirectCalls = 0;
+    /// Transforms written to the GPU by the last UpdateTransforms(); 0 when nothing moved
+    uint32_t uploadedTransforms = 0;
+    /// Instances the GPU kept in each culling phase, read back from the frame that last used the
+    /// current ring slot, so a few frames old
+    uint32_t gpuEarlyInstances = 0;
+    uint32_t gpuLateInstances = 0;
+};
+
+/// GPU-driven scene submission. Every submesh drawn in a frame becomes one InstanceData in a
+/// storage buffer. Instances of the same mesh and LOD are batched automatically into one indirect command
+/// (instanceCount > 1) over a contiguous run of the buffer starting at firstInstance, and the
+/// shader fetches each one via gl_InstanceIndex. Materials are per instance and bindless, so they
+/// never split a batch. Recording the scene costs one cmdDrawIndexedIndirect per index width
+/// regardless of the actor count.
+///
+/// World matrices live in a separate persistent device buffer mirroring the TransformHierarchy;
+/// instances only reference their node, and UpdateTransforms() re-uploads just the node ranges
+/// that changed, so a static scene uploads no transforms at all.
+///
+/// With a cull pipeline set, Upload() can hand the instances to cull_instances.comp instead:
+/// the GPU tests each one against the frustum and a Hi-Z pyramid (see CullPhase) and compacts the
+/// survivors into a copy of the batch commands, whose instanceCount starts at 0 and is advanced
+/// atomically. Visibility is remembered per hierarchy node across frames.
+///
+/// Usage per frame: UpdateTransforms(), BeginFrame(), AddInstance() for each submesh, Upload()
+/// before recording, then Draw() inside the render pass with a pipeline built from
+/// blinn_phong_indirect.vert. With GPU culling: Cull(Early) before the scene pass and Draw(Early)
+/// inside it, then build the Hi-Z from its depth, Cull(Late), and Draw(Late) in a second pass
+/// that loads the first one's attachments. Both passes take GetDrawDependencies().
+class IndirectRenderer {
+public:
+    explicit IndirectRenderer(lvk::IContext* ctx_);
+
+    IndirectRenderer(const IndirectRenderer&) = delete;
+    IndirectRenderer& operator=(const IndirectRenderer&) = delete;
+
+    /// Copies the changed nodes of worldMatrices_ (a TransformHierarchy's matrices, or a copy kept up
+    /// to date with TransformDelta) to the GPU. changedRanges_ must be sorted and within bounds.
+    void UpdateTransforms(const std::vector<glm::mat4>& worldMatrices_, const std::vector<TransformRange>& changedRanges_);
+
+    /// Enables Upload(const GpuCullingDesc*) with a pipeline built from cull_instances.comp
+    void SetCullShader(lvk::ShaderModuleHandle shader_);
+
+    void BeginFrame();
+    /// Queues one submesh at level of detail lod_; instances of the same mesh and level share a command
+    void AddInstance(const GeometryArena& geometry_, const MeshBuffers& mesh_, uint32_t lod_, uint32_t transformIndex_,
+                     uint32_t textureIndex_, uint32_t samplerIndex_, uint32_t textureFlags_);
+    /// Writes this frame's instances and commands into the next ring slot, growing it if needed.
+    /// With culling_ (and a cull shader), the draws are decided on the GPU by Cull().
+    void Upload(const GpuCullingDesc* culling_ = nullptr);
+    /// Records one culling phase; must be outside a render pass. Does nothing without GPU culling.
+    void Cull(lvk::ICommandBuffer& cmd_, CullPhase phase_) const;
+    /// Binds the arena and issues the indirect draws; the render pipeline must already be bound.
+    /// Without GPU culling everything is drawn in the early phase and the late phase draws nothing.
+    void Draw(lvk::ICommandBuffer& cmd_, const GeometryArena& geometry_, const glm::mat4& viewProj_,
+              CullPhase phase_ = CullPhase::Early) const;
+
+    /// Buffers the render passes must wait on after Cull(); empty without GPU culling
+    [[nodiscard]] lvk::Dependencies GetDrawDependencies() const;
+    [[nodiscard]] bool IsGpuCulling() const { return gpuCulling; }
+
+    [[nodiscard]] const IndirectRendererStats& GetStats() const { return stats; }
+
+private:
+    /// Buffers for one frame in flight, host-visible except culledInstances
+    struct FrameBuffers {
+        lvk::Holder<lvk::BufferHandle> instances;
+        lvk::Holder<lvk::BufferHandle> commands;
+        lvk::Holder<lvk::BufferHandle> bounds;
+        lvk::Holder<lvk::BufferHandle> cullParams;
+        /// Early survivors in the first half, late ones in the second
+        lvk::Holder<lvk::BufferHandle> culledInstances;
+        uint32_t instanceCapacity = 0;
+        uint32_t commandCapacity = 0;
+        uint32_t boundsCapacity = 0;
+        /// Commands per phase the GPU filled in when this slot was last culled, 0 if it was not
+        uint32_t culledCommandCount = 0;
+    };
+
+    /// Sums the instance counts the GPU wrote into the slot's commands the last time it was culled
+    void ReadBackCullingStats(const FrameBuffers& frame_);
+
+    lvk::IContext* ctx;
+    std::vector<FrameBuffers> frames;
+    uint32_t currentFrame = 0;
+
+    /// Device-local; uploads go through LVK's staging path, which is queue-ordered after earlier frames
+    lvk::Holder<lvk::BufferHandle> transformBuffer;
+    uint32_t transformCapacity = 0;
+    /// CPU copy of the buffer contents in GpuTransform layout
+    std::vector<GpuTransform> transforms;
+    /// Per node, the last frame its instances passed the late phase; sized with transformBuffer
+    lvk::Holder<lvk::BufferHandle> visibilityHistory;
+
+    lvk::Holder<lvk::ComputePipelineHandle> cullPipeline;
+    bool gpuCulling = false;
+    lvk::TextureHandle hiz;
+    /// Stamped into visibilityHistory; starts at 1 so the zeroed buffer reads as "visible last frame"
+    uint32_t cullFrame = 0;
+
+    /// All instances of one mesh this frame
+    struct Batch {
+        GeometryRange range;
+        uint32_t instanceCount = 0;
+        uint32_t firstInstance = 0;
+        /// Index of the batch's command within one phase: 16-bit batches first, then 32-bit ones
+        uint32_t drawIndex = 0;
+    };
+
+    /// Instances in submission order, tagged with their batch; Upload() groups them per batch
+    struct PendingInstance {
+        uint32_t batch;
+        InstanceData data;
+        glm::vec4 sphere;
+    };
+
+    std::vector<Batch> batches;
+    /// GeometryAllocation id and level of detail -> index into batches
+    std::unordered_map<uint64_t, uint32_t> batchLookup;
+    std::vector<PendingInstance> pending;
+    std::vector<InstanceData> instances;
+    std::vector<InstanceBounds> bounds;
+    /// Indexed by index width (16-bit, 32-bit): each group is drawn with its own index buffer
+    std::vector<DrawIndexedIndirectCommand> commands[2];
+    IndirectRendererStats stats;
+};
@@ -0,0 +1,93 @@
+#include <renderer/PipelineCache.h>
+#include <core/Hash.h>
+#include <lvk/vulkan/VulkanClasses.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+/// Header fields identifying the device and driver the context runs on
+PipelineCacheHeader GetDeviceHeader(lvk::IContext* ctx_) {
+    const VkPhysicalDeviceProperties& properties = static_cast<lvk::VulkanContext*>(ctx_)->getVkPhysicalDeviceProperties();
+    PipelineCacheHeader header;
+    header.vendorId = properties.vendorID;
+    header.deviceId = properties.deviceID;
+    header.driverVersion = properties.driverVersion;
+    std::memcpy(header.pipelineCacheUuid, properties.pipelineCacheUUID, sizeof(header.pipelineCacheUuid));
+    return header;
+}
+}
+
+PipelineCacheData LoadPipelineCache(const std::filesystem::path& path_) {
+    PipelineCacheData cache;
+    std::ifstream in(path_, std::ios::binary);
+    if (!in.is_open()) return cache;
+
+    in.read(reinterpret_cast<char*>(&cache.header), sizeof(cache.header));
+    if (!in || cache.header.magic != PipelineCacheHeader::kMagic || cache.header.version != PipelineCacheHeader::kVersion) {
+        std::cerr << "Ignoring pipeline cache with an unknown header: " << path_.string() << std::endl;
+        return {};
+    }
+    // The size comes from the file too: check it against what follows the header before allocating
+    std::error_code ec;
+    const uintmax_t fileSize = std::filesystem::file_size(path_, ec);
+    if (ec || fileSize < sizeof(cache.header) || cache.header.dataSize != fileSize - sizeof(cache.header)) {
+        std::cerr << "Ignoring damaged pipeline cache: " << path_.string() << std::endl;
+        return {};
+    }
+    cache.data.resize(cache.header.dataSize);
+    in.read(reinterpret_cast<char*>(cache.data.data()), static_cast<std::streamsize>(cache.data.size()));
+    if (!in || HashBytes(cache.data.data(), cache.data.size()) != cache.header.dataHash) {
+        std::cerr << "Ignoring damaged pipeline cache: " << path_.string() << std::endl;
+        return {};
+    }
+    return cache;
+}
+
+bool IsPipelineCacheCompatible(lvk::IContext* ctx_, const PipelineCacheData& cache_) {
+    if (cache_.IsEmpty()) return false;
+    const PipelineCacheHeader device = GetDeviceHeader(ctx_);
+    return cache_.header.vendorId == device.vendorId && cache_.header.deviceId == device.deviceId &&
+           cache_.header.driverVersion == device.driverVersion &&
+           std::memcmp(cache_.header.pipelineCacheUuid, device.pipelineCacheUuid, sizeof(device.pipelineCacheUuid)) == 0;
+}
+
+bool SavePipelineCache(lvk::IContext* ctx_, const std::filesystem::path& path_) {
+    const std::vector<uint8_t> data = static_cast<lvk::VulkanContext*>(ctx_)->getPipelineCacheData();
+    if (data.empty()) return false;
+
+    std::error_code ec;
+    std::filesystem::create_directories(path_.parent_path(), ec);
+    if (ec) {
+        std::cerr << "Failed to create pipeline cache directory: " << path_.parent_path().string() << std::endl;
+        return false;
+    }
+
+    PipelineCacheHeader header = GetDeviceHeader(ctx_);
+    header.dataSize = data.size();
+    header.dataHash = HashBytes(data.data(), data.size());
+
+    // Written next to the old file and renamed, so a crash mid-write never leaves a torn cache
+    std::filesystem::path tempPath = path_;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Failed to open pipeline cache for writing: " << tempPath.string() << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!out) {
+            std::cerr << "Failed to write pipeline cache: " << tempPath.string() << std::endl;
+            return false;
+        }
+    }
+    std::filesystem::rename(tempPath, path_, ec);
+    if (ec) {
+        std::cerr << "Failed to finalize pipeline cache: " << path_.string() << std::endl;
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <lvk/LVK.h>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/// Vulkan pipeline cache persisted between runs, so pipelines compiled once are not compiled again.
+///
+/// Layout: PipelineCacheHeader, then the VkPipelineCache blob. The header names the device and
+/// driver that produced the blob (vendor/device ID, driver version, pipelineCacheUUID) and
+/// carries its hash, so a truncated file is rejected and a driver update is reported as a cold start.
+struct PipelineCacheHeader {
+    static constexpr uint32_t kMagic = 0x43504b56; // "VKPC"
+    static constexpr uint32_t kVersion = 1;
+
+    uint32_t magic = kMagic;
+    uint32_t version = kVersion;
+    uint32_t vendorId = 0;
+    uint32_t deviceId = 0;
+    uint32_t driverVersion = 0;
+    uint8_t pipelineCacheUuid[16] = {};
+    uint32_t _padding = 0;
+    uint64_t dataSize = 0;
+    uint64_t dataHash = 0;
+};
+
+/// Pipeline cache blob read from disk, handed to lvk::ContextConfig before the context exists
+struct PipelineCacheData {
+    PipelineCacheHeader header;
+    std::vector<uint8_t> data;
+
+    [[nodiscard]] bool IsEmpty() const { return data.empty(); }
+};
+
+inline constexpr const char* kPipelineCachePath = "cache/pipelines.bin";
+
+/// Reads path_; returns empty data when the file is missing or damaged
+PipelineCacheData LoadPipelineCache(const std::filesystem::path& path_);
+/// True when cache_ was saved on the device and driver ctx_ runs on. The driver ignores foreign
+/// data on its own; this only tells whether the loaded pipelines will actually be reused.
+bool IsPipelineCacheCompatible(lvk::IContext* ctx_, const PipelineCacheData& cache_);
+/// Writes the context's current pipeline cache to path_; call before the context is destroyed
+bool SavePipelineCache(lvk::IContext* ctx_, const std::filesystem::path& path_);
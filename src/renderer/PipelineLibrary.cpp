@@ -0,0 +1,224 @@
+#include <renderer/PipelineLibrary.h>
+#include <core/Profiler.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+PipelineLibrary::PipelineLibrary(lvk::IContext* ctx_) : ctx(ctx_) {
+}
+
+PipelineId PipelineLibrary::AddRenderPipeline(const RenderPipelineRecipe& recipe_) {
+    pipelines.push_back({ recipe_ });
+    stats.registeredPipelines++;
+    return static_cast<PipelineId>(pipelines.size() - 1);
+}
+
+lvk::RenderPipelineHandle PipelineLibrary::GetRenderPipeline(PipelineId id_) {
+    Pipeline& pipeline = pipelines[id_];
+    if (!pipeline.handle.valid() && !pipeline.failed) {
+        const auto start = std::chrono::steady_clock::now();
+        CreatePipeline(pipeline);
+        stats.onDemandCreations++;
+        stats.lastOnDemandMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    return pipeline.handle;
+}
+
+lvk::ShaderModuleHandle PipelineLibrary::GetShaderModule(const std::string& path_) {
+    if (auto it = shaderModules.find(path_); it != shaderModules.end()) {
+        return it->second.handle;
+    }
+
+    lvk::ShaderStage stage;
+    if (!GetShaderStage(path_, stage)) {
+        std::cerr << "Unknown shader stage for " << path_ << std::endl;
+        return {};
+    }
+
+    // Prefer what the worker loaded. One it is loading right now is waited for, so the same
+    // shader is never compiled (and written to the cache) twice; one still queued is claimed
+    // and loaded here instead.
+    ShaderBinary binary;
+    {
+        std::unique_lock lock(binariesMutex);
+        if (auto it = pendingBinaries.find(path_); it != pendingBinaries.end()) {
+            if (it->second) {
+                binariesLoaded.wait(lock, [&] { return !pendingBinaries.contains(path_); });
+            } else {
+                pendingBinaries.erase(it);
+            }
+        }
+        if (auto it = loadedBinaries.find(path_); it != loadedBinaries.end()) {
+            binary = std::move(it->second);
+            loadedBinaries.erase(it);
+        }
+    }
+    if (binary.IsEmpty()) {
+        binary = LoadShaderBinary(ctx, path_, stage);
+    }
+    if (binary.IsEmpty()) {
+        return {};
+    }
+
+    lvk::Holder<lvk::ShaderModuleHandle> module =
+        ctx->createShaderModule({ binary.spirv.data(), binary.spirv.size(), stage, path_.c_str() }, nullptr);
+    const lvk::ShaderModuleHandle handle = module;
+    if (!handle.valid()) {
+        std::cerr << "Failed to create shader module: " << path_ << std::endl;
+        return {};
+    }
+    shaderModules.emplace(path_, ShaderModule{ std::move(module), binary.reflection });
+    {
+        // Nothing reads a binary once its module exists
+        std::lock_guard lock(binariesMutex);
+        loadedBinaries.erase(path_);
+    }
+    stats.shaderModules++;
+    switch (binary.origin) {
+    case ShaderOrigin::Prebuilt: stats.prebuiltShaders++; break;
+    case ShaderOrigin::Cache: stats.cachedShaders++; break;
+    case ShaderOrigin::Compiled: stats.compiledShaders++; break;
+    }
+    return handle;
+}
+
+void PipelineLibrary::CreatePipeline(Pipeline& pipeline_) {
+    VKENGINE_PROFILE_ZONE("Create pipeline");
+    const RenderPipelineRecipe& recipe = pipeline_.recipe;
+    const lvk::ShaderModuleHandle vert = GetShaderModule(recipe.vertexShader);
+    const lvk::ShaderModuleHandle frag = GetShaderModule(recipe.fragmentShader);
+    if (!vert.valid() || !frag.valid()) {
+        // Not retried every frame; the draw using it is skipped
+        pipeline_.failed = true;
+        return;
+    }
+
+    // The shader would read past what the draws push
+    for (const char* path : { recipe.vertexShader, recipe.fragmentShader }) {
+        const uint32_t shaderSize = shaderModules.at(path).reflection.pushConstantsSize;
+        if (recipe.pushConstantsSize != 0 && shaderSize > recipe.pushConstantsSize) {
+            std::cerr << recipe.debugName << ": " << path << " declares " << shaderSize << " bytes of push constants, "
+                      << recipe.pushConstantsSize << " are pushed" << std::endl;
+        }
+    }
+
+    pipeline_.handle = ctx->createRenderPipeline({
+        .vertexInput = recipe.vertexInput,
+        .smVert      = vert,
+        .smFrag      = frag,
+        .specInfo    = recipe.specInfo,
+        .color       = { { .format = recipe.colorFormat } },
+        .depthFormat = recipe.depthFormat,
+        .cullMode    = recipe.cullMode,
+        .debugName   = recipe.debugName,
+    });
+    pipeline_.failed = !pipeline_.handle.valid();
+    if (!pipeline_.failed) {
+        stats.createdPipelines++;
+    }
+}
+
+void PipelineLibrary::StartPrewarm() {
+    std::vector<std::string> paths;
+    for (const Pipeline& pipeline : pipelines) {
+        if (pipeline.handle.valid() || pipeline.failed) continue;
+        for (const char* path : { pipeline.recipe.vertexShader, pipeline.recipe.fragmentShader }) {
+            if (!shaderModules.contains(path) && std::find(paths.begin(), paths.end(), path) == paths.end()) {
+                paths.emplace_back(path);
+            }
+        }
+    }
+    for (std::string& path : paths) {
+        lvk::ShaderStage stage;
+        if (!GetShaderStage(path, stage)) continue;
+        {
+            std::lock_guard lock(binariesMutex);
+            if (!pendingBinaries.emplace(path, false).second) continue;
+        }
+        worker.Enqueue([this, path = std::move(path), stage] {
+            {
+                std::lock_guard lock(binariesMutex);
+                auto it = pendingBinaries.find(path);
+                if (it == pendingBinaries.end()) return; // claimed by GetShaderModule() meanwhile
+                it->second = true;
+            }
+            ShaderBinary binary = LoadShaderBinary(ctx, path, stage);
+            {
+                std::lock_guard lock(binariesMutex);
+                pendingBinaries.erase(path);
+                if (!binary.IsEmpty()) loadedBinaries.insert_or_assign(path, std::move(binary));
+            }
+            binariesLoaded.notify_all();
+        });
+    }
+}
+
+bool PipelineLibrary::IsBinaryLoaded(const std::string& path_) {
+    if (shaderModules.contains(path_)) return true;
+    std::lock_guard lock(binariesMutex);
+    return loadedBinaries.contains(path_);
+}
+
+void PipelineLibrary::Prewarm(uint32_t maxPipelines_) {
+    lvk::ICommandBuffer* cmd = nullptr;
+    for (Pipeline& pipeline : pipelines) {
+        if (maxPipelines_ == 0) break;
+        if (pipeline.handle.valid() || pipeline.failed) continue;
+        // Never block the frame on the disk or the compiler; the worker gets to it soon
+        if (!IsBinaryLoaded(pipeline.recipe.vertexShader) || !IsBinaryLoaded(pipeline.recipe.fragmentShader)) continue;
+        const auto start = std::chrono::steady_clock::now();
+        CreatePipeline(pipeline);
+        maxPipelines_--;
+        if (pipeline.failed) continue;
+        if (!cmd) cmd = &ctx->acquireCommandBuffer();
+        CompilePipeline(*cmd, pipeline);
+        stats.prewarmedPipelines++;
+        stats.lastPrewarmMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    if (cmd) {
+        ctx->submit(*cmd);
+    }
+}
+
+void PipelineLibrary::CompilePipeline(lvk::ICommandBuffer& cmd_, const Pipeline& pipeline_) {
+    VKENGINE_PROFILE_ZONE("Compile pipeline");
+    const WarmupTarget& target = GetWarmupTarget(pipeline_.recipe.colorFormat, pipeline_.recipe.depthFormat);
+    lvk::RenderPass renderPass = {};
+    lvk::Framebuffer framebuffer = { .debugName = "Framebuffer: pipeline warm-up" };
+    if (target.color.valid()) {
+        renderPass.color[0] = { .loadOp = lvk::LoadOp_DontCare, .storeOp = lvk::StoreOp_DontCare };
+        framebuffer.color[0].texture = target.color;
+    }
+    if (target.depth.valid()) {
+        renderPass.depth = { .loadOp = lvk::LoadOp_DontCare, .storeOp = lvk::StoreOp_DontCare };
+        framebuffer.depthStencil.texture = target.depth;
+    }
+    cmd_.cmdBeginRendering(renderPass, framebuffer);
+    cmd_.cmdBindRenderPipeline(pipeline_.handle);
+    cmd_.cmdEndRendering();
+}
+
+const PipelineLibrary::WarmupTarget& PipelineLibrary::GetWarmupTarget(lvk::Format colorFormat_, lvk::Format depthFormat_) {
+    const uint64_t key = static_cast<uint64_t>(colorFormat_) << 32 | static_cast<uint64_t>(depthFormat_);
+    if (auto it = warmupTargets.find(key); it != warmupTargets.end()) {
+        return it->second;
+    }
+    WarmupTarget& target = warmupTargets[key];
+    if (colorFormat_ != lvk::Format_Invalid) {
+        target.color = ctx->createTexture({
+            .format     = colorFormat_,
+            .dimensions = { 1, 1, 1 },
+            .usage      = lvk::TextureUsageBits_Attachment,
+            .debugName  = "Pipeline warm-up color",
+        });
+    }
+    if (depthFormat_ != lvk::Format_Invalid) {
+        target.depth = ctx->createTexture({
+            .format     = depthFormat_,
+            .dimensions = { 1, 1, 1 },
+            .usage      = lvk::TextureUsageBits_Attachment,
+            .debugName  = "Pipeline warm-up depth",
+        });
+    }
+    return target;
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <core/ThreadPool.h>
+#include <renderer/ShaderCache.h>
+#include <lvk/LVK.h>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using PipelineId = uint32_t;
+
+/// Everything needed to build a render pipeline when it is first used. Strings and specInfo.data
+/// are not copied and must outlive the library (string literals, locals of main()).
+struct RenderPipelineRecipe {
+    const char* vertexShader = "";
+    const char* fragmentShader = "";
+    lvk::VertexInput vertexInput = {};
+    lvk::SpecializationConstantDesc specInfo = {};
+    lvk::Format colorFormat = lvk::Format_Invalid;
+    lvk::Format depthFormat = lvk::Format_Invalid;
+    lvk::CullMode cullMode = lvk::CullMode_None;
+    const char* debugName = "";
+    /// Bytes the draws push; a shader declaring a larger block is reported when the pipeline is built
+    uint32_t pushConstantsSize = 0;
+};
+
+struct PipelineLibraryStats {
+    uint32_t registeredPipelines = 0;
+    uint32_t createdPipelines = 0;
+    uint32_t shaderModules = 0;
+    /// Where the shader modules' SPIR-V came from (see ShaderOrigin)
+    uint32_t prebuiltShaders = 0;
+    uint32_t cachedShaders = 0;
+    uint32_t compiledShaders = 0;
+    /// Pipelines created by GetRenderPipeline() because pre-warming had not reached them yet
+    uint32_t onDemandCreations = 0;
+    /// Shader modules and pipeline object of the most recent on-demand creation. lvk compiles the
+    /// VkPipeline at the bind that follows, so the frame's hitch is this plus that compile.
+    double lastOnDemandMs = 0.0;
+    /// Pipelines built and compiled by Prewarm()
+    uint32_t prewarmedPipelines = 0;
+    /// Build and compile time of the most recently pre-warmed pipeline, the hitch it saved a frame
+    double lastPrewarmMs = 0.0;
+};
+
+/// Render pipelines and shader modules created lazily instead of all at start-up.
+///
+/// Pipelines are registered as recipes and built the first time GetRenderPipeline() asks for
+/// them, so start-up only pays for what the first frame draws. StartPrewarm() loads the SPIR-V of
+/// every registered shader on a worker thread (see ShaderCache.h); Prewarm() then builds a few of
+/// the remaining pipelines per frame from it, so switching effects later rarely hitches.
+/// lvk compiles the VkPipeline itself on first bind, through the context's pipeline cache
+/// (see PipelineCache.h), so Prewarm() binds every pipeline it builds once in a throwaway
+/// offscreen pass with the recipe's attachment formats.
+///
+/// Everything except loading SPIR-V happens on the render thread.
+class PipelineLibrary {
+public:
+    explicit PipelineLibrary(lvk::IContext* ctx_);
+
+    PipelineLibrary(const PipelineLibrary&) = delete;
+    PipelineLibrary& operator=(const PipelineLibrary&) = delete;
+
+    PipelineId AddRenderPipeline(const RenderPipelineRecipe& recipe_);
+    /// Builds the pipeline and its shader modules on first use; invalid if a shader failed to load
+    lvk::RenderPipelineHandle GetRenderPipeline(PipelineId id_);
+    /// Creates the module for the shader at path_ once; the stage comes from the extension
+    lvk::ShaderModuleHandle GetShaderModule(const std::string& path_);
+
+    /// Starts loading the SPIR-V of every registered pipeline that has not been built
+    void StartPrewarm();
+    /// Builds and compiles at most maxPipelines_ unbuilt pipelines whose SPIR-V the worker has
+    /// loaded. Submits its own command buffer, so it must not be called while one is recorded.
+    void Prewarm(uint32_t maxPipelines_ = 1);
+
+    [[nodiscard]] const PipelineLibraryStats& GetStats() const { return stats; }
+
+private:
+    struct Pipeline {
+        RenderPipelineRecipe recipe;
+        lvk::Holder<lvk::RenderPipelineHandle> handle;
+        bool failed = false;
+    };
+
+    /// 1x1 attachments the warm-up passes render to
+    struct WarmupTarget {
+        lvk::Holder<lvk::TextureHandle> color;
+        lvk::Holder<lvk::TextureHandle> depth;
+    };
+
+    void CreatePipeline(Pipeline& pipeline_);
+    /// Binds the pipeline in an empty pass, which is when lvk compiles it
+    void CompilePipeline(lvk::ICommandBuffer& cmd_, const Pipeline& pipeline_);
+    const WarmupTarget& GetWarmupTarget(lvk::Format colorFormat_, lvk::Format depthFormat_);
+    [[nodiscard]] bool IsBinaryLoaded(const std::string& path_);
+
+    lvk::IContext* ctx;
+    std::vector<Pipeline> pipelines;
+    struct ShaderModule {
+        lvk::Holder<lvk::ShaderModuleHandle> handle;
+        ShaderReflection reflection;
+    };
+    std::unordered_map<std::string, ShaderModule> shaderModules;
+    PipelineLibraryStats stats;
+    /// Keyed by color format << 32 | depth format
+    std::unordered_map<uint64_t, WarmupTarget> warmupTargets;
+
+    /// SPIR-V loaded by the worker, consumed by GetShaderModule()
+    std::mutex binariesMutex;
+    std::condition_variable binariesLoaded;
+    std::unordered_map<std::string, ShaderBinary> loadedBinaries;
+    /// Paths queued on the worker; true once it has started loading them
+    std::unordered_map<std::string, bool> pendingBinaries;
+    /// Declared last so it is joined before the binaries it writes are destroyed
+    ThreadPool worker{1};
+};
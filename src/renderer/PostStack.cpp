@@ -0,0 +1,69 @@
+#include <renderer/PostStack.h>
+
+namespace {
+/// 4 bits per stage above the stage count
+uint64_t GetPermutationKey(std::span<const PostEffectType> stages_) {
+    uint64_t key = stages_.size();
+    for (size_t i = 0; i < stages_.size(); ++i) {
+        key |= static_cast<uint64_t>(stages_[i]) << (4 * (i + 1));
+    }
+    return key;
+}
+}
+
+bool ReadsNeighborhood(PostEffectType effect_) {
+    // Must match readsNeighborhood() in post_uber.frag
+    return effect_ == PostEffectType::Bloom || effect_ == PostEffectType::Dream || effect_ == PostEffectType::Glitch ||
+           effect_ == PostEffectType::Underwater;
+}
+
+PostStack::PostStack(PipelineLibrary& pipelines_, lvk::Format colorFormat_, uint32_t pushConstantsSize_)
+    : pipelines(pipelines_), colorFormat(colorFormat_), pushConstantsSize(pushConstantsSize_) {
+    static_assert(static_cast<uint32_t>(PostEffectType::Count) <= 16, "Permutation keys hold 4 bits per stage");
+    for (uint32_t effect = 0; effect < static_cast<uint32_t>(PostEffectType::Count); ++effect) {
+        const PostEffectType stage = static_cast<PostEffectType>(effect);
+        GetPipeline({ &stage, 1 });
+    }
+}
+
+std::vector<PostStack::Pass> PostStack::Split(std::span<const PostEffectType> chain_, bool fuse_) {
+    std::vector<Pass> passes;
+    for (const PostEffectType effect : chain_) {
+        if (passes.empty() || !fuse_ || ReadsNeighborhood(effect) || passes.back().stages.size() == kMaxStages) {
+            passes.emplace_back();
+        }
+        passes.back().stages.push_back(effect);
+    }
+    if (passes.empty()) {
+        passes.push_back({ { PostEffectType::ToneMap } });
+    }
+    return passes;
+}
+
+PipelineId PostStack::GetPipeline(std::span<const PostEffectType> stages_) {
+    const uint64_t key = GetPermutationKey(stages_);
+    if (auto it = permutations.find(key); it != permutations.end()) {
+        return it->second;
+    }
+
+    SpecializationData& data = specializationData.emplace_back();
+    data[0] = static_cast<uint32_t>(stages_.size());
+    for (size_t i = 0; i < stages_.size(); ++i) {
+        data[i + 1] = static_cast<uint32_t>(stages_[i]);
+    }
+    lvk::SpecializationConstantDesc specInfo = { .data = data.data(), .dataSize = sizeof(data) };
+    for (uint32_t i = 0; i < data.size(); ++i) {
+        specInfo.entries[i] = { .constantId = i, .offset = i * static_cast<uint32_t>(sizeof(uint32_t)), .size = sizeof(uint32_t) };
+    }
+
+    const PipelineId pipeline = pipelines.AddRenderPipeline({
+        .vertexShader      = "shaders/post.vert",
+        .fragmentShader    = "shaders/post_uber.frag",
+        .specInfo          = specInfo,
+        .colorFormat       = colorFormat,
+        .debugName         = "Post: uber shader",
+        .pushConstantsSize = pushConstantsSize,
+    });
+    permutations.emplace(key, pipeline);
+    return pipeline;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <renderer/PipelineLibrary.h>
+#include <lvk/LVK.h>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+/// Effects of the über post-processing shader; the values are its EFFECT_* constants
+enum class PostEffectType : uint32_t {
+    ToneMap = 0, // copies the input, used when no effect is selected
+    CRT,
+    Bloom,
+    Dream,
+    Glitch,
+    Pixelation,
+    Fog,
+    Underwater,
+    Dithering,
+    Posterization,
+    Count,
+};
+
+/// True for effects that read their input at more than one position (or, for bloom, need it as a
+/// texture to build the bloom chain from). They can only run first in a fused pass.
+bool ReadsNeighborhood(PostEffectType effect_);
+
+/// Post-processing chain fused into as few fullscreen passes as possible.
+///
+/// shaders/post_uber.frag holds every effect; a pass runs a stack of up to kMaxStages of them,
+/// selected by specialization constants, and reads the previous pass's result once. A new pass
+/// starts at every effect that ReadsNeighborhood(), since it needs the real output of the effects
+/// before it. Pipelines are created per stack on first use; single effects are registered up
+/// front so pre-warming covers them.
+class PostStack {
+public:
+    static constexpr uint32_t kMaxStages = 8;
+
+    /// A run of effects executed as one fullscreen pass
+    struct Pass {
+        std::vector<PostEffectType> stages;
+        /// Builds the bloom chain from the pass input first (stages[0] is Bloom)
+        [[nodiscard]] bool UsesBloom() const { return stages.front() == PostEffectType::Bloom; }
+    };
+
+    PostStack(PipelineLibrary& pipelines_, lvk::Format colorFormat_, uint32_t pushConstantsSize_);
+
+    PostStack(const PostStack&) = delete;
+    PostStack& operator=(const PostStack&) = delete;
+
+    /// Splits chain_ into passes; fuse_ false gives one pass per effect. An empty chain becomes a
+    /// single tone-map pass.
+    static std::vector<Pass> Split(std::span<const PostEffectType> chain_, bool fuse_);
+
+    /// The pipeline running stages_ in one pass, created on first use
+    PipelineId GetPipeline(std::span<const PostEffectType> stages_);
+
+    [[nodiscard]] uint32_t GetPermutationCount() const { return static_cast<uint32_t>(permutations.size()); }
+
+private:
+    /// kStageCount followed by kStage0..7, constant IDs 0..8 in post_uber.frag
+    using SpecializationData = std::array<uint32_t, kMaxStages + 1>;
+
+    PipelineLibrary& pipelines;
+    lvk::Format colorFormat;
+    uint32_t pushConstantsSize;
+    std::unordered_map<uint64_t, PipelineId> permutations;
+    /// Recipes point into it, so it must not move its elements
+    std::deque<SpecializationData> specializationData;
+};
@@ -0,0 +1,240 @@
+#include <renderer/RenderGraph.h>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+/// Calls func_(RenderGraphTexture) for every valid texture the pass touches
+template<typename F>
+void ForEachTexture(const RenderGraphPassDesc& desc_, F&& func_) {
+    for (const RenderGraphTexture texture : desc_.reads) func_(texture);
+    for (const RenderGraphTexture texture : desc_.writes) func_(texture);
+    if (desc_.color.texture.IsValid()) func_(desc_.color.texture);
+    if (desc_.depth.texture.IsValid()) func_(desc_.depth.texture);
+}
+
+bool IsGraphicsPass(const RenderGraphPassDesc& desc_) {
+    return desc_.color.texture.IsValid() || desc_.depth.texture.IsValid();
+}
+}
+
+RenderGraph::RenderGraph(lvk::IContext* ctx_) : ctx(ctx_) {
+}
+
+void RenderGraph::Reset(const lvk::Dimensions& size_) {
+    size = size_;
+    frame++;
+    resources.clear();
+    passes.clear();
+    stats = {};
+
+    // Textures of an old size or of effects no longer in use go once the GPU is surely done with them
+    std::erase_if(pool, [&](const PooledTexture& pooled) { return frame - pooled.lastUsedFrame > kPoolRetireFrames; });
+}
+
+lvk::Dimensions RenderGraph::GetScaledSize(const lvk::Dimensions& size_, float scale_) {
+    return {
+        std::max(static_cast<uint32_t>(static_cast<float>(size_.width) * scale_), 1u),
+        std::max(static_cast<uint32_t>(static_cast<float>(size_.height) * scale_), 1u),
+        1,
+    };
+}
+
+RenderGraphTexture RenderGraph::CreateTexture(const TransientTextureDesc& desc_) {
+    Resource& resource = resources.emplace_back();
+    resource.desc = desc_;
+    resource.dimensions = GetScaledSize(size, desc_.scale);
+    stats.transientTextures++;
+    return { static_cast<uint32_t>(resources.size() - 1) };
+}
+
+RenderGraphTexture RenderGraph::ImportTexture(lvk::TextureHandle texture_, const char* debugName_) {
+    Resource& resource = resources.emplace_back();
+    resource.desc.debugName = debugName_;
+    resource.texture = texture_;
+    resource.imported = true;
+    if (texture_.valid()) {
+        resource.dimensions = ctx->getDimensions(texture_);
+    }
+    return { static_cast<uint32_t>(resources.size() - 1) };
+}
+
+void RenderGraph::MarkOutput(RenderGraphTexture texture_) {
+    if (texture_.IsValid()) {
+        resources[texture_.index].output = true;
+    }
+}
+
+void RenderGraph::AddPass(const RenderGraphPassDesc& desc_, RenderGraphExecute execute_) {
+    passes.push_back({ desc_, std::move(execute_) });
+}
+
+void RenderGraph::Compile() {
+    CullPasses();
+    AllocateTransients();
+
+    stats.passes = static_cast<uint32_t>(passes.size());
+    stats.pooledTextures = static_cast<uint32_t>(pool.size());
+    stats.allocatedTextures = static_cast<uint32_t>(std::count_if(pool.begin(), pool.end(), [&](const PooledTexture& pooled) {
+        return pooled.lastUsedFrame == frame;
+    }));
+}
+
+void RenderGraph::CullPasses() {
+    // Walking backwards, needed[] says whether the texture's current contents are read later
+    std::vector<uint8_t> needed(resources.size());
+    for (size_t i = 0; i < resources.size(); ++i) {
+        needed[i] = resources[i].output ? 1 : 0;
+    }
+
+    auto writesNeeded = [&](const RenderGraphPassDesc& desc_) {
+        for (const RenderGraphTexture texture : desc_.writes) {
+            if (needed[texture.index]) return true;
+        }
+        return (desc_.color.texture.IsValid() && needed[desc_.color.texture.index]) ||
+               (desc_.depth.texture.IsValid() && needed[desc_.depth.texture.index]);
+    };
+
+    for (size_t i = passes.size(); i-- > 0;) {
+        Pass& pass = passes[i];
+        const RenderGraphPassDesc& desc = pass.desc;
+        pass.culled = !desc.sideEffects && !writesNeeded(desc);
+        if (pass.culled) {
+            stats.culledPasses++;
+            continue;
+        }
+
+        // A cleared attachment replaces the texture entirely, so whatever was there before is dead;
+        // storage writes may be partial and keep it alive
+        for (const RenderGraphAttachment* attachment : { &desc.color, &desc.depth }) {
+            if (attachment->texture.IsValid()) {
+                needed[attachment->texture.index] = attachment->loadOp == lvk::LoadOp_Load ? 1 : 0;
+            }
+        }
+        for (const RenderGraphTexture texture : desc.reads) {
+            needed[texture.index] = 1;
+        }
+    }
+}
+
+void RenderGraph::AllocateTransients() {
+    for (uint32_t i = 0; i < passes.size(); ++i) {
+        if (passes[i].culled) continue;
+        ForEachTexture(passes[i].desc, [&](RenderGraphTexture texture_) {
+            Resource& resource = resources[texture_.index];
+            resource.firstPass = std::min(resource.firstPass, i);
+            resource.lastPass = std::max(resource.lastPass, i);
+        });
+    }
+
+    for (PooledTexture& pooled : pool) {
+        pooled.busy = false;
+    }
+    pooledIndices.assign(resources.size(), UINT32_MAX);
+
+    // Transients take a free pooled texture at their first pass and give it back after their last,
+    // so the next transient of the same shape starting later reuses it
+    for (uint32_t i = 0; i < passes.size(); ++i) {
+        if (passes[i].culled) continue;
+        ForEachTexture(passes[i].desc, [&](RenderGraphTexture texture_) {
+            Resource& resource = resources[texture_.index];
+            if (resource.imported || resource.firstPass != i || pooledIndices[texture_.index] != UINT32_MAX) return;
+            const uint32_t pooledIndex = AcquirePooled(resource);
+            pool[pooledIndex].busy = true;
+            pooledIndices[texture_.index] = pooledIndex;
+            resource.texture = pool[pooledIndex].texture;
+        });
+        ForEachTexture(passes[i].desc, [&](RenderGraphTexture texture_) {
+            const Resource& resource = resources[texture_.index];
+            if (!resource.imported && resource.lastPass == i) {
+                pool[pooledIndices[texture_.index]].busy = false;
+            }
+        });
+    }
+}
+
+uint32_t RenderGraph::AcquirePooled(const Resource& resource_) {
+    const TransientTextureDesc& desc = resource_.desc;
+    for (uint32_t i = 0; i < pool.size(); ++i) {
+        PooledTexture& pooled = pool[i];
+        if (!pooled.busy && pooled.format == desc.format && pooled.usage == desc.usage &&
+            pooled.dimensions.width == resource_.dimensions.width && pooled.dimensions.height == resource_.dimensions.height) {
+            pooled.lastUsedFrame = frame;
+            return i;
+        }
+    }
+
+    PooledTexture& pooled = pool.emplace_back();
+    pooled.texture = ctx->createTexture({
+        .format     = desc.format,
+        .dimensions = resource_.dimensions,
+        .usage      = desc.usage,
+        .debugName  = desc.debugName,
+    });
+    pooled.format = desc.format;
+    pooled.dimensions = resource_.dimensions;
+    pooled.usage = desc.usage;
+    pooled.lastUsedFrame = frame;
+    return static_cast<uint32_t>(pool.size() - 1);
+}
+
+lvk::Dependencies RenderGraph::GetDependencies(const Pass& pass_) const {
+    lvk::Dependencies dependencies = pass_.desc.dependencies;
+    auto add = [&](RenderGraphTexture texture_) {
+        const lvk::TextureHandle handle = GetTexture(texture_);
+        if (!handle.valid()) return;
+        for (lvk::TextureHandle& slot : dependencies.textures) {
+            if (slot == handle) return;
+            if (slot.empty()) {
+                slot = handle;
+                return;
+            }
+        }
+        std::cerr << "Render graph pass '" << pass_.desc.name << "' uses more textures than lvk::Dependencies holds" << std::endl;
+    };
+    for (const RenderGraphTexture texture : pass_.desc.reads) add(texture);
+    for (const RenderGraphTexture texture : pass_.desc.writes) add(texture);
+    return dependencies;
+}
+
+void RenderGraph::Execute(lvk::ICommandBuffer& cmd_, GpuProfiler* profiler_) {
+    for (const Pass& pass : passes) {
+        if (pass.culled) continue;
+        const RenderGraphPassDesc& desc = pass.desc;
+        const lvk::Dependencies dependencies = GetDependencies(pass);
+
+        // Timestamps go outside the render pass, so a zone includes its load and store ops
+        if (profiler_) profiler_->BeginZone(cmd_, desc.name);
+        cmd_.cmdPushDebugGroupLabel(desc.name);
+        if (IsGraphicsPass(desc)) {
+            lvk::RenderPass renderPass = {};
+            lvk::Framebuffer framebuffer = {};
+            if (desc.color.texture.IsValid()) {
+                renderPass.color[0] = { .loadOp = desc.color.loadOp, .storeOp = lvk::StoreOp_Store };
+                std::copy(std::begin(desc.color.clearColor), std::end(desc.color.clearColor), renderPass.color[0].clearColor);
+                framebuffer.color[0].texture = GetTexture(desc.color.texture);
+            }
+            if (desc.depth.texture.IsValid()) {
+                renderPass.depth = { .loadOp = desc.depth.loadOp, .storeOp = lvk::StoreOp_Store, .clearDepth = desc.depth.clearDepth };
+                framebuffer.depthStencil.texture = GetTexture(desc.depth.texture);
+            }
+            framebuffer.debugName = desc.name;
+
+            cmd_.cmdBeginRendering(renderPass, framebuffer, dependencies);
+            pass.execute({ cmd_, framebuffer, dependencies });
+            cmd_.cmdEndRendering();
+        } else {
+            const lvk::Framebuffer noFramebuffer = {};
+            pass.execute({ cmd_, noFramebuffer, dependencies });
+        }
+        cmd_.cmdPopDebugGroupLabel();
+        if (profiler_) profiler_->EndZone(cmd_);
+    }
+}
+
+lvk::TextureHandle RenderGraph::GetTexture(RenderGraphTexture texture_) const {
+    return texture_.IsValid() ? resources[texture_.index].texture : lvk::TextureHandle{};
+}
+
+lvk::Dimensions RenderGraph::GetDimensions(RenderGraphTexture texture_) const {
+    return texture_.IsValid() ? resources[texture_.index].dimensions : lvk::Dimensions{};
+}
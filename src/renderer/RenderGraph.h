@@ -0,0 +1,158 @@
+#pragma once
+#include <renderer/GpuProfiler.h>
+#include <lvk/LVK.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// Texture declared in the current frame of a RenderGraph
+struct RenderGraphTexture {
+    uint32_t index = UINT32_MAX;
+
+    [[nodiscard]] bool IsValid() const { return index != UINT32_MAX; }
+};
+
+/// Texture owned by the graph. It only exists between its first and last use in a frame, so
+/// transients whose uses do not overlap share one pooled lvk texture.
+struct TransientTextureDesc {
+    lvk::Format format = lvk::Format_Invalid;
+    uint8_t usage = lvk::TextureUsageBits_Attachment | lvk::TextureUsageBits_Sampled;
+    /// Fraction of the graph size passed to RenderGraph::Reset()
+    float scale = 1.0f;
+    const char* debugName = "";
+};
+
+struct RenderGraphAttachment {
+    RenderGraphTexture texture;
+    /// LoadOp_Load keeps (and therefore depends on) what earlier passes wrote
+    lvk::LoadOp loadOp = lvk::LoadOp_Clear;
+    float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    float clearDepth = 1.0f;
+};
+
+/// One pass of a frame. A pass with a color or depth attachment is a graphics pass that the graph
+/// wraps in cmdBeginRendering()/cmdEndRendering(); any other pass is recorded outside a render pass
+/// (compute dispatches, Hi-Z builds).
+struct RenderGraphPassDesc {
+    const char* name = "";
+    /// Textures sampled (or loaded) by the pass
+    std::vector<RenderGraphTexture> reads;
+    /// Textures written without being attachments, e.g. storage images of compute passes
+    std::vector<RenderGraphTexture> writes;
+    RenderGraphAttachment color;
+    RenderGraphAttachment depth;
+    /// Extra dependencies (indirect and storage buffers, textures the graph does not track); the
+    /// textures in reads and writes are added to its free texture slots
+    lvk::Dependencies dependencies = {};
+    /// Keeps the pass even when none of its textures are used, for passes that write buffers
+    bool sideEffects = false;
+};
+
+/// What a pass callback gets to record with
+struct RenderGraphPassContext {
+    lvk::ICommandBuffer& cmd;
+    /// Attachments of a graphics pass, empty for other passes
+    const lvk::Framebuffer& framebuffer;
+    /// Everything the pass declared; non-graphics passes hand it to their dispatches
+    const lvk::Dependencies& dependencies;
+};
+
+using RenderGraphExecute = std::function<void(const RenderGraphPassContext&)>;
+
+struct RenderGraphStats {
+    uint32_t passes = 0;
+    /// Declared passes whose results nothing used
+    uint32_t culledPasses = 0;
+    uint32_t transientTextures = 0;
+    /// Pooled textures backing this frame's transients
+    uint32_t allocatedTextures = 0;
+    /// Pooled textures alive, including ones kept for reuse
+    uint32_t pooledTextures = 0;
+};
+
+/// Per-frame graph of passes and the textures they read and write. The frame is declared from
+/// scratch every time: Reset(), CreateTexture()/ImportTexture(), AddPass() in execution order,
+/// MarkOutput() for what must be produced, then Compile() and Execute().
+///
+/// Compile() walks the passes backwards from the outputs and drops every pass whose writes are
+/// never read, then assigns pooled textures to the surviving transients by lifetime, so a chain
+/// of post effects ping-pongs between two targets however long it is. Pooled textures are keyed
+/// by format, size and usage, so a resize simply stops matching the old ones, which are released
+/// after kPoolRetireFrames unused frames. Barriers come from lvk: each pass begins with its
+/// declared inputs as dependencies and its attachments as the framebuffer.
+class RenderGraph {
+public:
+    /// Frames a pooled texture survives without being used
+    static constexpr uint32_t kPoolRetireFrames = 3;
+
+    explicit RenderGraph(lvk::IContext* ctx_);
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    /// Starts declaring a new frame whose transient textures are sized relative to size_
+    void Reset(const lvk::Dimensions& size_);
+    /// Size of a transient texture with the given scale in a graph of size size_
+    static lvk::Dimensions GetScaledSize(const lvk::Dimensions& size_, float scale_);
+
+    RenderGraphTexture CreateTexture(const TransientTextureDesc& desc_);
+    /// Makes an externally owned texture (swapchain image, asset, Hi-Z pyramid) usable by passes
+    RenderGraphTexture ImportTexture(lvk::TextureHandle texture_, const char* debugName_ = "");
+    /// The passes writing texture_ last, and everything they depend on, are never culled
+    void MarkOutput(RenderGraphTexture texture_);
+    void AddPass(const RenderGraphPassDesc& desc_, RenderGraphExecute execute_);
+
+    /// Culls unused passes and assigns pooled textures to the transients
+    void Compile();
+    /// Records every surviving pass in declaration order, each as a GPU zone of profiler_ if given
+    void Execute(lvk::ICommandBuffer& cmd_, GpuProfiler* profiler_ = nullptr);
+
+    /// Valid after Compile() for every texture a surviving pass uses
+    [[nodiscard]] lvk::TextureHandle GetTexture(RenderGraphTexture texture_) const;
+    [[nodiscard]] lvk::Dimensions GetDimensions(RenderGraphTexture texture_) const;
+    [[nodiscard]] const RenderGraphStats& GetStats() const { return stats; }
+
+private:
+    struct Resource {
+        TransientTextureDesc desc;
+        lvk::Dimensions dimensions = {};
+        lvk::TextureHandle texture; // imported, or the pooled texture assigned by Compile()
+        bool imported = false;
+        bool output = false;
+        /// First and last surviving pass using the texture
+        uint32_t firstPass = UINT32_MAX;
+        uint32_t lastPass = 0;
+    };
+
+    struct Pass {
+        RenderGraphPassDesc desc;
+        RenderGraphExecute execute;
+        bool culled = false;
+    };
+
+    struct PooledTexture {
+        lvk::Holder<lvk::TextureHandle> texture;
+        lvk::Format format = lvk::Format_Invalid;
+        lvk::Dimensions dimensions = {};
+        uint8_t usage = 0;
+        uint64_t lastUsedFrame = 0;
+        /// Assigned to a transient that is still alive at the pass being allocated
+        bool busy = false;
+    };
+
+    void CullPasses();
+    void AllocateTransients();
+    /// Index into pool of a free texture matching resource_, created if there is none
+    uint32_t AcquirePooled(const Resource& resource_);
+    [[nodiscard]] lvk::Dependencies GetDependencies(const Pass& pass_) const;
+
+    lvk::IContext* ctx;
+    lvk::Dimensions size = {};
+    uint64_t frame = 0;
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    std::vector<PooledTexture> pool;
+    /// Pool index behind each transient resource this frame
+    std::vector<uint32_t> pooledIndices;
+    RenderGraphStats stats;
+};
@@ -0,0 +1,164 @@
+#include <renderer/SceneCulling.h>
+#include <assets/AssetRegistry.h>
+#include <components/MeshComponent.h>
+#include <components/TransformComponent.h>
+#include <components/TransformHierarchy.h>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+/// Fat-box margin in world units; movement within it costs no tree update
+constexpr float kTreeMargin = 0.1f;
+
+} // namespace
+
+SceneCulling::SceneCulling(World& world_, const TransformHierarchy& transforms_)
+    : world(world_), transforms(transforms_), tree(kTreeMargin) {
+}
+
+bool SceneCulling::HasNodeChanged(uint32_t node_) const {
+    const std::vector<TransformRange>& ranges = transforms.GetChangedRanges();
+    // Ranges are sorted and disjoint: find the last one starting at or before the node
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), node_, [](uint32_t node, const TransformRange& range) { return node < range.first; });
+    return it != ranges.begin() && node_ < std::prev(it)->first + std::prev(it)->count;
+}
+
+void SceneCulling::Update() {
+    frame++;
+    world.ForEach<TransformComponent, MeshComponent>([&](Entity entity, const TransformComponent& transform, const MeshComponent& meshComponent) {
+        const uint32_t node = transform.GetHierarchyNode();
+        if (node == TransformHierarchy::kInvalidNode) return;
+
+        if (entity.index >= records.size()) {
+            records.resize(entity.index + 1);
+        }
+        Record& record = records[entity.index];
+        if (record.proxy != DynamicAabbTree::kNullNode && record.entity != entity) {
+            // The slot was recycled by a new entity since the last update
+            tree.DestroyProxy(record.proxy);
+            record.proxy = DynamicAabbTree::kNullNode;
+        }
+        record.entity = entity;
+        record.lastSeen = frame;
+
+        const std::vector<MeshBuffers>& meshes = meshComponent.GetMeshes();
+        const bool stale = record.proxy == DynamicAabbTree::kNullNode || record.meshes != &meshes ||
+                           record.transformNode != node || HasNodeChanged(node);
+        if (!stale) return;
+        record.meshes = &meshes;
+        record.transformNode = node;
+
+        Aabb localBounds;
+        for (const MeshBuffers& mesh : meshes) {
+            localBounds.Extend(Aabb{ mesh.boundsMin, mesh.boundsMax });
+        }
+        if (localBounds.IsEmpty()) {
+            localBounds = Aabb{ glm::vec3(0.0f), glm::vec3(0.0f) };
+        }
+        const Aabb worldBounds = TransformAabb(localBounds, transforms.GetWorldMatrix(node));
+        if (record.proxy == DynamicAabbTree::kNullNode) {
+            record.proxy = tree.CreateProxy(worldBounds, entity.index);
+        } else {
+            tree.MoveProxy(record.proxy, worldBounds);
+        }
+    });
+
+    // Entities that were destroyed or lost a component this frame
+    for (Record& record : records) {
+        if (record.proxy != DynamicAabbTree::kNullNode && record.lastSeen != frame) {
+            tree.DestroyProxy(record.proxy);
+            record.proxy = DynamicAabbTree::kNullNode;
+            record.meshes = nullptr;
+        }
+    }
+}
+
+void SceneCulling::Cull(const glm::mat4& viewProj_) {
+    visibleMeshes.clear();
+    stats = {};
+
+    const Frustum frustum = Frustum::FromViewProjection(viewProj_);
+    candidateActors.clear();
+    if (enabled) {
+        stats.nodesTested = tree.Query(frustum, [&](uint32_t entityIndex_) {
+            candidateActors.push_back(entityIndex_);
+        });
+    } else {
+        for (uint32_t index = 0; index < records.size(); ++index) {
+            if (records[index].proxy != DynamicAabbTree::kNullNode) candidateActors.push_back(index);
+        }
+    }
+    stats.visibleActors = static_cast<uint32_t>(candidateActors.size());
+    stats.culledActors = tree.GetProxyCount() - stats.visibleActors;
+
+    // Bounding spheres of every submesh of the candidate actors, in world space
+    candidateMeshes.clear();
+    candidateLods.clear();
+    candidateScales.clear();
+    sphereX.clear();
+    sphereY.clear();
+    sphereZ.clear();
+    sphereRadius.clear();
+    for (uint32_t entityIndex : candidateActors) {
+        Record& record = records[entityIndex];
+        const MeshComponent* meshComponent = world.GetComponent<MeshComponent>(record.entity);
+        const std::vector<MeshBuffers>& meshes = *record.meshes;
+        if (record.lods.size() != meshes.size()) {
+            record.lods.assign(meshes.size(), 0);
+        }
+        const glm::mat4& model = transforms.GetWorldMatrix(record.transformNode);
+        const float radiusScale = GetMaxScale(model);
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const MeshBuffers& mesh = meshes[i];
+            const glm::vec3 center = glm::vec3(model * glm::vec4(mesh.sphereCenter, 1.0f));
+            candidateMeshes.push_back({ meshComponent, &mesh, record.transformNode });
+            candidateLods.push_back(&record.lods[i]);
+            candidateScales.push_back(radiusScale);
+            sphereX.push_back(center.x);
+            sphereY.push_back(center.y);
+            sphereZ.push_back(center.z);
+            sphereRadius.push_back(mesh.sphereRadius * radiusScale);
+        }
+    }
+
+    const uint32_t candidateCount = static_cast<uint32_t>(candidateMeshes.size());
+    sphereVisible.resize(candidateCount);
+    if (enabled) {
+        frustum.CullSpheres(sphereX.data(), sphereY.data(), sphereZ.data(), sphereRadius.data(), sphereVisible.data(), candidateCount);
+    } else {
+        std::fill(sphereVisible.begin(), sphereVisible.end(), uint8_t(1));
+    }
+    for (uint32_t i = 0; i < candidateCount; ++i) {
+        if (!sphereVisible[i]) continue;
+        VisibleMesh& draw = visibleMeshes.emplace_back(candidateMeshes[i]);
+        draw.lod = SelectLod(*draw.mesh, glm::vec3(sphereX[i], sphereY[i], sphereZ[i]), sphereRadius[i], candidateScales[i], *candidateLods[i]);
+        stats.lodMeshes[draw.lod]++;
+    }
+    stats.visibleMeshes = static_cast<uint32_t>(visibleMeshes.size());
+    stats.culledMeshes = candidateCount - stats.visibleMeshes;
+}
+
+uint32_t SceneCulling::SelectLod(const MeshBuffers& mesh_, const glm::vec3& center_, float radius_, float scale_, uint8_t& current_) const {
+    // Inside the bounds every level's error is unbounded on screen, so stay at full detail
+    const float distance = glm::length(center_ - lodSettings.cameraPosition) - radius_;
+    if (!lodSettings.enabled || mesh_.lodCount <= 1 || distance <= 0.0f) {
+        current_ = 0;
+        return 0;
+    }
+
+    const float pixelsPerUnit = lodSettings.projectionScale * scale_ / distance;
+    auto pixelError = [&](uint32_t lod_) { return mesh_.lods[lod_].error * pixelsPerUnit; };
+
+    uint32_t lod = 0;
+    while (lod + 1 < mesh_.lodCount && pixelError(lod + 1) <= lodSettings.maxPixelError) {
+        lod++;
+    }
+    // Refining happens at once; coarsening waits until the error is clearly below the limit
+    const uint32_t current = std::min<uint32_t>(current_, mesh_.lodCount - 1);
+    while (lod > current && pixelError(lod) > lodSettings.maxPixelError * (1.0f - lodSettings.hysteresis)) {
+        lod--;
+    }
+    current_ = static_cast<uint8_t>(lod);
+    return lod;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <assets/MeshCache.h>
+#include <core/DynamicAabbTree.h>
+#include <ecs/World.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+struct MeshBuffers;
+class MeshComponent;
+class TransformHierarchy;
+
+/// One submesh that survived culling this frame
+struct VisibleMesh {
+    const MeshComponent* component;
+    const MeshBuffers* mesh;
+    uint32_t transformNode; // TransformHierarchy node of the actor
+    uint32_t lod = 0; // level of detail to draw, see MeshBuffers::GetLodRange()
+};
+
+/// Screen-space-error level-of-detail selection for SceneCulling::Cull(). Each visible submesh
+/// is drawn at the coarsest level whose simplification error, projected at the distance of the
+/// submesh's nearest bounding-sphere point, stays within maxPixelError.
+struct LodSettings {
+    bool enabled = true;
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    /// Pixels covered by one world unit at distance 1: viewport height / (2 * tan(fovy / 2))
+    float projectionScale = 1.0f;
+    float maxPixelError = 1.0f;
+    /// Moving to a coarser level also requires its error to be this fraction below the limit,
+    /// so a submesh sitting at a threshold does not flip between levels every frame
+    float hysteresis = 0.25f;
+};
+
+struct CullingStats {
+    uint32_t visibleActors = 0;
+    uint32_t culledActors = 0;
+    uint32_t visibleMeshes = 0;
+    /// Submeshes of visible actors rejected by their own bounding sphere
+    uint32_t culledMeshes = 0;
+    /// BVH nodes tested against the frustum
+    uint32_t nodesTested = 0;
+    /// Visible submeshes per selected level of detail
+    uint32_t lodMeshes[kMaxMeshLods] = {};
+};
+
+/// CPU frustum culling for every entity with a TransformComponent and a MeshComponent.
+/// Each actor's world AABB (all of its submeshes) sits in a DynamicAabbTree that is only touched
+/// when the actor's world matrix or mesh changes. Cull() walks the tree to find candidate actors,
+/// then tests their submeshes' bounding spheres in SIMD batches and picks each survivor's level
+/// of detail (see LodSettings).
+///
+/// Usage per frame: Update() after TransformHierarchy::Update() and before its changes are
+/// cleared, then Cull() and draw GetVisibleMeshes().
+class SceneCulling {
+public:
+    SceneCulling(World& world_, const TransformHierarchy& transforms_);
+
+    SceneCulling(const SceneCulling&) = delete;
+    SceneCulling& operator=(const SceneCulling&) = delete;
+
+    /// Refits the tree for actors that moved, changed mesh, appeared or disappeared
+    void Update();
+    /// Fills GetVisibleMeshes(); with culling disabled every submesh is reported visible
+    void Cull(const glm::mat4& viewProj_);
+
+    void SetEnabled(bool enabled_) { enabled = enabled_; }
+    [[nodiscard]] bool IsEnabled() const { return enabled; }
+    void SetLodSettings(const LodSettings& settings_) { lodSettings = settings_; }
+    [[nodiscard]] const LodSettings& GetLodSettings() const { return lodSettings; }
+
+    [[nodiscard]] const std::vector<VisibleMesh>& GetVisibleMeshes() const { return visibleMeshes; }
+    [[nodiscard]] const CullingStats& GetStats() const { return stats; }
+    [[nodiscard]] const DynamicAabbTree& GetTree() const { return tree; }
+
+private:
+    /// Indexed by Entity::index
+    struct Record {
+        Entity entity;
+        uint32_t proxy = DynamicAabbTree::kNullNode;
+        uint32_t transformNode = UINT32_MAX;
+        /// Mesh list the bounds were computed from; changes when a model finishes loading
+        const std::vector<MeshBuffers>* meshes = nullptr;
+        /// Level each submesh was drawn at last time, the reference for hysteresis
+        std::vector<uint8_t> lods;
+        uint32_t lastSeen = 0;
+    };
+
+    [[nodiscard]] bool HasNodeChanged(uint32_t node_) const;
+    /// Picks the level for a submesh with world-space bounding sphere center_/radius_ whose model
+    /// matrix scales by at most scale_, and records it in current_
+    uint32_t SelectLod(const MeshBuffers& mesh_, const glm::vec3& center_, float radius_, float scale_, uint8_t& current_) const;
+
+    World& world;
+    const TransformHierarchy& transforms;
+    DynamicAabbTree tree;
+    std::vector<Record> records;
+    uint32_t frame = 0;
+    bool enabled = true;
+    LodSettings lodSettings;
+
+    std::vector<VisibleMesh> visibleMeshes;
+    CullingStats stats;
+
+    /// Scratch for Cull(), kept to avoid reallocating every frame
+    std::vector<uint32_t> candidateActors;
+    std::vector<VisibleMesh> candidateMeshes;
+    std::vector<uint8_t*> candidateLods;
+    std::vector<float> candidateScales;
+    std::vector<float> sphereX, sphereY, sphereZ, sphereRadius;
+    std::vector<uint8_t> sphereVisible;
+};
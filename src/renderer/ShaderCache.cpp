@@ -0,0 +1,287 @@
+#include <renderer/ShaderCache.h>
+#include <core/Hash.h>
+#include <core/Profiler.h>
+#include <lvk/vulkan/VulkanClasses.h>
+#include <lvk/vulkan/VulkanUtils.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+constexpr const char* kShaderCacheDirectory = "cache/shaders";
+/// Bump when the compile options change, so old cache entries are not reused
+constexpr uint64_t kShaderCacheVersion = 1;
+constexpr uint32_t kSpirvMagic = 0x07230203;
+
+std::vector<uint8_t> ReadBinaryFile(const std::filesystem::path& path_) {
+    std::ifstream file(path_, std::ios::binary);
+    if (!file.is_open()) return {};
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+bool IsSpirv(const std::vector<uint8_t>& data_) {
+    uint32_t magic = 0;
+    if (data_.size() < 20 || data_.size() % 4 != 0) return false;
+    std::memcpy(&magic, data_.data(), sizeof(magic));
+    return magic == kSpirvMagic;
+}
+
+/// The build's SPIR-V, unless the source is newer (edited while the engine was not rebuilt)
+bool LoadPrebuilt(const std::filesystem::path& sourcePath_, std::vector<uint8_t>& outSpirv_) {
+    if (kPrebuiltShaderDirectory[0] == '\0') return false;
+    std::filesystem::path spirvPath = std::filesystem::path(kPrebuiltShaderDirectory) / sourcePath_.filename();
+    spirvPath += ".spv";
+
+    std::error_code ec;
+    const auto spirvTime = std::filesystem::last_write_time(spirvPath, ec);
+    if (ec) return false;
+    const auto sourceTime = std::filesystem::last_write_time(sourcePath_, ec);
+    if (!ec && sourceTime > spirvTime) return false;
+
+    outSpirv_ = ReadBinaryFile(spirvPath);
+    return IsSpirv(outSpirv_);
+}
+
+std::filesystem::path GetCachePath(const std::filesystem::path& sourcePath_, uint64_t sourceHash_) {
+    char key[32];
+    std::snprintf(key, sizeof(key), "-%016llx.spv", static_cast<unsigned long long>(sourceHash_));
+    return std::filesystem::path(kShaderCacheDirectory) / (sourcePath_.filename().string() + key);
+}
+
+/// Written next to the final name and renamed, like the mesh cache; older versions of the same shader are removed
+void WriteCache(const std::filesystem::path& cachePath_, const std::filesystem::path& sourcePath_, const std::vector<uint8_t>& spirv_) {
+    std::error_code ec;
+    std::filesystem::create_directories(cachePath_.parent_path(), ec);
+    if (ec) {
+        std::cerr << "Failed to create shader cache directory: " << cachePath_.parent_path().string() << std::endl;
+        return;
+    }
+
+    const std::string prefix = sourcePath_.filename().string() + "-";
+    for (const auto& entry : std::filesystem::directory_iterator(cachePath_.parent_path(), ec)) {
+        const std::string name = entry.path().filename().string();
+        // The entry being written may already exist, renamed into place by another thread
+        if (name.starts_with(prefix) && name.ends_with(".spv") && name.size() == prefix.size() + 20 &&
+            entry.path().filename() != cachePath_.filename()) {
+            std::filesystem::remove(entry.path(), ec);
+        }
+    }
+
+    std::filesystem::path tempPath = cachePath_;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(spirv_.data()), static_cast<std::streamsize>(spirv_.size()));
+        if (!out.good()) {
+            std::cerr << "Failed to write shader cache: " << tempPath.string() << std::endl;
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, cachePath_, ec);
+    if (ec) {
+        std::cerr << "Failed to finalize shader cache: " << cachePath_.string() << std::endl;
+        std::filesystem::remove(tempPath, ec);
+    }
+}
+
+glslang_stage_t GetGlslangStage(lvk::ShaderStage stage_) {
+    switch (stage_) {
+    case lvk::Stage_Vert: return GLSLANG_STAGE_VERTEX;
+    case lvk::Stage_Frag: return GLSLANG_STAGE_FRAGMENT;
+    default: return GLSLANG_STAGE_COMPUTE;
+    }
+}
+
+/// Type sizes as laid out in a push constant block: offsets come from Offset decorations,
+/// array and matrix sizes from their strides
+class SpirvTypeSizes {
+public:
+    void AddInstruction(uint32_t opcode_, const uint32_t* operands_, uint32_t count_);
+    [[nodiscard]] uint32_t GetPushConstantsSize() const;
+
+private:
+    struct Type {
+        uint32_t opcode = 0;
+        uint32_t size = 0;      // scalars
+        uint32_t element = 0;   // vector/matrix/array element, pointee for pointers
+        uint32_t count = 0;     // vector/matrix column count; array length constant id
+        uint32_t storageClass = 0;
+        std::vector<uint32_t> members;
+    };
+    struct MemberLayout {
+        uint32_t offset = 0;
+        uint32_t matrixStride = 0;
+    };
+
+    uint32_t GetSize(uint32_t typeId_, uint32_t matrixStride_) const;
+
+    std::unordered_map<uint32_t, Type> types;
+    std::unordered_map<uint32_t, uint32_t> constants;
+    std::unordered_map<uint32_t, uint32_t> arrayStrides;
+    std::unordered_map<uint64_t, MemberLayout> memberLayouts; // (struct id << 32) | member
+    std::vector<uint32_t> pushConstantPointers;
+};
+
+// SPIR-V opcodes, decorations and storage classes used below
+enum : uint32_t {
+    OpTypeBool = 20, OpTypeInt = 21, OpTypeFloat = 22, OpTypeVector = 23, OpTypeMatrix = 24,
+    OpTypeArray = 28, OpTypeStruct = 30, OpTypePointer = 32, OpConstant = 43, OpVariable = 59,
+    OpDecorate = 71, OpMemberDecorate = 72,
+    DecorationArrayStride = 6, DecorationMatrixStride = 7, DecorationOffset = 35,
+    StorageClassPushConstant = 9, StorageClassPhysicalStorageBuffer = 5349,
+};
+
+void SpirvTypeSizes::AddInstruction(uint32_t opcode_, const uint32_t* operands_, uint32_t count_) {
+    switch (opcode_) {
+    case OpTypeBool:
+        if (count_ >= 1) types[operands_[0]] = { .opcode = opcode_, .size = 4 };
+        break;
+    case OpTypeInt:
+    case OpTypeFloat:
+        if (count_ >= 2) types[operands_[0]] = { .opcode = opcode_, .size = operands_[1] / 8 };
+        break;
+    case OpTypeVector:
+    case OpTypeMatrix:
+    case OpTypeArray:
+        if (count_ >= 3) types[operands_[0]] = { .opcode = opcode_, .element = operands_[1], .count = operands_[2] };
+        break;
+    case OpTypeStruct:
+        if (count_ >= 1) types[operands_[0]] = { .opcode = opcode_, .members = { operands_ + 1, operands_ + count_ } };
+        break;
+    case OpTypePointer:
+        if (count_ >= 3) types[operands_[0]] = { .opcode = opcode_, .element = operands_[2], .storageClass = operands_[1] };
+        break;
+    case OpConstant:
+        if (count_ >= 3) constants[operands_[1]] = operands_[2];
+        break;
+    case OpVariable:
+        if (count_ >= 3 && operands_[2] == StorageClassPushConstant) pushConstantPointers.push_back(operands_[0]);
+        break;
+    case OpDecorate:
+        if (count_ >= 3 && operands_[1] == DecorationArrayStride) arrayStrides[operands_[0]] = operands_[2];
+        break;
+    case OpMemberDecorate:
+        if (count_ >= 4) {
+            MemberLayout& layout = memberLayouts[(uint64_t(operands_[0]) << 32) | operands_[1]];
+            if (operands_[2] == DecorationOffset) layout.offset = operands_[3];
+            if (operands_[2] == DecorationMatrixStride) layout.matrixStride = operands_[3];
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+uint32_t SpirvTypeSizes::GetSize(uint32_t typeId_, uint32_t matrixStride_) const {
+    const auto it = types.find(typeId_);
+    if (it == types.end()) return 0;
+    const Type& type = it->second;
+    switch (type.opcode) {
+    case OpTypeVector:
+        return GetSize(type.element, 0) * type.count;
+    case OpTypeMatrix:
+        return (matrixStride_ != 0 ? matrixStride_ : GetSize(type.element, 0)) * type.count;
+    case OpTypeArray: {
+        const auto stride = arrayStrides.find(typeId_);
+        const auto length = constants.find(type.count);
+        if (stride == arrayStrides.end() || length == constants.end()) return 0;
+        return stride->second * length->second;
+    }
+    case OpTypeStruct: {
+        uint32_t size = 0;
+        for (uint32_t member = 0; member < type.members.size(); member++) {
+            const auto layout = memberLayouts.find((uint64_t(typeId_) << 32) | member);
+            const MemberLayout memberLayout = layout != memberLayouts.end() ? layout->second : MemberLayout{};
+            size = std::max(size, memberLayout.offset + GetSize(type.members[member], memberLayout.matrixStride));
+        }
+        return size;
+    }
+    case OpTypePointer:
+        // buffer_reference members are 64-bit device addresses
+        return type.storageClass == StorageClassPhysicalStorageBuffer ? 8 : 0;
+    default:
+        return type.size;
+    }
+}
+
+uint32_t SpirvTypeSizes::GetPushConstantsSize() const {
+    uint32_t size = 0;
+    for (const uint32_t pointerId : pushConstantPointers) {
+        const auto pointer = types.find(pointerId);
+        if (pointer != types.end()) size = std::max(size, GetSize(pointer->second.element, 0));
+    }
+    return size;
+}
+
+} // namespace
+
+bool GetShaderStage(const std::filesystem::path& path_, lvk::ShaderStage& outStage_) {
+    const std::string extension = path_.extension().string();
+    if (extension == ".vert") outStage_ = lvk::Stage_Vert;
+    else if (extension == ".frag") outStage_ = lvk::Stage_Frag;
+    else if (extension == ".comp") outStage_ = lvk::Stage_Comp;
+    else return false;
+    return true;
+}
+
+ShaderBinary LoadShaderBinary(lvk::IContext* ctx_, const std::filesystem::path& sourcePath_, lvk::ShaderStage stage_) {
+    ShaderBinary binary;
+    if (LoadPrebuilt(sourcePath_, binary.spirv)) {
+        binary.origin = ShaderOrigin::Prebuilt;
+        binary.reflection = ReflectSpirv(binary.spirv.data(), binary.spirv.size());
+        return binary;
+    }
+
+    const std::vector<uint8_t> source = ReadBinaryFile(sourcePath_);
+    if (source.empty()) {
+        std::cerr << "Failed to read shader: " << sourcePath_.string() << std::endl;
+        return {};
+    }
+
+    const uint64_t sourceHash = HashBytes(source.data(), source.size(), kShaderCacheVersion);
+    const std::filesystem::path cachePath = GetCachePath(sourcePath_, sourceHash);
+    binary.spirv = ReadBinaryFile(cachePath);
+    if (IsSpirv(binary.spirv)) {
+        binary.origin = ShaderOrigin::Cache;
+    } else {
+        VKENGINE_PROFILE_ZONE("Compile shader");
+        // Same glslang and limits lvk uses for GLSL it is handed directly
+        const glslang_resource_t resource =
+            lvk::getGlslangResource(static_cast<lvk::VulkanContext*>(ctx_)->getVkPhysicalDeviceProperties().limits);
+        const std::string code(source.begin(), source.end());
+        binary.spirv.clear();
+        const lvk::Result result = lvk::compileShader(GetGlslangStage(stage_), code.c_str(), &binary.spirv, &resource);
+        if (!result.isOk() || !IsSpirv(binary.spirv)) {
+            std::cerr << "Failed to compile shader: " << sourcePath_.string() << std::endl;
+            return {};
+        }
+        binary.origin = ShaderOrigin::Compiled;
+        WriteCache(cachePath, sourcePath_, binary.spirv);
+    }
+    binary.reflection = ReflectSpirv(binary.spirv.data(), binary.spirv.size());
+    return binary;
+}
+
+ShaderReflection ReflectSpirv(const uint8_t* data_, size_t size_) {
+    const size_t wordCount = size_ / 4;
+    std::vector<uint32_t> words(wordCount);
+    std::memcpy(words.data(), data_, wordCount * 4);
+
+    SpirvTypeSizes sizes;
+    // Skip the 5-word header; each instruction starts with (word count << 16) | opcode
+    for (size_t i = 5; i < wordCount;) {
+        const uint32_t instructionWords = words[i] >> 16;
+        if (instructionWords == 0 || i + instructionWords > wordCount) break;
+        sizes.AddInstruction(words[i] & 0xffff, words.data() + i + 1, instructionWords - 1);
+        i += instructionWords;
+    }
+    return { .pushConstantsSize = sizes.GetPushConstantsSize() };
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <lvk/LVK.h>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/// Build-time SPIR-V directory (see add_shaders in cmake/Shaders.cmake); empty when the build did not compile shaders
+#if defined(VKENGINE_SPIRV_DIR)
+inline constexpr const char* kPrebuiltShaderDirectory = VKENGINE_SPIRV_DIR;
+#else
+inline constexpr const char* kPrebuiltShaderDirectory = "";
+#endif
+
+/// Where a shader's SPIR-V came from, cheapest first
+enum class ShaderOrigin : uint8_t {
+    Prebuilt, // compiled by the build, next to the executable
+    Cache,    // compiled by an earlier run from the same source (cache/shaders)
+    Compiled, // compiled from GLSL just now and written to the cache
+};
+
+/// What the engine needs to know about a shader's interface without compiling it
+struct ShaderReflection {
+    /// Size of the push constant block, 0 if the shader has none
+    uint32_t pushConstantsSize = 0;
+};
+
+struct ShaderBinary {
+    std::vector<uint8_t> spirv;
+    ShaderOrigin origin = ShaderOrigin::Compiled;
+    ShaderReflection reflection;
+
+    [[nodiscard]] bool IsEmpty() const { return spirv.empty(); }
+};
+
+/// Stage from the file extension (.vert, .frag, .comp)
+bool GetShaderStage(const std::filesystem::path& path_, lvk::ShaderStage& outStage_);
+
+/// SPIR-V for the GLSL shader at sourcePath_, without touching the GPU, so it may run on a worker.
+///
+/// Prefers the build's SPIR-V unless the source was edited after the build; otherwise looks up
+/// cache/shaders by a hash of the source, and compiles and caches it on a miss. Returns an empty
+/// binary if the shader cannot be read or does not compile.
+ShaderBinary LoadShaderBinary(lvk::IContext* ctx_, const std::filesystem::path& sourcePath_, lvk::ShaderStage stage_);
+
+/// Reads the push constant block size out of a SPIR-V module
+ShaderReflection ReflectSpirv(const uint8_t* data_, size_t size_);
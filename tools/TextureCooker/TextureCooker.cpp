@@ -0,0 +1,232 @@
+// TextureCooker: converts authored images into BC7 KTX2 files with full mip chains.
+//
+//   TextureCooker [--force] <file or directory>...
+//
+// Each image is written next to its source as <stem>.ktx2, which the engine's texture
+// loader picks up in place of the source. Outputs newer than their inputs are skipped.
+// Mips are filtered in linear space for color data and renormalized for normal maps,
+// encoded to UASTC and transcoded to BC7 so the runtime uploads blocks without any work.
+
+#include <ktx.h>
+#include <vulkan/vulkan_core.h>
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include <stb_image_resize2.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+enum class TextureKind {
+    Color,  // sRGB-encoded albedo and similar
+    Data,   // linear data: roughness, metalness, occlusion, masks
+    Normal, // tangent-space normal map
+};
+
+/// Guesses what an image stores from the naming conventions used under assets/
+TextureKind ClassifyTexture(const fs::path& path_) {
+    std::string stem = path_.stem().string();
+    std::transform(stem.begin(), stem.end(), stem.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    auto endsWith = [&stem](const char* suffix) {
+        const size_t length = std::strlen(suffix);
+        return stem.size() >= length && stem.compare(stem.size() - length, length, suffix) == 0;
+    };
+    auto contains = [&stem](const char* word) { return stem.find(word) != std::string::npos; };
+
+    if (contains("normal") || endsWith("_n") || endsWith("_nrm")) {
+        return TextureKind::Normal;
+    }
+    if (contains("rough") || contains("metal") || contains("occlusion") || contains("height") || contains("mask") ||
+        endsWith("_r") || endsWith("_m") || endsWith("_ao")) {
+        return TextureKind::Data;
+    }
+    return TextureKind::Color;
+}
+
+bool IsSourceImage(const fs::path& path_) {
+    std::string extension = path_.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga";
+}
+
+void RenormalizeNormals(uint8_t* texels_, size_t count_) {
+    for (size_t i = 0; i < count_; ++i) {
+        uint8_t* t = texels_ + i * 4;
+        float x = t[0] / 127.5f - 1.0f;
+        float y = t[1] / 127.5f - 1.0f;
+        float z = t[2] / 127.5f - 1.0f;
+        const float length = std::sqrt(x * x + y * y + z * z);
+        if (length < 1e-5f) continue;
+        x /= length;
+        y /= length;
+        z /= length;
+        t[0] = static_cast<uint8_t>(std::lround((x + 1.0f) * 127.5f));
+        t[1] = static_cast<uint8_t>(std::lround((y + 1.0f) * 127.5f));
+        t[2] = static_cast<uint8_t>(std::lround((z + 1.0f) * 127.5f));
+    }
+}
+
+bool CookTexture(const fs::path& source_, const fs::path& output_) {
+    int width, height, channels;
+    unsigned char* pixels = stbi_load(source_.string().c_str(), &width, &height, &channels, 4);
+    if (!pixels) {
+        std::cerr << "Failed to load image: " << source_ << std::endl;
+        return false;
+    }
+
+    const TextureKind kind = ClassifyTexture(source_);
+    const uint32_t numLevels = 1 + static_cast<uint32_t>(std::floor(std::log2(std::max(width, height))));
+
+    ktxTextureCreateInfo createInfo = {
+        .glInternalformat = 0,
+        .vkFormat = kind == TextureKind::Color ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM,
+        .pDfd = nullptr,
+        .baseWidth = static_cast<uint32_t>(width),
+        .baseHeight = static_cast<uint32_t>(height),
+        .baseDepth = 1,
+        .numDimensions = 2,
+        .numLevels = numLevels,
+        .numLayers = 1,
+        .numFaces = 1,
+        .isArray = KTX_FALSE,
+        .generateMipmaps = KTX_FALSE,
+    };
+
+    ktxTexture2* texture = nullptr;
+    KTX_error_code result = ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &texture);
+    if (result != KTX_SUCCESS) {
+        std::cerr << "Failed to create KTX2 texture: " << ktxErrorString(result) << std::endl;
+        stbi_image_free(pixels);
+        return false;
+    }
+
+    // Each level is filtered from level 0 to avoid accumulating blur down the chain
+    std::vector<uint8_t> level;
+    for (uint32_t i = 0; i < numLevels; ++i) {
+        const int w = std::max(1, width >> i);
+        const int h = std::max(1, height >> i);
+        level.resize(size_t(w) * h * 4);
+        if (i == 0) {
+            std::memcpy(level.data(), pixels, level.size());
+        } else if (kind == TextureKind::Color) {
+            stbir_resize_uint8_srgb(pixels, width, height, 0, level.data(), w, h, 0, STBIR_RGBA);
+        } else {
+            stbir_resize_uint8_linear(pixels, width, height, 0, level.data(), w, h, 0, STBIR_RGBA);
+            if (kind == TextureKind::Normal) {
+                RenormalizeNormals(level.data(), size_t(w) * h);
+            }
+        }
+        ktxTexture_SetImageFromMemory(ktxTexture(texture), i, 0, 0, level.data(), level.size());
+    }
+    stbi_image_free(pixels);
+
+    ktxBasisParams params = {};
+    params.structSize = sizeof(params);
+    params.uastc = KTX_TRUE;
+    params.uastcFlags = KTX_PACK_UASTC_LEVEL_DEFAULT;
+    params.normalMap = kind == TextureKind::Normal ? KTX_TRUE : KTX_FALSE;
+    params.threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    result = ktxTexture2_CompressBasisEx(texture, &params);
+    if (result == KTX_SUCCESS) {
+        result = ktxTexture2_TranscodeBasis(texture, KTX_TTF_BC7_RGBA, KTX_TF_HIGH_QUALITY);
+    }
+    if (result == KTX_SUCCESS) {
+        // Write to a temporary name first so the engine never sees a half-written file
+        const fs::path tmpPath = fs::path(output_).concat(".tmp");
+        result = ktxTexture_WriteToNamedFile(ktxTexture(texture), tmpPath.string().c_str());
+        if (result == KTX_SUCCESS) {
+            std::error_code ec;
+            fs::rename(tmpPath, output_, ec);
+            if (ec) {
+                std::cerr << "Failed to write " << output_ << ": " << ec.message() << std::endl;
+                fs::remove(tmpPath, ec);
+                ktxTexture_Destroy(ktxTexture(texture));
+                return false;
+            }
+        }
+    }
+    ktxTexture_Destroy(ktxTexture(texture));
+
+    if (result != KTX_SUCCESS) {
+        std::cerr << "Failed to cook " << source_ << ": " << ktxErrorString(result) << std::endl;
+        return false;
+    }
+
+    static const char* kKindNames[] = {"color", "data", "normal"};
+    std::cout << "Cooked " << source_.generic_string() << " -> " << output_.filename().string() << " (" << width << "x" << height << ", "
+              << numLevels << " mips, " << kKindNames[static_cast<int>(kind)] << ")" << std::endl;
+    return true;
+}
+
+bool IsUpToDate(const fs::path& source_, const fs::path& output_) {
+    std::error_code ec;
+    const auto outputTime = fs::last_write_time(output_, ec);
+    if (ec) return false;
+    const auto sourceTime = fs::last_write_time(source_, ec);
+    return !ec && outputTime >= sourceTime;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool force = false;
+    std::vector<fs::path> sources;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--force") {
+            force = true;
+            continue;
+        }
+        const fs::path path(arg);
+        std::error_code ec;
+        if (fs::is_directory(path, ec)) {
+            for (const fs::directory_entry& entry : fs::recursive_directory_iterator(path, ec)) {
+                if (entry.is_regular_file() && IsSourceImage(entry.path())) {
+                    sources.push_back(entry.path());
+                }
+            }
+        } else if (fs::is_regular_file(path, ec)) {
+            sources.push_back(path);
+        } else {
+            std::cerr << "No such file or directory: " << arg << std::endl;
+        }
+    }
+
+    if (sources.empty()) {
+        std::cout << "Usage: TextureCooker [--force] <file or directory>..." << std::endl;
+        return 1;
+    }
+
+    std::sort(sources.begin(), sources.end());
+
+    uint32_t cooked = 0, skipped = 0, failed = 0;
+    for (const fs::path& source : sources) {
+        const fs::path output = fs::path(source).replace_extension(".ktx2");
+        if (!force && IsUpToDate(source, output)) {
+            skipped++;
+            continue;
+        }
+        if (CookTexture(source, output)) {
+            cooked++;
+        } else {
+            failed++;
+        }
+    }
+
+    std::cout << "TextureCooker: " << cooked << " cooked, " << skipped << " up to date, " << failed << " failed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}